@@ -6,9 +6,6 @@ LICENSE file in the root directory of this source tree.
 #include "BaseStream.hh"
 #include "StreamBaseline.hh"
 namespace AstraSim {
-std::map<int, int> BaseStream::synchronizer;
-std::map<int, int> BaseStream::ready_counter;
-std::map<int, std::list<BaseStream*>> BaseStream::suspended_streams;
 void BaseStream::changeState(StreamState state) {
   this->state = state;
 }
@@ -20,13 +17,8 @@ BaseStream::BaseStream(
   this->owner = owner;
   this->initialized = false;
   this->phases_to_go = phases_to_go;
-  if (synchronizer.find(stream_num) != synchronizer.end()) {
-    synchronizer[stream_num]++;
-  } else {
-    // std::cout<<"synchronizer set!"<<std::endl;
-    synchronizer[stream_num] = 1;
-    ready_counter[stream_num] = 0;
-  }
+  owner->context->stream_barriers.get(stream_num).ready_tokens +=
+      owner->context->npus_per_generator;
   for (auto& vn : phases_to_go) {
     if (vn.algorithm != nullptr) {
       vn.init(this);
@@ -40,38 +32,42 @@ BaseStream::BaseStream(
   priority = 0;
 }
 void BaseStream::declare_ready() {
-  ready_counter[stream_num]++;
-  if (ready_counter[stream_num] == owner->total_nodes) {
-    synchronizer[stream_num] = owner->total_nodes;
-    ready_counter[stream_num] = 0;
+  auto& barrier = owner->context->stream_barriers.get(stream_num);
+  auto npus_count = owner->context->npus_per_generator;
+  barrier.arrivals += npus_count;
+  if (barrier.arrivals == owner->total_nodes) {
+    // every NPU arrived: open the barrier for all of them
+    barrier.ready_tokens = owner->total_nodes;
+    barrier.arrivals = 0;
   }
 }
 bool BaseStream::is_ready() {
-  return synchronizer[stream_num] > 0;
+  return owner->context->stream_barriers.get(stream_num).ready_tokens > 0;
 }
 void BaseStream::consume_ready() {
   // std::cout<<"consume ready called!"<<std::endl;
-  assert(synchronizer[stream_num] > 0);
-  synchronizer[stream_num]--;
+  auto& barrier = owner->context->stream_barriers.get(stream_num);
+  assert(barrier.ready_tokens > 0);
+  barrier.ready_tokens -= owner->context->npus_per_generator;
   resume_ready(stream_num);
 }
 void BaseStream::suspend_ready() {
-  if (suspended_streams.find(stream_num) == suspended_streams.end()) {
-    std::list<BaseStream*> empty;
-    suspended_streams[stream_num] = empty;
-  }
-  suspended_streams[stream_num].push_back(this);
+  owner->context->stream_barriers.get(stream_num).suspended_streams.push_back(
+      this);
   return;
 }
 void BaseStream::resume_ready(int st_num) {
-  if (suspended_streams[st_num].size() != (owner->all_generators.size() - 1)) {
+  auto& all_generators = owner->context->all_generators;
+  auto& suspended_streams =
+      owner->context->stream_barriers.get(st_num).suspended_streams;
+  int counter = owner->context->generators_count - 1;
+  if ((int)suspended_streams.size() != counter) {
     return;
   }
-  int counter = owner->all_generators.size() - 1;
   for (int i = 0; i < counter; i++) {
-    StreamBaseline* stream = (StreamBaseline*)suspended_streams[st_num].front();
-    suspended_streams[st_num].pop_front();
-    owner->all_generators[stream->owner->id]->proceed_to_next_vnet_baseline(
+    StreamBaseline* stream = (StreamBaseline*)suspended_streams.front();
+    suspended_streams.pop_front();
+    all_generators[stream->owner->id]->proceed_to_next_vnet_baseline(
         stream);
   }
   if (phases_to_go.size() == 0) {
@@ -80,10 +76,6 @@ void BaseStream::resume_ready(int st_num) {
   return;
 }
 void BaseStream::destruct_ready() {
-  std::map<int, int>::iterator it;
-  it = synchronizer.find(stream_num);
-  synchronizer.erase(it);
-  ready_counter.erase(stream_num);
-  suspended_streams.erase(stream_num);
+  owner->context->stream_barriers.reset(stream_num);
 }
 } // namespace AstraSim
\ No newline at end of file
@@ -22,6 +22,7 @@ LICENSE file in the root directory of this source tree.
 #include "CollectivePhase.hh"
 #include "Common.hh"
 #include "DataSet.hh"
+#include "StreamQueue.hh"
 #include "StreamStat.hh"
 #include "Sys.hh"
 #include "astra-sim/system/topology/LogicalTopology.hh"
@@ -30,9 +31,6 @@ namespace AstraSim {
 class RecvPacketEventHadndlerData;
 class BaseStream : public Callable, public StreamStat {
  public:
-  static std::map<int, int> synchronizer;
-  static std::map<int, int> ready_counter;
-  static std::map<int, std::list<BaseStream*>> suspended_streams;
   virtual ~BaseStream() = default;
   int stream_num;
   int total_packets_sent;
@@ -50,6 +48,8 @@ class BaseStream : public Callable, public StreamStat {
   int priority;
   StreamState state;
   bool initialized;
+  // position in the Sys::active_Streams queue of its current phase
+  StreamQueue::iterator queue_position;
 
   Tick last_phase_change;
 
@@ -0,0 +1,33 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "CollectivePlan.hh"
+#include <tuple>
+
+namespace AstraSim {
+bool CollectivePlan::Key::operator<(const Key& other) const {
+  return std::tie(
+             collective_type,
+             chunk_size,
+             dim_mapper,
+             dimensions_involved,
+             link_failure_per_dimension,
+             failure_dim,
+             traffic_matrix_layer,
+             npu_id) <
+      std::tie(
+             other.collective_type,
+             other.chunk_size,
+             other.dim_mapper,
+             other.dimensions_involved,
+             other.link_failure_per_dimension,
+             other.failure_dim,
+             other.traffic_matrix_layer,
+             other.npu_id);
+}
+
+CollectivePlan::Phase::Phase(ComType comm_type, int dimension, int chunk_stage)
+    : comm_type(comm_type), dimension(dimension), chunk_stage(chunk_stage) {}
+} // namespace AstraSim
@@ -0,0 +1,77 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __COLLECTIVEPLAN_HH__
+#define __COLLECTIVEPLAN_HH__
+
+#include <cstdint>
+#include <vector>
+#include "Common.hh"
+
+namespace AstraSim {
+/**
+ * Phases of one chunk of a collective, derived once per Key and shared by
+ * all the NPUs, chunks and layers issuing that collective
+ * (see Sys::generate_collective).
+ *
+ * Every chunk still gets fresh algorithms, as they hold the state of their
+ * stream, and picks the queue of each phase when it is instantiated, so the
+ * queue rotation of QueueLevels is unchanged. All NPUs of a simulation
+ * share one system configuration, which is therefore not part of the key.
+ */
+class CollectivePlan {
+ public:
+  struct Key {
+    ComType collective_type;
+    uint64_t chunk_size;
+    std::vector<int> dim_mapper;
+    std::vector<bool> dimensions_involved;
+    std::vector<int> link_failure_per_dimension;
+    int failure_dim;
+    int traffic_matrix_layer;
+    /**
+     * NPU issuing the collective when its data sizes depend on it
+     * (non-uniform All-to-All), else -1
+     */
+    int npu_id;
+
+    bool operator<(const Key& other) const;
+  };
+
+  struct Phase {
+    ComType comm_type;
+    int dimension;
+    /**
+     * MATE stage of the phase, -1 outside MATE
+     */
+    int chunk_stage;
+
+    /**
+     * Messages of a HalfRing phase for each link failure the queues of its
+     * dimension can have, sized when the plan is built (empty for the other
+     * implementations)
+     */
+    struct HalfRingMessages {
+      int link_failure;
+      int stream_count;
+      uint64_t msg_size;
+      // All-to-Allv scale of each message of each NPU, else nullptr
+      const std::vector<std::vector<double>>* message_scales;
+    };
+    std::vector<HalfRingMessages> half_ring_messages;
+
+    Phase(ComType comm_type, int dimension, int chunk_stage);
+  };
+
+  std::vector<Phase> phases;
+
+  /**
+   * Sys::chunk_stage once the MATE stages are derived, -1 outside MATE
+   */
+  int final_chunk_stage = -1;
+};
+} // namespace AstraSim
+
+#endif
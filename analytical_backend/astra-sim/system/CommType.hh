@@ -8,7 +8,8 @@ enum class ComType {
   All_Gather,
   All_Reduce,
   All_to_All,
-  All_Reduce_All_to_All
+  All_Reduce_All_to_All,
+  All_to_Allv
 };
 }
 
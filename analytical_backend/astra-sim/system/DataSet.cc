@@ -7,9 +7,8 @@ LICENSE file in the root directory of this source tree.
 #include "IntData.hh"
 #include "Sys.hh"
 namespace AstraSim {
-int DataSet::id_auto_increment = 0;
 DataSet::DataSet(int total_streams) {
-  this->my_id = id_auto_increment++;
+  this->my_id = SimulationContext::current()->dataset_id_auto_increment++;
   this->total_streams = total_streams;
   this->finished_streams = 0;
   this->finished = false;
@@ -26,7 +26,6 @@ LICENSE file in the root directory of this source tree.
 namespace AstraSim {
 class DataSet : public Callable, public StreamStat {
  public:
-  static int id_auto_increment;
   int my_id;
   int total_streams;
   int finished_streams;
@@ -0,0 +1,67 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __INPUTFILES_HH__
+#define __INPUTFILES_HH__
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace AstraSim {
+class SystemConfig;
+class TrafficDistribution;
+class TrafficMatrix;
+class WorkloadSpec;
+
+/**
+ * Read-only objects parsed from input files, by key (file path and the
+ * parameters the parsing depends on). Safe to share between threads.
+ */
+template <typename Key, typename T>
+class ParsedFileCache {
+ public:
+  /**
+   * Get the object of key, parsing it on first use.
+   * @param key file path and parsing parameters
+   * @param parse returns the parsed object (nullptr is not cached)
+   * @return shared object
+   */
+  template <typename Parse>
+  std::shared_ptr<const T> get(const Key& key, Parse parse) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& parsed = entries[key];
+    if (parsed == nullptr) {
+      parsed = parse();
+    }
+    return parsed;
+  }
+
+ private:
+  std::mutex mutex;
+  std::map<Key, std::shared_ptr<const T>> entries;
+};
+
+/**
+ * Input files of a simulation, each parsed once and shared by every NPU.
+ * A sweep hands the same InputFiles to all of its runs (see
+ * SimulationContext::input_files), and they are released with it.
+ */
+struct InputFiles {
+  ParsedFileCache<std::string, SystemConfig> system_configs;
+  // path, compute scale, communication scale
+  ParsedFileCache<std::tuple<std::string, double, double>, WorkloadSpec>
+      workload_specs;
+  // path, experts count
+  ParsedFileCache<std::pair<std::string, int>, TrafficDistribution>
+      traffic_distributions;
+  ParsedFileCache<std::string, TrafficMatrix> traffic_matrices;
+};
+} // namespace AstraSim
+
+#endif
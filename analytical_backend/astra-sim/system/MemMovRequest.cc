@@ -7,7 +7,6 @@ LICENSE file in the root directory of this source tree.
 #include "LogGP.hh"
 #include "Sys.hh"
 namespace AstraSim {
-int MemMovRequest::id = 0;
 MemMovRequest::MemMovRequest(
     int request_num,
     Sys* generator,
@@ -23,7 +22,7 @@ MemMovRequest::MemMovRequest(
   this->callable = callable;
   this->processed = processed;
   this->send_back = send_back;
-  this->my_id = id++;
+  this->my_id = SimulationContext::current()->mem_mov_request_id++;
   this->generator = generator;
   this->loggp = loggp;
   this->total_transfer_queue_time = 0;
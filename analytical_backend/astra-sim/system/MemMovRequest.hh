@@ -27,7 +27,6 @@ class Sys;
 class LogGP;
 class MemMovRequest : public Callable, public SharedBusStat {
  public:
-  static int id;
   int my_id;
   int size;
   int latency;
@@ -0,0 +1,117 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "ObjectPool.hh"
+#include <algorithm>
+#include <sstream>
+
+namespace AstraSim {
+ObjectPool::ObjectPool(size_t block_size)
+    : free_blocks(nullptr),
+      allocations_count(0),
+      in_use(0),
+      peak_in_use(0) {
+  // keep every block of a chunk aligned for any object
+  size_t alignment = alignof(std::max_align_t);
+  block_size = std::max(block_size, sizeof(FreeBlock));
+  this->block_size = (block_size + alignment - 1) / alignment * alignment;
+}
+
+void* ObjectPool::allocate() {
+  if (free_blocks == nullptr) {
+    chunks.emplace_back(new char[block_size * chunk_blocks]);
+    char* chunk = chunks.back().get();
+    for (int i = chunk_blocks - 1; i >= 0; i--) {
+      FreeBlock* block = (FreeBlock*)(chunk + i * block_size);
+      block->next = free_blocks;
+      free_blocks = block;
+    }
+  }
+  FreeBlock* block = free_blocks;
+  free_blocks = block->next;
+  allocations_count++;
+  if (++in_use > peak_in_use) {
+    peak_in_use = in_use;
+  }
+  return block;
+}
+
+void ObjectPool::deallocate(void* block) {
+  FreeBlock* free_block = (FreeBlock*)block;
+  free_block->next = free_blocks;
+  free_blocks = free_block;
+  in_use--;
+}
+
+size_t ObjectPool::get_block_size() const {
+  return block_size;
+}
+
+uint64_t ObjectPool::get_allocations_count() const {
+  return allocations_count;
+}
+
+uint64_t ObjectPool::get_peak_in_use() const {
+  return peak_in_use;
+}
+
+void* ObjectPools::allocate(Type type, size_t block_size, size_t size) {
+  if (size != block_size) {
+    return ::operator new(size);
+  }
+  std::unique_ptr<ObjectPool>& pool = pools[(int)type];
+  if (pool == nullptr) {
+    pool.reset(new ObjectPool(block_size));
+  }
+  return pool->allocate();
+}
+
+void ObjectPools::deallocate(
+    Type type,
+    size_t block_size,
+    void* block,
+    size_t size) {
+  if (size != block_size) {
+    ::operator delete(block);
+    return;
+  }
+  pools[(int)type]->deallocate(block);
+}
+
+std::string ObjectPools::get_summary() const {
+  std::stringstream summary;
+  for (int type = 0; type < (int)Type::TypesCount; type++) {
+    const std::unique_ptr<ObjectPool>& pool = pools[type];
+    if (pool == nullptr) {
+      continue;
+    }
+    summary << get_type_name((Type)type) << ": "
+            << pool->get_allocations_count() << " allocations, peak "
+            << pool->get_peak_in_use() << " in use" << std::endl;
+  }
+  return summary.str();
+}
+
+uint64_t ObjectPools::get_allocations_count(Type type) const {
+  const std::unique_ptr<ObjectPool>& pool = pools[(int)type];
+  return pool == nullptr ? 0 : pool->get_allocations_count();
+}
+
+uint64_t ObjectPools::get_peak_in_use(Type type) const {
+  const std::unique_ptr<ObjectPool>& pool = pools[(int)type];
+  return pool == nullptr ? 0 : pool->get_peak_in_use();
+}
+
+const char* ObjectPools::get_type_name(Type type) {
+  switch (type) {
+    case Type::RecvPacketEventHadndlerData:
+      return "RecvPacketEventHadndlerData";
+    case Type::PacketBundle:
+      return "PacketBundle";
+    default:
+      return "unknown";
+  }
+}
+} // namespace AstraSim
@@ -0,0 +1,107 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __OBJECTPOOL_HH__
+#define __OBJECTPOOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AstraSim {
+/**
+ * Free list of fixed-size blocks, carved from chunks that are only
+ * released with the pool.
+ */
+class ObjectPool {
+ public:
+  /**
+   * @param block_size size of the objects of the pool
+   */
+  explicit ObjectPool(size_t block_size);
+
+  void* allocate();
+  void deallocate(void* block);
+
+  size_t get_block_size() const;
+
+  /**
+   * @return blocks handed out so far
+   */
+  uint64_t get_allocations_count() const;
+
+  /**
+   * @return most blocks in use at once (blocks taken from the heap)
+   */
+  uint64_t get_peak_in_use() const;
+
+ private:
+  static const int chunk_blocks = 64;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  size_t block_size;
+  FreeBlock* free_blocks;
+  std::vector<std::unique_ptr<char[]>> chunks;
+
+  uint64_t allocations_count;
+  uint64_t in_use;
+  uint64_t peak_in_use;
+};
+
+/**
+ * Pools of the short-lived objects of one simulation, allocated per packet
+ * (event handler data, packet bundles). See PooledObject.
+ *
+ * Collective algorithms are not pooled: all the phases of a collective are
+ * built when it is issued, so their blocks would only be reused by the next
+ * pass.
+ */
+class ObjectPools {
+ public:
+  enum class Type {
+    RecvPacketEventHadndlerData,
+    PacketBundle,
+    TypesCount
+  };
+
+  /**
+   * Allocate an object of a pooled type.
+   * @param type pooled type
+   * @param block_size size of the pooled type
+   * @param size size requested (another size, e.g., of a derived class that
+   * is not pooled itself, is allocated on the heap)
+   */
+  void* allocate(Type type, size_t block_size, size_t size);
+  void deallocate(Type type, size_t block_size, void* block, size_t size);
+
+  /**
+   * One line per pool that was used: allocations and peak blocks in use.
+   */
+  std::string get_summary() const;
+
+  /**
+   * @return blocks of a pooled type handed out so far (0 if never used)
+   */
+  uint64_t get_allocations_count(Type type) const;
+
+  /**
+   * @return most blocks of a pooled type in use at once (0 if never used)
+   */
+  uint64_t get_peak_in_use(Type type) const;
+
+  static const char* get_type_name(Type type);
+
+ private:
+
+  std::unique_ptr<ObjectPool> pools[(int)Type::TypesCount];
+};
+} // namespace AstraSim
+
+#endif
@@ -23,10 +23,13 @@ LICENSE file in the root directory of this source tree.
 #include "Common.hh"
 #include "MemBus.hh"
 #include "MyPacket.hh"
+#include "PooledObject.hh"
 
 namespace AstraSim {
 class Sys;
-class PacketBundle : public Callable {
+class PacketBundle
+    : public Callable,
+      public PooledObject<PacketBundle, ObjectPools::Type::PacketBundle> {
  public:
   std::list<MyPacket*> locked_packets;
   bool needs_processing;
@@ -0,0 +1,36 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __POOLEDOBJECT_HH__
+#define __POOLEDOBJECT_HH__
+
+#include <cstddef>
+#include "ObjectPool.hh"
+#include "SimulationContext.hh"
+
+namespace AstraSim {
+/**
+ * Base of the classes whose new/delete use the pools of the simulation
+ * bound to the running thread (SimulationContext::object_pools). Objects
+ * must be deleted while that simulation is running.
+ *
+ * Derived classes of T that are not pooled themselves go to the heap.
+ */
+template <typename T, ObjectPools::Type type>
+class PooledObject {
+ public:
+  static void* operator new(size_t size) {
+    return SimulationContext::current()->object_pools.allocate(
+        type, sizeof(T), size);
+  }
+
+  static void operator delete(void* block, size_t size) {
+    SimulationContext::current()->object_pools.deallocate(
+        type, sizeof(T), block, size);
+  }
+};
+} // namespace AstraSim
+
+#endif
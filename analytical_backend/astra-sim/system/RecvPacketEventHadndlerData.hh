@@ -20,10 +20,15 @@ LICENSE file in the root directory of this source tree.
 #include <vector>
 #include "BaseStream.hh"
 #include "BasicEventHandlerData.hh"
+#include "PooledObject.hh"
 
 namespace AstraSim {
-class RecvPacketEventHadndlerData : public BasicEventHandlerData,
-                                    public MetaData {
+class RecvPacketEventHadndlerData
+    : public BasicEventHandlerData,
+      public MetaData,
+      public PooledObject<
+          RecvPacketEventHadndlerData,
+          ObjectPools::Type::RecvPacketEventHadndlerData> {
  public:
   BaseStream* owner;
   int vnet;
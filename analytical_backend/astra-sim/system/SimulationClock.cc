@@ -0,0 +1,29 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SimulationClock.hh"
+
+namespace AstraSim {
+void SimulationClock::set_time(const timespec_t& time) noexcept {
+  driven = true;
+  tick = time.time_val / CLOCK_PERIOD;
+}
+
+bool SimulationClock::is_driven() const noexcept {
+  return driven;
+}
+
+Tick SimulationClock::get_tick() const noexcept {
+  return tick;
+}
+
+void SimulationClock::set_checked(bool checked) noexcept {
+  this->checked = checked;
+}
+
+bool SimulationClock::is_checked() const noexcept {
+  return checked;
+}
+} // namespace AstraSim
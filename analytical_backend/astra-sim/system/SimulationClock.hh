@@ -0,0 +1,52 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SIMULATIONCLOCK_HH__
+#define __SIMULATIONCLOCK_HH__
+
+#include "AstraNetworkAPI.hh"
+#include "Common.hh"
+
+namespace AstraSim {
+/**
+ * Current time of one simulation, as seen by the system layer.
+ *
+ * A network backend that drives the clock sets it once per batch of
+ * same-time events, before running them, and Sys::boostedTick() reads it
+ * directly. With a backend that does not drive it, Sys::boostedTick() asks
+ * the network API of a live NPU instead.
+ *
+ * Checked clocks are compared against the backend time on every read
+ * (debugging aid, see Sys::boostedTick()).
+ */
+class SimulationClock {
+ public:
+  /**
+   * Move the clock to the time of the events about to run (backend only).
+   * @param time backend time
+   */
+  void set_time(const timespec_t& time) noexcept;
+
+  /**
+   * @return whether a backend sets the clock
+   */
+  bool is_driven() const noexcept;
+
+  /**
+   * @return current tick (without SimulationContext::offset)
+   */
+  Tick get_tick() const noexcept;
+
+  void set_checked(bool checked) noexcept;
+  bool is_checked() const noexcept;
+
+ private:
+  bool driven = false;
+  bool checked = false;
+  Tick tick = 0;
+};
+} // namespace AstraSim
+
+#endif
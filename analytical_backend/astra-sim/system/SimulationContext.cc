@@ -0,0 +1,29 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SimulationContext.hh"
+#include <cassert>
+
+namespace AstraSim {
+namespace {
+thread_local SimulationContext* current_context = nullptr;
+} // namespace
+
+SimulationContext* SimulationContext::current() noexcept {
+  assert(
+      current_context != nullptr &&
+      "<SimulationContext::current> No simulation context bound to this thread.");
+  return current_context;
+}
+
+SimulationContext::Binding::Binding(SimulationContext* context) noexcept
+    : previous_context(current_context) {
+  current_context = context;
+}
+
+SimulationContext::Binding::~Binding() noexcept {
+  current_context = previous_context;
+}
+} // namespace AstraSim
@@ -0,0 +1,125 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SIMULATIONCONTEXT_HH__
+#define __SIMULATIONCONTEXT_HH__
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+#include "CollectivePlan.hh"
+#include "Common.hh"
+#include "InputFiles.hh"
+#include "ObjectPool.hh"
+#include "SimulationClock.hh"
+#include "StreamBarrierTable.hh"
+
+namespace AstraSim {
+class Sys;
+class BaseStream;
+
+/**
+ * System-layer state shared by all NPUs of one simulation.
+ *
+ * Every Sys points to the context it belongs to (Sys::context), and streams
+ * and schedulers reach it through their Sys. Code without a Sys at hand
+ * (e.g., Sys::boostedTick()) uses the context bound to the running thread,
+ * so independent simulations can run concurrently, one per thread.
+ */
+class SimulationContext {
+ public:
+  /**
+   * All NPUs of the simulation, indexed by id (nullptr once deleted).
+   */
+  std::vector<Sys*> all_generators;
+  Tick offset = 0;
+
+  /**
+   * Current time, when the network backend drives it (see Sys::boostedTick)
+   */
+  SimulationClock clock;
+
+  /**
+   * Number of Sys instantiated, and number of NPUs each of them stands for.
+   * Under symmetry reduction only orbit representatives are instantiated,
+   * and each one counts as npus_per_generator NPUs in the stream
+   * synchronization (otherwise 1).
+   */
+  int generators_count = 0;
+  int npus_per_generator = 1;
+
+  /**
+   * Per-stream synchronization of all NPUs (see BaseStream).
+   */
+  StreamBarrierTable stream_barriers;
+
+  /**
+   * Chunk schedules computed by NPU 0 and consumed by every NPU
+   * (see OfflineGreedy).
+   */
+  std::map<long long, std::vector<int>> chunk_schedule;
+  std::map<long long, int> schedule_consumer;
+  std::map<long long, uint64_t> global_chunk_size;
+
+  /**
+   * Phases of the collectives issued so far (see CollectivePlan)
+   */
+  std::map<CollectivePlan::Key, const CollectivePlan> collective_plans;
+
+  /**
+   * Tick at which the workload of each simulated NPU finished, by NPU id.
+   */
+  std::map<int, Tick> workload_finished_ticks;
+
+  /**
+   * Parsed input files (system, workload, traffic), shared with the other
+   * runs of a sweep
+   */
+  std::shared_ptr<InputFiles> input_files = std::make_shared<InputFiles>();
+
+  /**
+   * Pools of the objects allocated per packet (see PooledObject)
+   */
+  ObjectPools object_pools;
+
+  /**
+   * Whether the report CSVs of NPU 0 go to per-run fragment files, indexed
+   * by stat row (see CSVWriter::write_to_fragment)
+   */
+  bool csv_fragments = false;
+
+  /**
+   * id counters of DataSet and MemMovRequest
+   */
+  int dataset_id_auto_increment = 0;
+  int mem_mov_request_id = 0;
+
+  /**
+   * Context bound to the calling thread.
+   *      Assertion: a context is bound (see Binding).
+   * @return current context
+   */
+  static SimulationContext* current() noexcept;
+
+  /**
+   * Binds a context to the calling thread for the lifetime of the object,
+   * restoring the previously bound one on destruction.
+   */
+  class Binding {
+   public:
+    explicit Binding(SimulationContext* context) noexcept;
+    ~Binding() noexcept;
+
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+
+   private:
+    SimulationContext* previous_context;
+  };
+};
+} // namespace AstraSim
+
+#endif
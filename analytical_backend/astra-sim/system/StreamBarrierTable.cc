@@ -0,0 +1,33 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "StreamBarrierTable.hh"
+
+namespace AstraSim {
+StreamBarrierTable::Barrier& StreamBarrierTable::get(int stream_num) {
+  if (stream_num < first_stream_num) {
+    finished_barrier = Barrier();
+    return finished_barrier;
+  }
+  while ((int)barriers.size() <= stream_num - first_stream_num) {
+    barriers.emplace_back();
+  }
+  return barriers[stream_num - first_stream_num];
+}
+
+void StreamBarrierTable::reset(int stream_num) {
+  if (stream_num < first_stream_num ||
+      stream_num - first_stream_num >= (int)barriers.size()) {
+    return;
+  }
+  Barrier& barrier = barriers[stream_num - first_stream_num];
+  barrier = Barrier();
+  barrier.finished = true;
+  while (!barriers.empty() && barriers.front().finished) {
+    barriers.pop_front();
+    first_stream_num++;
+  }
+}
+} // namespace AstraSim
@@ -0,0 +1,66 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __STREAMBARRIERTABLE_HH__
+#define __STREAMBARRIERTABLE_HH__
+
+#include <deque>
+#include <list>
+
+namespace AstraSim {
+class BaseStream;
+
+/**
+ * Phase-change barriers of the streams of all NPUs (see BaseStream).
+ *
+ * Every Sys numbers its streams from 0 in the same order, so the barrier of
+ * a stream is found by indexing with its stream_num, offset by the streams
+ * whose slots were recycled. A stream that has no barrier yet, or that
+ * finished, reads as all zero.
+ *
+ * All the NPUs of a simulation run on one thread, so the counters are
+ * plain integers.
+ */
+class StreamBarrierTable {
+ public:
+  struct Barrier {
+    /**
+     * NPUs still allowed to move the stream to its next phase
+     */
+    int ready_tokens = 0;
+
+    /**
+     * NPUs that declared the stream ready since the barrier last opened
+     */
+    int arrivals = 0;
+
+    /**
+     * streams of the other NPUs waiting for the barrier
+     */
+    std::list<BaseStream*> suspended_streams;
+
+    bool finished = false;
+  };
+
+  /**
+   * Barrier of a stream; references stay valid as the table grows.
+   * @param stream_num stream number (non-negative)
+   */
+  Barrier& get(int stream_num);
+
+  /**
+   * Reset the barrier of a stream that finished on every NPU. Its slot is
+   * recycled once all the streams numbered before it finished too.
+   */
+  void reset(int stream_num);
+
+ private:
+  std::deque<Barrier> barriers;
+  int first_stream_num = 0; // stream of barriers.front()
+  Barrier finished_barrier; // read by streams whose slot was recycled
+};
+} // namespace AstraSim
+
+#endif
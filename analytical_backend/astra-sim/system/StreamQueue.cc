@@ -0,0 +1,143 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "StreamQueue.hh"
+#include <algorithm>
+#include "BaseStream.hh"
+
+namespace AstraSim {
+bool StreamQueue::empty() const {
+  return entries.empty();
+}
+
+size_t StreamQueue::size() const {
+  return entries.size();
+}
+
+StreamQueue::iterator StreamQueue::begin() {
+  return entries.begin();
+}
+
+StreamQueue::iterator StreamQueue::end() {
+  return entries.end();
+}
+
+BaseStream* StreamQueue::front() const {
+  return entries.front().stream;
+}
+
+StreamQueue::iterator StreamQueue::insert(BaseStream* stream, Order order) {
+  int64_t key = get_key(stream, order);
+  if (indexed && !index.empty() && index_order != order) {
+    drop_index();
+  }
+  if (!indexed) {
+    return add_pending(find_by_scan(key, order), stream);
+  }
+
+  // the pending streams are sorted in list order: the first one that
+  // stream goes before is a bound of the index
+  Index::iterator bound = order == Order::Priority ? index.upper_bound(key)
+                                                   : index.lower_bound(key);
+  if (bound != index.end() && bound->second->stream->initialized) {
+    // initialized without init_stream(): the scan skips it
+    drop_index();
+    return add_pending(find_by_scan(key, order), stream);
+  }
+  index_order = order;
+  iterator position = add_pending(
+      bound == index.end() ? entries.end() : bound->second, stream);
+  position->index_position = index.emplace_hint(bound, key, position);
+  return position;
+}
+
+StreamQueue::iterator StreamQueue::push_back(BaseStream* stream, Order order) {
+  int64_t key = get_key(stream, order);
+  if (indexed &&
+      (index.empty() ||
+       (index_order == order && key >= index.rbegin()->first))) {
+    index_order = order;
+    iterator position = add_pending(entries.end(), stream);
+    position->index_position = index.emplace_hint(index.end(), key, position);
+    return position;
+  }
+  return insert(entries.end(), stream);
+}
+
+StreamQueue::iterator StreamQueue::insert(
+    iterator position,
+    BaseStream* stream) {
+  drop_index();
+  return add_pending(position, stream);
+}
+
+void StreamQueue::erase(iterator position) {
+  release(*position);
+  entries.erase(position);
+}
+
+void StreamQueue::pop_front() {
+  erase(entries.begin());
+}
+
+void StreamQueue::init_stream(iterator position) {
+  release(*position);
+  position->stream->init();
+}
+
+int64_t StreamQueue::get_key(const BaseStream* stream, Order order) {
+  switch (order) {
+    case Order::Priority:
+      return -(int64_t)stream->priority;
+    case Order::DataSize:
+      return (int64_t)std::max(
+          stream->my_current_phase.initial_data_size,
+          stream->my_current_phase.final_data_size);
+    case Order::RemainingPhases:
+    default:
+      return (int64_t)stream->phases_to_go.size();
+  }
+}
+
+StreamQueue::iterator StreamQueue::find_by_scan(int64_t key, Order order) {
+  iterator it = entries.begin();
+  while (it != entries.end()) {
+    if (!it->stream->initialized) {
+      int64_t stream_key = get_key(it->stream, order);
+      if (order == Order::Priority ? stream_key > key : stream_key >= key) {
+        break;
+      }
+    }
+    std::advance(it, 1);
+  }
+  return it;
+}
+
+StreamQueue::iterator StreamQueue::add_pending(
+    iterator position,
+    BaseStream* stream) {
+  pending_count++;
+  return entries.insert(position, Entry{stream, true, index.end()});
+}
+
+void StreamQueue::release(Entry& entry) {
+  if (!entry.pending) {
+    return;
+  }
+  entry.pending = false;
+  pending_count--;
+  if (indexed) {
+    index.erase(entry.index_position);
+  } else if (pending_count == 0) {
+    // nothing left out of order
+    indexed = true;
+  }
+}
+
+void StreamQueue::drop_index() {
+  indexed = false;
+  index.clear();
+}
+} // namespace AstraSim
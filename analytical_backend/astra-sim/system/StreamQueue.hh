@@ -0,0 +1,113 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __STREAMQUEUE_HH__
+#define __STREAMQUEUE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+
+namespace AstraSim {
+class BaseStream;
+
+/**
+ * Streams waiting for (or running on) one queue of a Sys: the ready list,
+ * and each queue of Sys::active_Streams.
+ *
+ * Streams are ordered as a list. Sys::insert_stream places a new stream
+ * before the first uninitialized stream it should precede under the
+ * intra-dimension scheduling policy. For the policies that compare one key
+ * (see Order), the queue also keeps an ordered index of its pending
+ * streams, i.e., the ones not initialized through init_stream() yet: as
+ * long as all of them were inserted by the same Order, they are sorted by
+ * that key in list order, and the insertion point is a lookup in the index
+ * instead of a scan of the list.
+ *
+ * A stream inserted at an arbitrary position (RG policy), or by another
+ * Order than the pending streams, makes the queue fall back to scanning
+ * the list until no stream is pending anymore.
+ */
+class StreamQueue {
+ public:
+  /**
+   * Keys of the insertion orders: a stream goes before the first
+   * uninitialized stream of
+   *  - Priority: a lower priority (after the ones of the same priority),
+   *  - DataSize: a current phase moving at least as much data,
+   *  - RemainingPhases: at least as many phases to go.
+   */
+  enum class Order { Priority, DataSize, RemainingPhases };
+
+  struct Entry;
+  using iterator = std::list<Entry>::iterator;
+  using Index = std::multimap<int64_t, iterator>;
+  struct Entry {
+    BaseStream* stream;
+    bool pending;
+    Index::iterator index_position;
+  };
+
+  bool empty() const;
+  size_t size() const;
+  iterator begin();
+  iterator end();
+  BaseStream* front() const;
+
+  /**
+   * Insert stream at its place under order.
+   * @return position of the stream
+   */
+  iterator insert(BaseStream* stream, Order order);
+
+  /**
+   * Append stream, keeping the index if its key under order is not lower
+   * than the ones of the pending streams.
+   * @return position of the stream
+   */
+  iterator push_back(BaseStream* stream, Order order);
+
+  /**
+   * Insert stream before position.
+   * @return position of the stream
+   */
+  iterator insert(iterator position, BaseStream* stream);
+
+  void erase(iterator position);
+  void pop_front();
+
+  /**
+   * Initialize the stream at position (BaseStream::init), which is then no
+   * longer pending.
+   */
+  void init_stream(iterator position);
+
+ private:
+  static int64_t get_key(const BaseStream* stream, Order order);
+
+  /**
+   * @return position of the first uninitialized stream of a key after key
+   * (Priority) or not before it (other orders), found by scanning the list
+   */
+  iterator find_by_scan(int64_t key, Order order);
+
+  iterator add_pending(iterator position, BaseStream* stream);
+  void release(Entry& entry);
+  void drop_index();
+
+  std::list<Entry> entries;
+  int pending_count = 0;
+
+  /**
+   * whether index holds all pending streams, in list order
+   */
+  bool indexed = true;
+  Order index_order = Order::Priority;
+  Index index;
+};
+} // namespace AstraSim
+
+#endif
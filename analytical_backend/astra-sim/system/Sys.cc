@@ -11,6 +11,7 @@ LICENSE file in the root directory of this source tree.
 #include "SimRecvCaller.hh"
 #include "SimSendCaller.hh"
 #include "StreamBaseline.hh"
+#include "SystemConfig.hh"
 #include "astra-sim/system/collective/AllToAll.hh"
 #include "astra-sim/system/collective/DoubleBinaryTreeAllReduce.hh"
 #include "astra-sim/system/collective/HalvingDoubling.hh"
@@ -36,9 +37,7 @@ LICENSE file in the root directory of this source tree.
 #include <numeric>
 
 namespace AstraSim {
-Tick Sys::offset = 0;
 uint8_t* Sys::dummy_data = new uint8_t[2];
-std::vector<Sys*> Sys::all_generators;
 
 Sys::~Sys() {
   end_sim_time = std::chrono::high_resolution_clock::now();
@@ -47,8 +46,9 @@ Sys::~Sys() {
   if (id == 0) {
     auto timenow =
         std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char timenow_str[26];
     std::cout << "*****" << std::endl
-              << "Time to exit: " << ctime(&timenow)
+              << "Time to exit: " << ctime_r(&timenow, timenow_str)
               << "all-reduce Collective implementation: "
               << inp_all_reduce_implementation << std::endl
               << "reduce-scatter Collective implementation: "
@@ -68,7 +68,7 @@ Sys::~Sys() {
               << std::endl
               << "*****" << std::endl;
   }
-  all_generators[id] = nullptr;
+  context->all_generators[id] = nullptr;
   for (auto lt : logical_topologies) {
     delete lt.second;
   }
@@ -100,7 +100,7 @@ Sys::~Sys() {
   if (nd_torus_ring_AlltoAll_AllReduce != nullptr)
     delete nd_torus_ring_AlltoAll_AllReduce;
   bool shouldExit = true;
-  for (auto& a : all_generators) {
+  for (auto& a : context->all_generators) {
     if (a != nullptr) {
       shouldExit = false;
       break;
@@ -115,6 +115,7 @@ Sys::~Sys() {
 // my_sys,std::string my_workload,int total_stat_rows,int stat_row,std::string
 // path,std::string run_name)
 Sys::Sys(
+    SimulationContext* context,
     AstraNetworkAPI* NI,
     AstraMemoryAPI* MEM,
     int id,
@@ -131,7 +132,8 @@ Sys::Sys(
     std::string path,
     std::string run_name,
     bool seprate_log,
-    bool rendezvous_enabled) {
+    bool rendezvous_enabled)
+    : call_events_data(id, EventType::CallEvents) {
   scheduler_unit = nullptr;
   vLevels = nullptr;
   memBus = nullptr;
@@ -148,6 +150,7 @@ Sys::Sys(
   this->dim_to_break = -1;
 
   start_sim_time = std::chrono::high_resolution_clock::now();
+  this->context = context;
   this->NI = NI;
   this->MEM = MEM;
   this->id = id;
@@ -172,10 +175,11 @@ Sys::Sys(
   this->failure_dim = 0;
   this->failure_type = 0; 
   this->current_layer_collective_type = ComType::All_Reduce; 
-  if ((id + 1) > all_generators.size()) {
-    all_generators.resize(id + 1);
+  if ((id + 1) > context->all_generators.size()) {
+    context->all_generators.resize(id + 1);
   }
-  all_generators[id] = this;
+  context->all_generators[id] = this;
+  context->generators_count++;
 
   bool result = initialize_sys(my_sys);
 
@@ -208,8 +212,7 @@ Sys::Sys(
       total_nodes *= physical_dims[current_dim];
     }
     for (int j = 0; j < queues_per_dim[current_dim]; j++) {
-      std::list<BaseStream*> temp;
-      active_Streams[element] = temp;
+      active_Streams[element] = StreamQueue();
       std::list<int> pri;
       stream_priorities[element] = pri;
       element++;
@@ -618,18 +621,6 @@ Tick Sys::mem_write(uint64_t bytes) {
   Tick delay_cycles = delay_ns / CLOCK_PERIOD;
   return delay_cycles;
 }
-std::string Sys::trim(
-    const std::string& str,
-    const std::string& whitespace = " \t") {
-  const auto strBegin = str.find_first_not_of(whitespace);
-  if (strBegin == std::string::npos)
-    return ""; // no content
-
-  const auto strEnd = str.find_last_not_of(whitespace);
-  const auto strRange = strEnd - strBegin + 1;
-
-  return str.substr(strBegin, strRange);
-}
 std::vector<CollectiveImplementation*> Sys::
     generate_collective_implementation_from_input(std::string input) {
   std::vector<std::string> inputs_per_dimension = split_string(input, "_");
@@ -677,158 +668,6 @@ std::vector<CollectiveImplementation*> Sys::
   }
   return result;
 }
-bool Sys::parse_var(std::string var, std::string value) {
-  var = trim(var);
-  value = trim(value);
-  if (id == 0) {
-    std::cout << "Var is: " << var << " ,val is: " << value << std::endl;
-  }
-  if (var == "scheduling-policy:") {
-    inp_scheduling_policy = value;
-  } else if (var == "all-reduce-implementation:") {
-    std::stringstream mval(value);
-    mval >> inp_all_reduce_implementation;
-  } else if (var == "reduce-scatter-implementation:") {
-    std::stringstream mval(value);
-    mval >> inp_reduce_scatter_implementation;
-  } else if (var == "all-gather-implementation:") {
-    std::stringstream mval(value);
-    mval >> inp_all_gather_implementation;
-  } else if (var == "all-to-all-implementation:") {
-    std::stringstream mval(value);
-    mval >> inp_all_to_all_implementation;
-  } else if (var == "collective-optimization:") {
-    std::stringstream mval(value);
-    mval >> inp_collective_optimization;
-  } else if (var == "endpoint-delay:") {
-    std::stringstream mval(value);
-    mval >> communication_delay;
-    communication_delay = communication_delay * injection_scale;
-  } else if (var == "local-reduction-delay:") {
-    std::stringstream mval(value);
-    mval >> local_reduction_delay;
-  } else if (var == "active-chunks-per-dimension:") {
-    std::stringstream mval(value);
-    mval >> active_chunks_per_dimension;
-  } else if (var == "L:") {
-    std::stringstream mval(value);
-    mval >> inp_L;
-  } else if (var == "o:") {
-    std::stringstream mval(value);
-    mval >> inp_o;
-  } else if (var == "g:") {
-    std::stringstream mval(value);
-    mval >> inp_g;
-  } else if (var == "G:") {
-    std::stringstream mval(value);
-    mval >> inp_G;
-  } else if (var == "model-shared-bus:") {
-    std::stringstream mval(value);
-    mval >> inp_model_shared_bus;
-  } else if (var == "preferred-dataset-splits:") {
-    std::stringstream mval(value);
-    mval >> preferred_dataset_splits;
-  } else if (var == "boost-mode:") {
-    std::stringstream mval(value);
-    mval >> inp_boost_mode;
-  } else if (var == "intra-dimension-scheduling:") {
-    std::stringstream mval(value);
-    std::string tmp;
-    mval >> tmp;
-    if (tmp == "FIFO") {
-      intra_dimension_scheduling = IntraDimensionScheduling::FIFO;
-    } else if (tmp == "RG") {
-      intra_dimension_scheduling = IntraDimensionScheduling::RG;
-    } else if (tmp == "SCF" || tmp == "smallestFirst") {
-      // SCF scheduling is introduced in the ISCA 2022 paper: https://dl.acm.org/doi/abs/10.1145/3470496.3527382
-      intra_dimension_scheduling = IntraDimensionScheduling::SmallestFirst;
-    } else if (tmp == "lessRemainingPhaseFirst") {
-      intra_dimension_scheduling =
-          IntraDimensionScheduling::LessRemainingPhaseFirst;
-    } else {
-      sys_panic(
-          "unknown value for intra-dimension-scheduling  in sys input file");
-    }
-  } else if (var == "inter-dimension-scheduling:") {
-    std::stringstream mval(value);
-    std::string tmp;
-    mval >> tmp;
-    if (tmp == "baseline" || tmp == "ascending") {
-      inter_dimension_scheduling = InterDimensionScheduling::Ascending;
-    } else if (tmp == "themis" || tmp == "offlineGreedy") {
-      // Themis scheduling is introduced in the ISCA 2022 paper: https://dl.acm.org/doi/abs/10.1145/3470496.3527382
-      inter_dimension_scheduling = InterDimensionScheduling::OfflineGreedy;
-    } else if (tmp == "themisFlex" || tmp == "offlineGreedyFlex") {
-      inter_dimension_scheduling = InterDimensionScheduling::OfflineGreedyFlex;
-    } else if (tmp == "roundRobin") {
-      inter_dimension_scheduling = InterDimensionScheduling::RoundRobin;
-    } else if (tmp == "ND_Torus_Ring"){
-      inter_dimension_scheduling = InterDimensionScheduling::ND_Torus_Ring;
-    } else if (tmp == "ND_Torus_Ring_AlltoAll_AllReduce"){
-      inter_dimension_scheduling = InterDimensionScheduling::ND_Torus_Ring_AlltoAll_AllReduce;
-    } else {
-      sys_panic(
-          "unknown value for inter-dimension-scheduling in sys input file");
-    }
-  } else if (var == "seprate-log:") {
-    std::stringstream mval(value);
-    int int_to_bool;
-    mval >> int_to_bool;
-    if (int_to_bool == 0) {
-      this->seprate_log = false;
-    } else {
-      this->seprate_log = true;
-    } 
-  } else if (var == "link-failure-per-dimension:") {
-    // Parse link failure per dimension
-    std::stringstream mval(value);
-    std::string dim_str;
-    while (getline(mval, dim_str, '_')) {
-      int dim_val = std::stoi(dim_str);
-      link_failure_per_dimension.push_back(dim_val);
-    }
-    for (size_t i=0; i < link_failure_per_dimension.size(); ++i) {
-      if (link_failure_per_dimension[i] != 0) {
-        this->failure_dim = i;
-      }
-    }
-  } else if (var == "link-failure-scheduling:") {
-    // Parse link failure scheduling
-    std::stringstream mval(value);
-    std::string tmp;
-    mval >> tmp;
-    if (tmp == "baseline" || tmp == "Baseline") {
-      link_failure_scheduling = LinkFailureScheduling::Baseline;
-    } else if (tmp == "mate" || tmp == "Mate") {
-      link_failure_scheduling = LinkFailureScheduling::Mate;
-    } else if (tmp == "mate_enhanced" || tmp == "Mate_Enhanced" || tmp == "mate_Enhanced" || tmp == "Mate_enhanced") {
-      link_failure_scheduling = LinkFailureScheduling::Mate_Enhanced;
-    } else {
-      sys_panic(
-          "unknown value for link-failure-scheduling in sys input file");
-    }
-  } else if (var == "failure-type:") {
-    // Parse failure type (5 types for two-failure-scenario)
-    // Galois change: here are five failure types for two-link-failures:
-    // 1. two failures in different rings of the same dimension (with dist = 1) -> need two acceleration stages
-    // 2. two failures in different rings of the same dimension (with dist > 1) -> could be done within one acceleration stage
-    // 3. two failures in the same ring -> could be done within one acceleration stage
-    // 4. two failures in the rings of different dimensions (with acceleration-link sharing) -> need two acceleration stages
-    // 5. two failures in the rings of different dimensions (without sharing) -> could be done within one acceleration stage
-    std::stringstream mval(value);
-    mval >> failure_type;
-  } else if (var == "non_uniform:") {
-    std::stringstream mval(value);
-    mval >> non_uniform_flag;
-  } else if (var != "") {
-    std::cerr
-        << "######### Exiting because " << var
-        << " is an unknown variable. Check your system input file. #########"
-        << std::endl;
-    exit(1);
-  } 
-  return true;
-}
 bool Sys::post_process_inputs() {
   all_reduce_implementation_per_dimension =
       generate_collective_implementation_from_input(
@@ -880,12 +719,25 @@ bool Sys::post_process_inputs() {
   } else {
     model_shared_bus = false;
   }
+  if (non_uniform_flag != 0) {
+    moe_distribution = TrafficDistribution::load(
+        *context->input_files, moe_distribution_file, moe_experts_count);
+    if (non_uniform_flag > moe_distribution->get_rows_count()) {
+      sys_panic(
+          "non_uniform in sys input file is beyond the rows of the MoE "
+          "distribution file");
+    }
+  }
+  if (!traffic_matrix_file.empty()) {
+    traffic_matrix =
+        TrafficMatrix::load(*context->input_files, traffic_matrix_file);
+  }
   return true;
 }
 bool Sys::initialize_sys(std::string name) {
-  std::ifstream inFile;
-  inFile.open(name);
-  if (!inFile) {
+  std::shared_ptr<const SystemConfig> config =
+      SystemConfig::load(*context->input_files, name);
+  if (config == nullptr) {
     if (id == 0) {
       std::cerr << "Unable to open file: " << name << std::endl;
       std::cerr << "############ Exiting because unable to open the system "
@@ -898,23 +750,47 @@ bool Sys::initialize_sys(std::string name) {
   } else {
     if (id == 0) {
       std::cout << "Success in opening system file" << std::endl;
+      for (const auto& entry : config->entries) {
+        std::cout << "Var is: " << entry.first << " ,val is: " << entry.second
+                  << std::endl;
+      }
     }
   }
-  std::string var;
-  std::string value;
-  while (inFile.peek() != EOF) {
-    var = "";
-    inFile >> var;
-    if (inFile.peek() != EOF) {
-      inFile >> value;
-    }
-    bool result = parse_var(var, value);
-    if (result == false) {
-      inFile.close();
-      return result;
+  inp_scheduling_policy = config->scheduling_policy;
+  inp_all_reduce_implementation = config->all_reduce_implementation;
+  inp_reduce_scatter_implementation = config->reduce_scatter_implementation;
+  inp_all_gather_implementation = config->all_gather_implementation;
+  inp_all_to_all_implementation = config->all_to_all_implementation;
+  inp_collective_optimization = config->collective_optimization;
+  if (config->endpoint_delay != -1) {
+    communication_delay = config->endpoint_delay * injection_scale;
+  }
+  local_reduction_delay = config->local_reduction_delay;
+  active_chunks_per_dimension = config->active_chunks_per_dimension;
+  inp_L = config->L;
+  inp_o = config->o;
+  inp_g = config->g;
+  inp_G = config->G;
+  inp_model_shared_bus = config->model_shared_bus;
+  preferred_dataset_splits = config->preferred_dataset_splits;
+  inp_boost_mode = config->boost_mode;
+  intra_dimension_scheduling = config->intra_dimension_scheduling;
+  inter_dimension_scheduling = config->inter_dimension_scheduling;
+  if (config->seprate_log != -1) {
+    seprate_log = (config->seprate_log == 1);
+  }
+  link_failure_per_dimension = config->link_failure_per_dimension;
+  for (size_t i = 0; i < link_failure_per_dimension.size(); ++i) {
+    if (link_failure_per_dimension[i] != 0) {
+      this->failure_dim = i;
     }
   }
-  inFile.close();
+  link_failure_scheduling = config->link_failure_scheduling;
+  failure_type = config->failure_type;
+  non_uniform_flag = config->non_uniform_flag;
+  moe_distribution_file = config->moe_distribution_file;
+  moe_experts_count = config->moe_experts_count;
+  traffic_matrix_file = config->traffic_matrix_file;
   return post_process_inputs();
 }
 Sys::SchedulerUnit::SchedulerUnit(
@@ -937,7 +813,7 @@ Sys::SchedulerUnit::SchedulerUnit(
   for (auto q : queues) {
     for (int i = 0; i < q; i++) {
       this->running_streams[base] = 0;
-      std::list<BaseStream*>::iterator it;
+      StreamQueue::iterator it;
       this->stream_pointer[base] = it;
       this->queue_id_to_dimension[base] = dimension;
       base++;
@@ -973,7 +849,7 @@ void Sys::SchedulerUnit::notify_stream_added(int vnet) {
   std::advance(stream_pointer[vnet], running_streams[vnet]);
   while (stream_pointer[vnet] != sys->active_Streams[vnet].end() &&
          running_streams[vnet] < queue_threshold) {
-    (*stream_pointer[vnet])->init();
+    sys->active_Streams[vnet].init_stream(stream_pointer[vnet]);
     running_streams[vnet]++;
     std::advance(stream_pointer[vnet], 1);
   }
@@ -1002,7 +878,6 @@ void Sys::SchedulerUnit::notify_stream_removed(int vnet, Tick running_time) {
     if (max > max_running_streams - this->sys->total_running_streams) {
       max = max_running_streams - this->sys->total_running_streams;
     }
-    // sys->ask_for_schedule(max);
     sys->schedule(max);
   }
   // tmp
@@ -1010,7 +885,7 @@ void Sys::SchedulerUnit::notify_stream_removed(int vnet, Tick running_time) {
   std::advance(stream_pointer[vnet], running_streams[vnet]);
   while (stream_pointer[vnet] != sys->active_Streams[vnet].end() &&
          running_streams[vnet] < queue_threshold) {
-    (*stream_pointer[vnet])->init();
+    sys->active_Streams[vnet].init_stream(stream_pointer[vnet]);
     running_streams[vnet]++;
     std::advance(stream_pointer[vnet], 1);
   }
@@ -1043,11 +918,12 @@ void Sys::iterate() {
 std::vector<std::string> Sys::split_string(std::string str, std::string sep) {
   char* cstr = const_cast<char*>(str.c_str());
   char* current;
+  char* save_ptr;
   std::vector<std::string> arr;
-  current = strtok(cstr, sep.c_str());
+  current = strtok_r(cstr, sep.c_str(), &save_ptr);
   while (current != nullptr) {
     arr.push_back(current);
-    current = strtok(nullptr, sep.c_str());
+    current = strtok_r(nullptr, sep.c_str(), &save_ptr);
   }
   return arr;
 }
@@ -1116,6 +992,43 @@ DataSet* Sys::generate_all_to_all(
       pref_scheduling,
       link_failure_per_dimension);
 }
+DataSet* Sys::generate_all_to_allv(
+    std::vector<bool> involved_dimensions,
+    SchedulingPolicy pref_scheduling,
+    int layer) {
+  if (traffic_matrix == nullptr) {
+    sys_panic("ALLTOALLV needs a traffic-matrix-file: in the sys input file");
+  }
+  if (traffic_matrix->get_npus_count() != total_nodes) {
+    sys_panic("the traffic matrix has a different number of NPUs");
+  }
+  if (!traffic_matrix->has_layer(layer)) {
+    sys_panic(
+        "the traffic matrix has no layer " + std::to_string(layer) +
+        " for its ALLTOALLV");
+  }
+  for (auto implementation : all_to_all_implementation_per_dimension) {
+    if (implementation->type != CollectiveImplementationType::HalfRing) {
+      sys_panic("ALLTOALLV is only supported by the halfring implementation");
+    }
+  }
+  uint64_t mean_send_size = traffic_matrix->get_mean_send_size(layer);
+  if (mean_send_size == 0) {
+    sys_panic(
+        "the traffic matrix has no traffic in layer " +
+        std::to_string(layer));
+  }
+  return generate_collective(
+      mean_send_size,
+      layer,
+      logical_topologies["AllToAll"],
+      all_to_all_implementation_per_dimension,
+      involved_dimensions,
+      ComType::All_to_All,
+      pref_scheduling,
+      link_failure_per_dimension,
+      layer);
+}
 CollectivePhase Sys::generate_collective_phase(
     ComType collective_type,
     int layer_num,
@@ -1126,7 +1039,8 @@ CollectivePhase Sys::generate_collective_phase(
     InjectionPolicy injection_policy,
     CollectiveImplementation* collective_implementation,
     bool boost_mode,
-    std::vector<int> link_failure_per_dimension) {
+    const std::vector<int>& link_failure_per_dimension,
+    const CollectivePlan::Phase::HalfRingMessages* half_ring_messages) {
   if (collective_implementation->type == CollectiveImplementationType::Ring ||
       collective_implementation->type ==
           CollectiveImplementationType::OneRing) {
@@ -1164,7 +1078,9 @@ CollectivePhase Sys::generate_collective_phase(
             this->physical_dims[this->failure_dim],
             this->physical_dims,
             this->failure_type,
-            this->non_uniform_flag));
+            this->non_uniform_flag,
+            this->moe_distribution.get(),
+            half_ring_messages));
     return vn;
   } else if (
       collective_implementation->type == CollectiveImplementationType::Direct ||
@@ -1225,7 +1141,8 @@ DataSet* Sys::generate_collective(
     std::vector<bool> dimensions_involved,
     ComType collective_type,
     SchedulingPolicy pref_scheduling,
-    std::vector<int> link_failure_per_dimension) {
+    std::vector<int> link_failure_per_dimension,
+    int traffic_matrix_layer) {
 
   uint64_t chunk_size = determine_chunk_size(size, collective_type);
   uint64_t recommended_chunk_size = chunk_size;
@@ -1233,7 +1150,6 @@ DataSet* Sys::generate_collective(
   uint64_t size_temp = size;
   this->current_layer_collective_type = collective_type; 
 
-  int tmp;
   DataSet* dataset = new DataSet(streams);
   int pri = get_priority(pref_scheduling);
   int count = 0;
@@ -1323,197 +1239,40 @@ DataSet* Sys::generate_collective(
            InterDimensionScheduling::ND_Torus_Ring_AlltoAll_AllReduce)) {
     size -= chunk_size;
     }
-    tmp = chunk_size;
-    std::list<CollectivePhase> vect;
 
-    if (collective_type != ComType::All_Reduce ||
-      collectiveOptimization == CollectiveOptimization::Baseline) {
-      // deal with different stream number
-      if (link_failure_scheduling == LinkFailureScheduling::Mate || 
-          link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced) {
-        for (int dim = 0; dim < dim_mapper.size(); dim++) { 
-          this->chunk_stage = dim;
-          NI->chunk_stage = this->chunk_stage;
-          NI->failure_type = this->failure_type;
-          if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-            continue;
-          }
-          std::pair<int, RingTopology::Direction> queue =
-              vLevels->get_next_queue_at_level(dim_mapper[dim]);
-          // generate collective_phase (which each is a ring) for each chunk in each dim
-          CollectivePhase phase = generate_collective_phase(
-              collective_type,
-              layer_num,
-              topology->get_basic_topology_at_dimension(
-                  dim_mapper[dim], collective_type),
-              tmp,
-              queue.first,
-              queue.second,
-              InjectionPolicy::Normal,
-              implementation_per_dimension[dim_mapper[dim]],
-              boost_mode,
-              link_failure_per_dimension);
-          vect.push_back(phase);
-          tmp = phase.final_data_size;
-        }  
-      } else {
-        for (int dim = 0; dim < dim_mapper.size(); dim++) { 
-          if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-            continue;
-          }
-          std::pair<int, RingTopology::Direction> queue =
-              vLevels->get_next_queue_at_level(dim_mapper[dim]);
-          // generate collective_phase (which each is a ring) for each chunk in each dim
-          CollectivePhase phase = generate_collective_phase(
-              collective_type,
-              layer_num,
-              topology->get_basic_topology_at_dimension(
-                  dim_mapper[dim], collective_type),
-              tmp,
-              queue.first,
-              queue.second,
-              InjectionPolicy::Normal,
-              implementation_per_dimension[dim_mapper[dim]],
-              boost_mode,
-              link_failure_per_dimension);
-          vect.push_back(phase);
-          tmp = phase.final_data_size;
-        }
-      }
-    } else if (
-        inter_dimension_scheduling == InterDimensionScheduling::OfflineGreedy ||
-        inter_dimension_scheduling ==
-            InterDimensionScheduling::OfflineGreedyFlex ||
-        inter_dimension_scheduling == InterDimensionScheduling::OnlineGreedy ||
-        inter_dimension_scheduling == 
-           InterDimensionScheduling::ND_Torus_Ring_AlltoAll_AllReduce) {
-      int dim = 0;
-      for (dim = 0; dim < topology->get_num_of_dimensions(); dim++) {
-        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-          continue;
-        }
-        std::pair<int, RingTopology::Direction> queue =
-            vLevels->get_next_queue_at_level(dim_mapper[dim]);
-        CollectivePhase phase = generate_collective_phase(
-            ComType::Reduce_Scatter,
-            layer_num,
-            topology->get_basic_topology_at_dimension(
-                dim_mapper[dim], ComType::Reduce_Scatter),
-            tmp,
-            queue.first,
-            queue.second,
-            InjectionPolicy::Normal,
-            implementation_per_dimension[dim_mapper[dim]],
-            boost_mode,
-            link_failure_per_dimension);
-        vect.push_back(phase);
-        tmp = phase.final_data_size;
-      }
-      dim--;
-      for (; dim >= 0; dim--) {
-        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-          continue;
-        }
-        std::pair<int, RingTopology::Direction> queue =
-            vLevels->get_next_queue_at_level(dim_mapper[dim]);
-        CollectivePhase phase = generate_collective_phase(
-            ComType::All_Gather,
-            layer_num,
-            topology->get_basic_topology_at_dimension(
-                dim_mapper[dim], ComType::All_Gather),
-            tmp,
-            queue.first,
-            queue.second,
-            InjectionPolicy::Normal,
-            implementation_per_dimension[dim_mapper[dim]],
-            boost_mode,
-            link_failure_per_dimension);
-        vect.push_back(phase);
-        tmp = phase.final_data_size;
-      }
-    } else {
-      int dim = 0;
-      int last_active_dim = 0;
-      for (dim = 0; dim < topology->get_num_of_dimensions(); dim++) {
-        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) != 1 &&
-            dimensions_involved[dim_mapper[dim]]) {
-          last_active_dim = dim;
-        }
-      }
-      for (dim = 0; dim < last_active_dim; dim++) {
-        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-          continue;
-        }
-        std::pair<int, RingTopology::Direction> queue =
-            vLevels->get_next_queue_at_level(dim_mapper[dim]);
-        CollectivePhase phase = generate_collective_phase(
-            ComType::Reduce_Scatter,
-            layer_num,
-            topology->get_basic_topology_at_dimension(
-                dim_mapper[dim], ComType::Reduce_Scatter),
-            tmp,
-            queue.first,
-            queue.second,
-            InjectionPolicy::Normal,
-            implementation_per_dimension[dim_mapper[dim]],
-            boost_mode,
-            link_failure_per_dimension);
-        vect.push_back(phase);
-        tmp = phase.final_data_size;
-      }
-      while (dim > 0 &&
-             (dimensions_involved[dim_mapper[dim]] == false ||
-              topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1)) {
-        dim--;
-      }
-      if (dimensions_involved[dim_mapper[dim]] &&
-          topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) > 1) {
-        std::pair<int, RingTopology::Direction> queue =
-            vLevels->get_next_queue_at_level(dim_mapper[dim]);
-        CollectivePhase phase = generate_collective_phase(
-            ComType::All_Reduce,
-            layer_num,
-            topology->get_basic_topology_at_dimension(
-                dim_mapper[dim], ComType::All_Reduce),
-            tmp,
-            queue.first,
-            queue.second,
-            InjectionPolicy::Normal,
-            implementation_per_dimension[dim_mapper[dim]],
-            boost_mode,
-            link_failure_per_dimension);
-        vect.push_back(phase);
-        tmp = phase.final_data_size;
-      }
-      dim--;
-      for (; dim >= 0; dim--) {
-        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
-            !dimensions_involved[dim_mapper[dim]]) {
-          continue;
-        }
-        std::pair<int, RingTopology::Direction> queue =
-            vLevels->get_next_queue_at_level(dim_mapper[dim]);
-        CollectivePhase phase = generate_collective_phase(
-            ComType::All_Gather,
-            layer_num,
-            topology->get_basic_topology_at_dimension(
-                dim_mapper[dim], ComType::All_Gather),
-            tmp,
-            queue.first,
-            queue.second,
-            InjectionPolicy::Normal,
-            implementation_per_dimension[dim_mapper[dim]],
-            boost_mode,
-            link_failure_per_dimension);
-        vect.push_back(phase);
-        tmp = phase.final_data_size;
-      }
+    // the phases of this chunk are derived once per distinct chunk
+    CollectivePlan::Key key;
+    key.collective_type = collective_type;
+    key.chunk_size = chunk_size;
+    key.dim_mapper = std::move(dim_mapper);
+    key.dimensions_involved = dimensions_involved;
+    key.link_failure_per_dimension = link_failure_per_dimension;
+    key.failure_dim = failure_dim;
+    key.traffic_matrix_layer = traffic_matrix_layer;
+    key.npu_id = non_uniform_flag != 0 ? id : -1;
+    auto cached = context->collective_plans.find(key);
+    if (cached == context->collective_plans.end()) {
+      CollectivePlan plan = plan_collective(
+          topology,
+          key.dim_mapper,
+          dimensions_involved,
+          collective_type,
+          chunk_size,
+          implementation_per_dimension,
+          link_failure_per_dimension,
+          traffic_matrix_layer);
+      cached = context->collective_plans
+                   .insert(std::make_pair(std::move(key), std::move(plan)))
+                   .first;
     }
+    std::list<CollectivePhase> vect = instantiate_collective_plan(
+        cached->second,
+        layer_num,
+        topology,
+        chunk_size,
+        implementation_per_dimension,
+        link_failure_per_dimension);
+
     if (vect.size() > 0) {
       StreamBaseline* newStream =
           new StreamBaseline(this, dataset, stream_counter++, vect, pri);
@@ -1530,21 +1289,232 @@ DataSet* Sys::generate_collective(
   }
   return dataset;
 }
+CollectivePlan Sys::plan_collective(
+    LogicalTopology* topology,
+    const std::vector<int>& dim_mapper,
+    const std::vector<bool>& dimensions_involved,
+    ComType collective_type,
+    uint64_t chunk_size,
+    const std::vector<CollectiveImplementation*>& implementation_per_dimension,
+    const std::vector<int>& link_failure_per_dimension,
+    int traffic_matrix_layer) {
+  CollectivePlan plan;
+  std::vector<CollectivePlan::Phase>& phases = plan.phases;
+
+  // HalfRing messages, for every link failure a queue of the phase can have
+  // (All-to-All phases all start from the chunk size)
+  std::vector<int> link_failures(link_failure_per_dimension);
+  std::sort(link_failures.begin(), link_failures.end());
+  link_failures.erase(
+      std::unique(link_failures.begin(), link_failures.end()),
+      link_failures.end());
+  std::vector<int> units_counts;
+  for (int i = 0; i < topology->get_num_of_dimensions(); i++) {
+    units_counts.push_back(topology->get_num_of_nodes_in_dimension(i));
+  }
+  std::vector<bool> dimensions_done(topology->get_num_of_dimensions(), false);
+  auto add_phase = [&](ComType comm_type, int dimension, int phase_stage) {
+    phases.emplace_back(comm_type, dimension, phase_stage);
+    if (implementation_per_dimension[dimension]->type !=
+        CollectiveImplementationType::HalfRing) {
+      return;
+    }
+    int nodes_in_ring = ((RingTopology*)topology->get_basic_topology_at_dimension(
+                             dimension, comm_type))
+                            ->get_nodes_in_ring();
+    int max_physical_dim_value =
+        *std::max_element(physical_dims.begin(), physical_dims.end());
+    int messages_stage = phase_stage >= 0 ? phase_stage : chunk_stage;
+    uint64_t data_size = HalfRing::get_scaled_data_size(
+        chunk_size, id, non_uniform_flag, moe_distribution.get());
+    for (int link_failure : link_failures) {
+      CollectivePlan::Phase::HalfRingMessages messages;
+      messages.link_failure = link_failure;
+      messages.stream_count = HalfRing::get_stream_count(
+          nodes_in_ring,
+          link_failure,
+          link_failure_scheduling,
+          messages_stage,
+          physical_dims[failure_dim],
+          max_physical_dim_value,
+          failure_type);
+      messages.msg_size = HalfRing::get_msg_size(
+          data_size,
+          nodes_in_ring,
+          link_failure,
+          link_failure_scheduling,
+          physical_dims.size(),
+          messages_stage,
+          physical_dims[failure_dim],
+          max_physical_dim_value,
+          failure_type);
+      // All-to-Allv: per-pair sizes of this dimension stage of the chunk
+      messages.message_scales = traffic_matrix_layer < 0
+          ? nullptr
+          : &traffic_matrix->get_stage_message_scales(
+                traffic_matrix_layer,
+                units_counts,
+                dimensions_done,
+                dimension,
+                link_failure != 0,
+                messages.stream_count);
+      phases.back().half_ring_messages.push_back(messages);
+    }
+  };
+
+  if (collective_type != ComType::All_Reduce ||
+    collectiveOptimization == CollectiveOptimization::Baseline) {
+    // deal with different stream number
+    if (link_failure_scheduling == LinkFailureScheduling::Mate || 
+        link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced) {
+      for (int dim = 0; dim < dim_mapper.size(); dim++) { 
+        plan.final_chunk_stage = dim;
+        if (dim > 0 && dim_mapper[dim] != dim_mapper[dim - 1]) {
+          dimensions_done[dim_mapper[dim - 1]] = true;
+        }
+        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+          continue;
+        }
+        // collective_phase (which each is a ring) for each chunk in each dim
+        add_phase(collective_type, dim_mapper[dim], dim);
+      }  
+    } else {
+      for (int dim = 0; dim < dim_mapper.size(); dim++) { 
+        if (dim > 0) {
+          dimensions_done[dim_mapper[dim - 1]] = true;
+        }
+        if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+          continue;
+        }
+        // collective_phase (which each is a ring) for each chunk in each dim
+        add_phase(collective_type, dim_mapper[dim], -1);
+      }
+    }
+  } else if (
+      inter_dimension_scheduling == InterDimensionScheduling::OfflineGreedy ||
+      inter_dimension_scheduling ==
+          InterDimensionScheduling::OfflineGreedyFlex ||
+      inter_dimension_scheduling == InterDimensionScheduling::OnlineGreedy ||
+      inter_dimension_scheduling == 
+         InterDimensionScheduling::ND_Torus_Ring_AlltoAll_AllReduce) {
+    int dim = 0;
+    for (dim = 0; dim < topology->get_num_of_dimensions(); dim++) {
+      if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+        continue;
+      }
+      add_phase(ComType::Reduce_Scatter, dim_mapper[dim], -1);
+    }
+    dim--;
+    for (; dim >= 0; dim--) {
+      if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+        continue;
+      }
+      add_phase(ComType::All_Gather, dim_mapper[dim], -1);
+    }
+  } else {
+    int dim = 0;
+    int last_active_dim = 0;
+    for (dim = 0; dim < topology->get_num_of_dimensions(); dim++) {
+      if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) != 1 &&
+          dimensions_involved[dim_mapper[dim]]) {
+        last_active_dim = dim;
+      }
+    }
+    for (dim = 0; dim < last_active_dim; dim++) {
+      if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+        continue;
+      }
+      add_phase(ComType::Reduce_Scatter, dim_mapper[dim], -1);
+    }
+    while (dim > 0 &&
+           (dimensions_involved[dim_mapper[dim]] == false ||
+            topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1)) {
+      dim--;
+    }
+    if (dimensions_involved[dim_mapper[dim]] &&
+        topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) > 1) {
+      add_phase(ComType::All_Reduce, dim_mapper[dim], -1);
+    }
+    dim--;
+    for (; dim >= 0; dim--) {
+      if (topology->get_num_of_nodes_in_dimension(dim_mapper[dim]) == 1 ||
+          !dimensions_involved[dim_mapper[dim]]) {
+        continue;
+      }
+      add_phase(ComType::All_Gather, dim_mapper[dim], -1);
+    }
+  }
+  return plan;
+}
+std::list<CollectivePhase> Sys::instantiate_collective_plan(
+    const CollectivePlan& plan,
+    int layer_num,
+    LogicalTopology* topology,
+    uint64_t chunk_size,
+    const std::vector<CollectiveImplementation*>& implementation_per_dimension,
+    const std::vector<int>& link_failure_per_dimension) {
+  std::list<CollectivePhase> vect;
+  int tmp = chunk_size;
+  for (const CollectivePlan::Phase& plan_phase : plan.phases) {
+    if (plan_phase.chunk_stage >= 0) {
+      this->chunk_stage = plan_phase.chunk_stage;
+      NI->chunk_stage = this->chunk_stage;
+      NI->failure_type = this->failure_type;
+    }
+    std::pair<int, RingTopology::Direction> queue =
+        vLevels->get_next_queue_at_level(plan_phase.dimension);
+    CollectiveImplementation* collective_implementation =
+        implementation_per_dimension[plan_phase.dimension];
+    const CollectivePlan::Phase::HalfRingMessages* half_ring_messages =
+        nullptr;
+    for (const auto& messages : plan_phase.half_ring_messages) {
+      if (messages.link_failure == link_failure_per_dimension[queue.first]) {
+        half_ring_messages = &messages;
+      }
+    }
+    CollectivePhase phase = generate_collective_phase(
+        plan_phase.comm_type,
+        layer_num,
+        topology->get_basic_topology_at_dimension(
+            plan_phase.dimension, plan_phase.comm_type),
+        tmp,
+        queue.first,
+        queue.second,
+        InjectionPolicy::Normal,
+        collective_implementation,
+        boost_mode,
+        link_failure_per_dimension,
+        half_ring_messages);
+    vect.push_back(phase);
+    tmp = phase.final_data_size;
+  }
+  if (plan.final_chunk_stage >= 0) {
+    this->chunk_stage = plan.final_chunk_stage;
+    NI->chunk_stage = this->chunk_stage;
+    NI->failure_type = this->failure_type;
+  }
+  return vect;
+}
 void Sys::call_events() {
-  for (auto& callable : event_queue[Sys::boostedTick()]) {
+  event_queue.advance(Sys::boostedTick());
+  Callable* callable;
+  EventType event;
+  CallData* data;
+  // events registered for this tick while it runs are run as well
+  while (event_queue.pop(callable, event, data)) {
     try {
       pending_events--;
-      (std::get<0>(callable))
-          ->call(std::get<1>(callable), std::get<2>(callable));
+      callable->call(event, data);
     } catch (...) {
       std::cerr << "warning! a callable is removed before call" << std::endl;
     }
   }
-  if (event_queue[Sys::boostedTick()].size() > 0) {
-    event_queue[Sys::boostedTick()].clear();
-  }
-  event_queue.erase(Sys::boostedTick());
-  if ((finished_workloads == 1 && event_queue.size() == 0) ||
+  if ((finished_workloads == 1 && event_queue.empty()) ||
       initialized == false) {
     delete this;
   }
@@ -1556,18 +1526,28 @@ void Sys::exitSimLoop(std::string msg) {
 }
 Tick Sys::boostedTick() {
   // return current time
-  Sys* ts = all_generators[0];
+  SimulationContext* context = SimulationContext::current();
+  const SimulationClock& clock = context->clock;
+  if (clock.is_driven() && !clock.is_checked()) {
+    return clock.get_tick() + context->offset;
+  }
+  Sys* ts = context->all_generators[0];
   if (ts == nullptr) {
-    for (int i = 1; i < all_generators.size(); i++) {
-      if (all_generators[i] != nullptr) {
-        ts = all_generators[i];
+    for (int i = 1; i < context->all_generators.size(); i++) {
+      if (context->all_generators[i] != nullptr) {
+        ts = context->all_generators[i];
         break;
       }
     }
   }
   timespec_t tmp = ts->NI->sim_get_time();
   Tick tick = tmp.time_val / CLOCK_PERIOD;
-  return tick + offset;
+  if (clock.is_driven() && clock.get_tick() != tick) {
+    sys_panic(
+        "simulation clock at tick " + std::to_string(clock.get_tick()) +
+        " while the network backend is at tick " + std::to_string(tick));
+  }
+  return tick + context->offset;
 }
 void Sys::proceed_to_next_vnet_baseline(StreamBaseline* stream) {
   if (!stream->is_ready()) {
@@ -1590,17 +1570,8 @@ void Sys::proceed_to_next_vnet_baseline(StreamBaseline* stream) {
     stream->dataset->notify_stream_finished((StreamStat*)stream);
   }
   if (stream->current_queue_id >= 0 && stream->my_current_phase.enabled) {
-    std::list<BaseStream*>& target =
-        active_Streams.at(stream->my_current_phase.queue_id);
-    for (std::list<BaseStream*>::iterator it = target.begin();
-         it != target.end();
-         ++it) {
-      if (((StreamBaseline*)(*it))->stream_num == stream->stream_num) {
-        // std::cout<<"deleted from scheduler"<<std::endl;
-        target.erase(it);
-        break;
-      }
-    }
+    active_Streams.at(stream->my_current_phase.queue_id)
+        .erase(stream->queue_position);
   }
   if (stream->phases_to_go.size() == 0) {
     total_running_streams--;
@@ -1650,38 +1621,30 @@ void Sys::proceed_to_next_vnet_baseline(StreamBaseline* stream) {
   }*/
 }
 void Sys::exiting() {}
-void Sys::insert_stream(std::list<BaseStream*>* queue, BaseStream* baseStream) {
-  std::list<BaseStream*>::iterator it = queue->begin();
+void Sys::insert_stream(StreamQueue* queue, BaseStream* baseStream) {
+  StreamQueue::iterator position;
   if (intra_dimension_scheduling == IntraDimensionScheduling::FIFO ||
       baseStream->current_queue_id < 0 ||
       baseStream->current_com_type == ComType::All_to_All ||
       baseStream->current_com_type == ComType::All_Reduce) {
-    while (it != queue->end()) {
-      if ((*it)->initialized == true) {
-        std::advance(it, 1);
-        continue;
-      } else if ((*it)->priority >= baseStream->priority) {
-        std::advance(it, 1);
-        continue;
-      } else {
-        break;
-      }
-    }
+    position = queue->insert(baseStream, StreamQueue::Order::Priority);
   } else if (intra_dimension_scheduling == IntraDimensionScheduling::RG) {
+    // the place depends on the types of the streams before it: scan
+    StreamQueue::iterator it = queue->begin();
     ComType one_to_last = ComType::None;
     ComType last = ComType::None;
     while (it != queue->end()) {
       one_to_last = last;
-      last = (*it)->current_com_type;
-      if ((*it)->initialized == true) {
+      last = it->stream->current_com_type;
+      if (it->stream->initialized == true) {
         std::advance(it, 1);
-        if (it != queue->end() && (*it)->initialized == false) {
+        if (it != queue->end() && it->stream->initialized == false) {
           one_to_last = last;
-          last = (*it)->current_com_type;
+          last = it->stream->current_com_type;
           std::advance(it, 1);
         }
         continue;
-      } else if ((*it)->priority > baseStream->priority) {
+      } else if (it->stream->priority > baseStream->priority) {
         std::advance(it, 1);
         continue;
       } else if (
@@ -1695,44 +1658,23 @@ void Sys::insert_stream(std::list<BaseStream*>* queue, BaseStream* baseStream) {
         break;
       }
     }
+    position = queue->insert(it, baseStream);
   } else if (
       intra_dimension_scheduling == IntraDimensionScheduling::SmallestFirst) {
     if (baseStream->phases_to_go.size() == 1) {
-      it = queue->end();
-    }
-    while (it != queue->end()) {
-      if ((*it)->initialized == true) {
-        std::advance(it, 1);
-        continue;
-      } else if (
-          std::max(
-              (*it)->my_current_phase.initial_data_size,
-              (*it)->my_current_phase.final_data_size) <
-          std::max(
-              baseStream->my_current_phase.initial_data_size,
-              baseStream->my_current_phase.final_data_size)) {
-        std::advance(it, 1);
-        continue;
-      } else {
-        break;
-      }
+      position = queue->push_back(baseStream, StreamQueue::Order::DataSize);
+    } else {
+      position = queue->insert(baseStream, StreamQueue::Order::DataSize);
     }
   } else if (
       intra_dimension_scheduling ==
       IntraDimensionScheduling::LessRemainingPhaseFirst) {
-    while (it != queue->end()) {
-      if ((*it)->initialized == true) {
-        std::advance(it, 1);
-        continue;
-      } else if ((*it)->phases_to_go.size() < baseStream->phases_to_go.size()) {
-        std::advance(it, 1);
-        continue;
-      } else {
-        break;
-      }
-    }
+    position =
+        queue->insert(baseStream, StreamQueue::Order::RemainingPhases);
+  } else {
+    position = queue->insert(queue->begin(), baseStream);
   }
-  queue->insert(it, baseStream);
+  baseStream->queue_position = position;
 }
 void Sys::register_for_finished_stream(Callable* callable) {
   registered_for_finished_stream_event.push_back(callable);
@@ -1771,19 +1713,12 @@ void Sys::try_register_event(
     EventType event,
     CallData* callData,
     Tick& cycles) {
-  bool should_schedule = false;
-  if (event_queue.find(Sys::boostedTick() + cycles) == event_queue.end()) {
-    std::list<std::tuple<Callable*, EventType, CallData*>> tmp;
-    event_queue[Sys::boostedTick() + cycles] = tmp;
-    should_schedule = true;
-  }
-  event_queue[Sys::boostedTick() + cycles].push_back(
-      std::make_tuple(callable, event, callData));
+  // one backend wakeup per distinct tick
+  bool should_schedule = event_queue.insert(
+      Sys::boostedTick() + cycles, callable, event, callData);
   if (should_schedule) {
     timespec_t tmp = generate_time(cycles);
-    BasicEventHandlerData* data =
-        new BasicEventHandlerData(id, EventType::CallEvents);
-    NI->sim_schedule(tmp, &Sys::handleEvent, data);
+    NI->sim_schedule(tmp, &Sys::handleEvent, &call_events_data);
   }
   cycles = 0;
   pending_events++;
@@ -1793,31 +1728,6 @@ void Sys::insert_into_ready_list(BaseStream* stream) {
   insert_stream(&ready_list, stream);
   scheduler_unit->notify_stream_added_into_ready_list();
 }
-void Sys::ask_for_schedule(int max) {
-  if (ready_list.size() == 0 ||
-      ready_list.front()->synchronizer[ready_list.front()->stream_num] <
-          all_generators.size()) {
-    return;
-  }
-  int top = ready_list.front()->stream_num;
-  int min = ready_list.size();
-  if (min > max) {
-    min = max;
-  }
-  for (auto& gen : all_generators) {
-    if (gen->ready_list.size() == 0 ||
-        gen->ready_list.front()->stream_num != top) {
-      return;
-    }
-    if (gen->ready_list.size() < min) {
-      min = gen->ready_list.size();
-    }
-  }
-  for (auto& gen : all_generators) {
-    gen->schedule(min);
-  }
-  return;
-}
 void Sys::schedule(int num) {
   int ready_list_size = ready_list.size();
   int counter = std::min(num, ready_list_size);
@@ -1829,13 +1739,11 @@ void Sys::schedule(int num) {
     proceed_to_next_vnet_baseline((StreamBaseline*)ready_list.front());
 
     if (ready_list.front()->current_queue_id == -1) {
+      StreamBarrierTable::Barrier& barrier =
+          context->stream_barriers.get(ready_list.front()->stream_num);
       Sys::sys_panic(
-          "should not happen! " +
-          std::to_string(
-              BaseStream::synchronizer[ready_list.front()->stream_num]) +
-          " , " +
-          std::to_string(
-              BaseStream::ready_counter[ready_list.front()->stream_num]) +
+          "should not happen! " + std::to_string(barrier.ready_tokens) +
+          " , " + std::to_string(barrier.arrivals) +
           " , top queue id: " + std::to_string(top_vn) +
           " , total phases: " + std::to_string(total_phases) +
           " , waiting streams: " + std::to_string(total_waiting_streams));
@@ -1857,8 +1765,8 @@ void Sys::handleEvent(void* arg) {
   if (event == EventType::CallEvents) {
     // std::cout<<"handle event triggered at node: "<<id<<" for call events! at
     // time: "<<Sys::boostedTick()<<std::endl;
-    all_generators[id]->iterate();
-    delete ehd;
+    // ehd is the Sys's own call_events_data, and the Sys may be deleted
+    SimulationContext::current()->all_generators[id]->iterate();
   } else if (event == EventType::RendezvousSend) {
     // std::cout<<"rendevouz send handle event triggered at node: "<<id<<" for
     // call events! at time: "<<Sys::boostedTick()<<std::endl;
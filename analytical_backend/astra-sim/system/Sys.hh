@@ -15,14 +15,22 @@ LICENSE file in the root directory of this source tree.
 #include <fstream>
 #include <list>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <tuple>
 #include <vector>
 #include "AstraMemoryAPI.hh"
 #include "AstraNetworkAPI.hh"
+#include "BasicEventHandlerData.hh"
 #include "Callable.hh"
 #include "CollectivePhase.hh"
+#include "CollectivePlan.hh"
 #include "Common.hh"
+#include "SimulationContext.hh"
+#include "StreamQueue.hh"
+#include "TimingWheel.hh"
+#include "TrafficDistribution.hh"
+#include "TrafficMatrix.hh"
 #include "UsageTracker.hh"
 #include "astra-sim/system/topology/RingTopology.hh"
 #include "astra-sim/workload/Workload.hh"
@@ -53,7 +61,7 @@ class Sys : public Callable {
     int queue_threshold;
     int max_running_streams;
     std::map<int, int> running_streams;
-    std::map<int, std::list<BaseStream*>::iterator> stream_pointer;
+    std::map<int, StreamQueue::iterator> stream_pointer;
 
     std::vector<Tick> latency_per_dimension;
     std::vector<double> total_chunks_per_dimension;
@@ -74,6 +82,7 @@ class Sys : public Callable {
   };
   SchedulerUnit* scheduler_unit;
   ~Sys();
+  SimulationContext* context;
   AstraNetworkAPI* NI;
   AstraMemoryAPI* MEM;
   int finished_workloads;
@@ -125,20 +134,19 @@ class Sys : public Callable {
   MemBus* memBus;
   int all_queues;
   // for supporting LIFO
-  std::list<BaseStream*> ready_list;
+  StreamQueue ready_list;
   SchedulingPolicy scheduling_policy;
   int first_phase_streams;
   int total_running_streams;
-  std::map<int, std::list<BaseStream*>> active_Streams;
+  std::map<int, StreamQueue> active_Streams;
   std::map<int, std::list<int>> stream_priorities;
 
   QueueLevels* vLevels;
   std::map<std::string, LogicalTopology*> logical_topologies;
-  std::map<Tick, std::list<std::tuple<Callable*, EventType, CallData*>>>
-      event_queue;
+  TimingWheel event_queue;
+  // argument of every CallEvents wakeup of this Sys
+  BasicEventHandlerData call_events_data;
   int total_nodes;
-  static Tick offset;
-  static std::vector<Sys*> all_generators;
   static uint8_t* dummy_data;
   // for reports
   uint64_t streams_injected;
@@ -165,6 +173,15 @@ class Sys : public Callable {
   LinkFailureScheduling link_failure_scheduling;
   int failure_type;
   int non_uniform_flag = 0;
+  // non-uniform All-to-All: row (non_uniform_flag - 1) of the MoE
+  // distribution gives the data each NPU sends
+  std::string moe_distribution_file =
+      "../../inputs/workload/Non-Uniform-MoE/MoE_Distribution.txt";
+  int moe_experts_count = 8;
+  std::shared_ptr<const TrafficDistribution> moe_distribution;
+  // per-pair traffic of the All-to-Allv (ALLTOALLV) collectives
+  std::string traffic_matrix_file;
+  std::shared_ptr<const TrafficMatrix> traffic_matrix;
   int round_robin_inter_dimension_scheduler;
   OfflineGreedy* offline_greedy;
   ND_Torus_Ring* nd_torus_ring;
@@ -180,7 +197,6 @@ class Sys : public Callable {
       CallData* callData,
       Tick cycles);
   void insert_into_ready_list(BaseStream* stream);
-  void ask_for_schedule(int max);
   void schedule(int num);
 
   void register_phases(
@@ -195,6 +211,7 @@ class Sys : public Callable {
   void call_events();
   void workload_finished() {
     finished_workloads++;
+    context->workload_finished_ticks.emplace(id, boostedTick());
   };
   static Tick boostedTick();
   static void exiting();
@@ -203,7 +220,8 @@ class Sys : public Callable {
   void exitSimLoop(std::string msg);
   bool seprate_log;
 
-  Sys(AstraNetworkAPI* NI,
+  Sys(SimulationContext* context,
+      AstraNetworkAPI* NI,
       AstraMemoryAPI* MEM,
       int id,
       int num_passes,
@@ -223,8 +241,6 @@ class Sys : public Callable {
 
   void iterate();
   bool initialize_sys(std::string name);
-  std::string trim(const std::string& str, const std::string& whitespace);
-  bool parse_var(std::string var, std::string value);
   bool post_process_inputs();
   std::vector<CollectiveImplementation*>
   generate_collective_implementation_from_input(std::string input);
@@ -303,6 +319,10 @@ class Sys : public Callable {
       std::vector<bool> involved_dimensions,
       SchedulingPolicy pref_scheduling,
       int layer);
+  DataSet* generate_all_to_allv(
+      std::vector<bool> involved_dimensions,
+      SchedulingPolicy pref_scheduling,
+      int layer);
   DataSet* generate_all_gather(
       uint64_t size,
       std::vector<bool> involved_dimensions,
@@ -321,7 +341,8 @@ class Sys : public Callable {
       std::vector<bool> dimensions_involved,
       ComType collective_type,
       SchedulingPolicy pref_scheduling,
-      std::vector<int> link_failure_per_dimension);
+      std::vector<int> link_failure_per_dimension,
+      int traffic_matrix_layer = -1);
   CollectivePhase generate_collective_phase(
       ComType collective_type,
       int layer_num,
@@ -332,8 +353,34 @@ class Sys : public Callable {
       InjectionPolicy injection_policy,
       CollectiveImplementation* collective_implementation,
       bool boost_mode,
-      std::vector<int> link_failure_per_dimension);
-  void insert_stream(std::list<BaseStream*>* queue, BaseStream* baseStream);
+      const std::vector<int>& link_failure_per_dimension,
+      const CollectivePlan::Phase::HalfRingMessages* half_ring_messages =
+          nullptr);
+  /**
+   * Phases of one chunk of a collective (see CollectivePlan).
+   * @param dim_mapper order in which the chunk visits the dimensions
+   */
+  CollectivePlan plan_collective(
+      LogicalTopology* topology,
+      const std::vector<int>& dim_mapper,
+      const std::vector<bool>& dimensions_involved,
+      ComType collective_type,
+      uint64_t chunk_size,
+      const std::vector<CollectiveImplementation*>& implementation_per_dimension,
+      const std::vector<int>& link_failure_per_dimension,
+      int traffic_matrix_layer);
+  /**
+   * Algorithms of one chunk following a plan, each on the next queue of
+   * its dimension.
+   */
+  std::list<CollectivePhase> instantiate_collective_plan(
+      const CollectivePlan& plan,
+      int layer_num,
+      LogicalTopology* topology,
+      uint64_t chunk_size,
+      const std::vector<CollectiveImplementation*>& implementation_per_dimension,
+      const std::vector<int>& link_failure_per_dimension);
+  void insert_stream(StreamQueue* queue, BaseStream* baseStream);
   void proceed_to_next_vnet_baseline(StreamBaseline* stream);
   uint64_t determine_chunk_size(uint64_t size, ComType type);
   int get_priority(SchedulingPolicy pref_scheduling);
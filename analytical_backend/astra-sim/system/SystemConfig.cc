@@ -0,0 +1,185 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SystemConfig.hh"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace AstraSim {
+namespace {
+std::string trim(
+    const std::string& str,
+    const std::string& whitespace = " \t") {
+  const auto strBegin = str.find_first_not_of(whitespace);
+  if (strBegin == std::string::npos)
+    return ""; // no content
+
+  const auto strEnd = str.find_last_not_of(whitespace);
+  const auto strRange = strEnd - strBegin + 1;
+
+  return str.substr(strBegin, strRange);
+}
+
+void config_panic(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  exit(1);
+}
+} // namespace
+
+std::shared_ptr<const SystemConfig> SystemConfig::load(
+    InputFiles& input_files,
+    const std::string& path) {
+  return input_files.system_configs.get(
+      path, [&]() -> std::shared_ptr<const SystemConfig> {
+        std::ifstream inFile;
+        inFile.open(path);
+        if (!inFile) {
+          return nullptr;
+        }
+        auto config = std::make_shared<SystemConfig>();
+        std::string var;
+        std::string value;
+        while (inFile.peek() != EOF) {
+          var = "";
+          inFile >> var;
+          if (inFile.peek() != EOF) {
+            inFile >> value;
+          }
+          var = trim(var);
+          value = trim(value);
+          config->entries.emplace_back(var, value);
+          if (!config->parse_var(var, value)) {
+            std::cerr << "######### Exiting because " << var
+                      << " is an unknown variable. Check your system input "
+                         "file. #########"
+                      << std::endl;
+            exit(1);
+          }
+        }
+        inFile.close();
+        return config;
+      });
+}
+
+bool SystemConfig::parse_var(const std::string& var, const std::string& value) {
+  std::stringstream mval(value);
+  if (var == "scheduling-policy:") {
+    scheduling_policy = value;
+  } else if (var == "all-reduce-implementation:") {
+    mval >> all_reduce_implementation;
+  } else if (var == "reduce-scatter-implementation:") {
+    mval >> reduce_scatter_implementation;
+  } else if (var == "all-gather-implementation:") {
+    mval >> all_gather_implementation;
+  } else if (var == "all-to-all-implementation:") {
+    mval >> all_to_all_implementation;
+  } else if (var == "collective-optimization:") {
+    mval >> collective_optimization;
+  } else if (var == "endpoint-delay:") {
+    mval >> endpoint_delay;
+  } else if (var == "local-reduction-delay:") {
+    mval >> local_reduction_delay;
+  } else if (var == "active-chunks-per-dimension:") {
+    mval >> active_chunks_per_dimension;
+  } else if (var == "L:") {
+    mval >> L;
+  } else if (var == "o:") {
+    mval >> o;
+  } else if (var == "g:") {
+    mval >> g;
+  } else if (var == "G:") {
+    mval >> G;
+  } else if (var == "model-shared-bus:") {
+    mval >> model_shared_bus;
+  } else if (var == "preferred-dataset-splits:") {
+    mval >> preferred_dataset_splits;
+  } else if (var == "boost-mode:") {
+    mval >> boost_mode;
+  } else if (var == "intra-dimension-scheduling:") {
+    std::string tmp;
+    mval >> tmp;
+    if (tmp == "FIFO") {
+      intra_dimension_scheduling = IntraDimensionScheduling::FIFO;
+    } else if (tmp == "RG") {
+      intra_dimension_scheduling = IntraDimensionScheduling::RG;
+    } else if (tmp == "SCF" || tmp == "smallestFirst") {
+      // SCF scheduling is introduced in the ISCA 2022 paper: https://dl.acm.org/doi/abs/10.1145/3470496.3527382
+      intra_dimension_scheduling = IntraDimensionScheduling::SmallestFirst;
+    } else if (tmp == "lessRemainingPhaseFirst") {
+      intra_dimension_scheduling =
+          IntraDimensionScheduling::LessRemainingPhaseFirst;
+    } else {
+      config_panic(
+          "unknown value for intra-dimension-scheduling  in sys input file");
+    }
+  } else if (var == "inter-dimension-scheduling:") {
+    std::string tmp;
+    mval >> tmp;
+    if (tmp == "baseline" || tmp == "ascending") {
+      inter_dimension_scheduling = InterDimensionScheduling::Ascending;
+    } else if (tmp == "themis" || tmp == "offlineGreedy") {
+      // Themis scheduling is introduced in the ISCA 2022 paper: https://dl.acm.org/doi/abs/10.1145/3470496.3527382
+      inter_dimension_scheduling = InterDimensionScheduling::OfflineGreedy;
+    } else if (tmp == "themisFlex" || tmp == "offlineGreedyFlex") {
+      inter_dimension_scheduling = InterDimensionScheduling::OfflineGreedyFlex;
+    } else if (tmp == "roundRobin") {
+      inter_dimension_scheduling = InterDimensionScheduling::RoundRobin;
+    } else if (tmp == "ND_Torus_Ring"){
+      inter_dimension_scheduling = InterDimensionScheduling::ND_Torus_Ring;
+    } else if (tmp == "ND_Torus_Ring_AlltoAll_AllReduce"){
+      inter_dimension_scheduling = InterDimensionScheduling::ND_Torus_Ring_AlltoAll_AllReduce;
+    } else {
+      config_panic(
+          "unknown value for inter-dimension-scheduling in sys input file");
+    }
+  } else if (var == "seprate-log:") {
+    int int_to_bool;
+    mval >> int_to_bool;
+    seprate_log = (int_to_bool == 0) ? 0 : 1;
+  } else if (var == "link-failure-per-dimension:") {
+    // Parse link failure per dimension
+    std::string dim_str;
+    while (getline(mval, dim_str, '_')) {
+      int dim_val = std::stoi(dim_str);
+      link_failure_per_dimension.push_back(dim_val);
+    }
+  } else if (var == "link-failure-scheduling:") {
+    // Parse link failure scheduling
+    std::string tmp;
+    mval >> tmp;
+    if (tmp == "baseline" || tmp == "Baseline") {
+      link_failure_scheduling = LinkFailureScheduling::Baseline;
+    } else if (tmp == "mate" || tmp == "Mate") {
+      link_failure_scheduling = LinkFailureScheduling::Mate;
+    } else if (tmp == "mate_enhanced" || tmp == "Mate_Enhanced" || tmp == "mate_Enhanced" || tmp == "Mate_enhanced") {
+      link_failure_scheduling = LinkFailureScheduling::Mate_Enhanced;
+    } else {
+      config_panic(
+          "unknown value for link-failure-scheduling in sys input file");
+    }
+  } else if (var == "failure-type:") {
+    // Parse failure type (5 types for two-failure-scenario)
+    // Galois change: here are five failure types for two-link-failures:
+    // 1. two failures in different rings of the same dimension (with dist = 1) -> need two acceleration stages
+    // 2. two failures in different rings of the same dimension (with dist > 1) -> could be done within one acceleration stage
+    // 3. two failures in the same ring -> could be done within one acceleration stage
+    // 4. two failures in the rings of different dimensions (with acceleration-link sharing) -> need two acceleration stages
+    // 5. two failures in the rings of different dimensions (without sharing) -> could be done within one acceleration stage
+    mval >> failure_type;
+  } else if (var == "non_uniform:") {
+    mval >> non_uniform_flag;
+  } else if (var == "moe-distribution-file:") {
+    moe_distribution_file = value;
+  } else if (var == "moe-experts-count:") {
+    mval >> moe_experts_count;
+  } else if (var == "traffic-matrix-file:") {
+    traffic_matrix_file = value;
+  } else if (var != "") {
+    return false;
+  }
+  return true;
+}
+} // namespace AstraSim
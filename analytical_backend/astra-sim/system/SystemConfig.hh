@@ -0,0 +1,85 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SYSTEMCONFIG_HH__
+#define __SYSTEMCONFIG_HH__
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Common.hh"
+#include "InputFiles.hh"
+
+namespace AstraSim {
+/**
+ * Parsed system input file.
+ *
+ * A file is parsed once per InputFiles: every NPU copies the same read-only
+ * values into its Sys (see Sys::initialize_sys), combining them with its own
+ * arguments (e.g. the injection scale). Variables absent from the file keep
+ * the defaults below.
+ */
+class SystemConfig {
+ public:
+  /**
+   * Get the config of a system input file, parsing it on first use.
+   * Exits if a variable or one of its values is unknown.
+   * @param input_files parsed files of the simulation
+   * @param path system input file
+   * @return shared config, nullptr if the file cannot be opened
+   */
+  static std::shared_ptr<const SystemConfig> load(
+      InputFiles& input_files,
+      const std::string& path);
+
+  /**
+   * (variable, value) pairs in file order, trimmed (logged by NPU 0)
+   */
+  std::vector<std::pair<std::string, std::string>> entries;
+
+  std::string scheduling_policy;
+  std::string all_reduce_implementation;
+  std::string reduce_scatter_implementation;
+  std::string all_gather_implementation;
+  std::string all_to_all_implementation;
+  std::string collective_optimization;
+  // unscaled, -1 keeps the default communication delay of Sys
+  int endpoint_delay = -1;
+  int local_reduction_delay = 1;
+  int active_chunks_per_dimension = 1;
+  float L = 0;
+  float o = 0;
+  float g = 0;
+  float G = 0;
+  int model_shared_bus = 0;
+  int preferred_dataset_splits = 1;
+  int boost_mode = 0;
+  IntraDimensionScheduling intra_dimension_scheduling =
+      IntraDimensionScheduling::FIFO;
+  InterDimensionScheduling inter_dimension_scheduling =
+      InterDimensionScheduling::Ascending;
+  // 0 or 1, -1 keeps the seprate_log argument of Sys
+  int seprate_log = -1;
+  std::vector<int> link_failure_per_dimension;
+  LinkFailureScheduling link_failure_scheduling =
+      LinkFailureScheduling::Baseline;
+  int failure_type = 0;
+  int non_uniform_flag = 0;
+  std::string moe_distribution_file =
+      "../../inputs/workload/Non-Uniform-MoE/MoE_Distribution.txt";
+  int moe_experts_count = 8;
+  std::string traffic_matrix_file;
+
+ private:
+  /**
+   * Store one variable of the file.
+   * @return false if var is unknown
+   */
+  bool parse_var(const std::string& var, const std::string& value);
+};
+} // namespace AstraSim
+
+#endif
@@ -0,0 +1,187 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "TimingWheel.hh"
+
+namespace AstraSim {
+TimingWheel::TimingWheel()
+    : now(0), buckets_count(0), free_events(nullptr), free_buckets(nullptr) {
+  for (int level = 0; level < levels_count; level++) {
+    for (int slot = 0; slot < slots_count; slot++) {
+      slots[level][slot] = nullptr;
+    }
+  }
+}
+
+bool TimingWheel::insert(
+    Tick tick,
+    Callable* callable,
+    EventType event,
+    CallData* data) {
+  bool added;
+  Bucket* bucket = find_or_add_bucket(tick, added);
+  Event* node = allocate_event();
+  node->callable = callable;
+  node->event = event;
+  node->data = data;
+  node->next = nullptr;
+  if (bucket->tail == nullptr) {
+    bucket->head = node;
+  } else {
+    bucket->tail->next = node;
+  }
+  bucket->tail = node;
+  return added;
+}
+
+void TimingWheel::advance(Tick tick) {
+  if (tick == now) {
+    return;
+  }
+  // detach the slots tick reaches on each level (and its overflow range),
+  // then re-insert their buckets relative to the new wheel time
+  Bucket* cascaded = nullptr;
+  auto detach = [&cascaded](Bucket* list) {
+    while (list != nullptr) {
+      Bucket* next = list->next;
+      list->next = cascaded;
+      cascaded = list;
+      list = next;
+    }
+  };
+  int overflow_shift = slot_bits * levels_count;
+  if ((tick >> overflow_shift) != (now >> overflow_shift)) {
+    Tick range_start = (tick >> overflow_shift) << overflow_shift;
+    Tick range_end = range_start + ((Tick)1 << overflow_shift);
+    auto first = overflow.lower_bound(range_start);
+    auto last = overflow.lower_bound(range_end);
+    for (auto it = first; it != last; it++) {
+      it->second->next = cascaded;
+      cascaded = it->second;
+    }
+    overflow.erase(first, last);
+  }
+  for (int level = levels_count - 1; level > 0; level--) {
+    int shift = slot_bits * level;
+    if ((tick >> shift) != (now >> shift)) {
+      Bucket*& slot = slots[level][(tick >> shift) & (slots_count - 1)];
+      detach(slot);
+      slot = nullptr;
+    }
+  }
+  now = tick;
+  while (cascaded != nullptr) {
+    Bucket* next = cascaded->next;
+    insert_bucket(cascaded);
+    cascaded = next;
+  }
+}
+
+bool TimingWheel::pop(Callable*& callable, EventType& event, CallData*& data) {
+  Bucket*& slot = slots[0][now & (slots_count - 1)];
+  Bucket* bucket = slot;
+  if (bucket == nullptr || bucket->tick != now) {
+    return false;
+  }
+  Event* node = bucket->head;
+  if (node == nullptr) {
+    // the tick is over
+    slot = nullptr;
+    bucket->next = free_buckets;
+    free_buckets = bucket;
+    buckets_count--;
+    return false;
+  }
+  bucket->head = node->next;
+  if (bucket->head == nullptr) {
+    bucket->tail = nullptr;
+  }
+  callable = node->callable;
+  event = node->event;
+  data = node->data;
+  node->next = free_events;
+  free_events = node;
+  return true;
+}
+
+bool TimingWheel::empty() const {
+  return buckets_count == 0;
+}
+
+TimingWheel::Bucket** TimingWheel::get_slot(Tick tick) {
+  Tick difference = tick ^ now;
+  for (int level = 0; level < levels_count; level++) {
+    int shift = slot_bits * (level + 1);
+    if ((difference >> shift) == 0) {
+      return &slots[level][(tick >> (slot_bits * level)) & (slots_count - 1)];
+    }
+  }
+  return nullptr;
+}
+
+TimingWheel::Bucket* TimingWheel::find_or_add_bucket(Tick tick, bool& added) {
+  added = false;
+  Bucket** slot = get_slot(tick);
+  if (slot == nullptr) {
+    auto it = overflow.find(tick);
+    if (it != overflow.end()) {
+      return it->second;
+    }
+  } else {
+    for (Bucket* bucket = *slot; bucket != nullptr; bucket = bucket->next) {
+      if (bucket->tick == tick) {
+        return bucket;
+      }
+    }
+  }
+  Bucket* bucket = allocate_bucket();
+  bucket->tick = tick;
+  bucket->head = nullptr;
+  bucket->tail = nullptr;
+  insert_bucket(bucket);
+  buckets_count++;
+  added = true;
+  return bucket;
+}
+
+void TimingWheel::insert_bucket(Bucket* bucket) {
+  Bucket** slot = get_slot(bucket->tick);
+  if (slot == nullptr) {
+    bucket->next = nullptr;
+    overflow[bucket->tick] = bucket;
+  } else {
+    bucket->next = *slot;
+    *slot = bucket;
+  }
+}
+
+TimingWheel::Event* TimingWheel::allocate_event() {
+  if (free_events == nullptr) {
+    event_chunks.emplace_back(new Event[chunk_size]);
+    Event* chunk = event_chunks.back().get();
+    for (int i = 0; i < chunk_size; i++) {
+      chunk[i].next = free_events;
+      free_events = &chunk[i];
+    }
+  }
+  Event* node = free_events;
+  free_events = node->next;
+  return node;
+}
+
+TimingWheel::Bucket* TimingWheel::allocate_bucket() {
+  if (free_buckets == nullptr) {
+    bucket_chunks.emplace_back(new Bucket[chunk_size]);
+    Bucket* chunk = bucket_chunks.back().get();
+    for (int i = 0; i < chunk_size; i++) {
+      chunk[i].next = free_buckets;
+      free_buckets = &chunk[i];
+    }
+  }
+  Bucket* bucket = free_buckets;
+  free_buckets = bucket->next;
+  return bucket;
+}
+} // namespace AstraSim
@@ -0,0 +1,103 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __TIMINGWHEEL_HH__
+#define __TIMINGWHEEL_HH__
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "CallData.hh"
+#include "Callable.hh"
+#include "Common.hh"
+
+namespace AstraSim {
+/**
+ * Pending events of one Sys, by the tick they are due at.
+ *
+ * A hierarchical timing wheel: levels_count levels of slots_count slots,
+ * level k holding the ticks that first differ from the wheel time in the
+ * k-th group of slot_bits bits (ticks further away go to an ordered
+ * overflow map). Each distinct pending tick has one bucket with an
+ * intrusive FIFO list of its events; buckets and events are recycled
+ * through free lists, so steady-state scheduling does not allocate.
+ *
+ * The wheel time only moves forward, in advance(), to the tick whose
+ * events are about to run; buckets of the higher levels are cascaded
+ * down as their slot is reached. Events are inserted at or after the
+ * wheel time, and the events of a tick run in insertion order, including
+ * the ones inserted while the tick runs.
+ */
+class TimingWheel {
+ public:
+  TimingWheel();
+
+  /**
+   * Add an event due at tick (at or after the wheel time).
+   * @return whether tick had no pending event before (needs a wakeup)
+   */
+  bool insert(Tick tick, Callable* callable, EventType event, CallData* data);
+
+  /**
+   * Move the wheel time to tick, before running its events.
+   */
+  void advance(Tick tick);
+
+  /**
+   * Take the first event of the wheel time's tick. When the tick has no
+   * event left its bucket is released, and false is returned.
+   */
+  bool pop(Callable*& callable, EventType& event, CallData*& data);
+
+  /**
+   * @return whether no tick has a pending event
+   */
+  bool empty() const;
+
+ private:
+  static const int slot_bits = 6;
+  static const int slots_count = 1 << slot_bits;
+  static const int levels_count = 4;
+
+  struct Event {
+    Callable* callable;
+    EventType event;
+    CallData* data;
+    Event* next;
+  };
+
+  struct Bucket {
+    Tick tick;
+    Event* head;
+    Event* tail;
+    Bucket* next;
+  };
+
+  /**
+   * Slot list of tick (relative to the wheel time), nullptr if it belongs
+   * to the overflow map.
+   */
+  Bucket** get_slot(Tick tick);
+  Bucket* find_or_add_bucket(Tick tick, bool& added);
+  void insert_bucket(Bucket* bucket);
+
+  Event* allocate_event();
+  Bucket* allocate_bucket();
+
+  Tick now;
+  int buckets_count;
+  Bucket* slots[levels_count][slots_count];
+  std::map<Tick, Bucket*> overflow;
+
+  // free lists, and the chunks their nodes are allocated from
+  static const int chunk_size = 16;
+  Event* free_events;
+  Bucket* free_buckets;
+  std::vector<std::unique_ptr<Event[]>> event_chunks;
+  std::vector<std::unique_ptr<Bucket[]>> bucket_chunks;
+};
+} // namespace AstraSim
+
+#endif
@@ -0,0 +1,84 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "TrafficDistribution.hh"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace AstraSim {
+std::shared_ptr<const TrafficDistribution> TrafficDistribution::load(
+    InputFiles& input_files,
+    const std::string& path,
+    int experts_count) {
+  return input_files.traffic_distributions.get(
+      std::make_pair(path, experts_count), [&]() {
+        return std::shared_ptr<const TrafficDistribution>(
+            new TrafficDistribution(path, experts_count));
+      });
+}
+
+TrafficDistribution::TrafficDistribution(
+    const std::string& path,
+    int experts_count)
+    : experts_count(experts_count), rows_count(0), uniform_load(0) {
+  std::ifstream infile(path);
+  if (!infile.is_open()) {
+    std::cerr << "Unable to open MoE distribution file: " << path
+              << std::endl;
+    exit(1);
+  }
+  if (experts_count <= 0 || (uint64_t)experts_count > tokens_count) {
+    std::cerr << "MoE experts count should be in [1, " << tokens_count
+              << "]: " << experts_count << std::endl;
+    exit(1);
+  }
+  uniform_load = tokens_count / experts_count;
+
+  std::string line;
+  int blank_lines = 0;
+  while (std::getline(infile, line)) {
+    // remove the [] in the line
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty()) {
+      // trailing blank lines are fine, they do not shift any row index
+      ++blank_lines;
+      continue;
+    }
+    if (blank_lines > 0) {
+      std::cerr << "MoE distribution file " << path << ": blank line before "
+                << "row " << rows_count + blank_lines
+                << " (rows are indexed by line)" << std::endl;
+      exit(1);
+    }
+    if (line.front() == '[') line.erase(0, 1);
+    if (!line.empty() && line.back() == ']') line.pop_back();
+
+    std::stringstream ss(line);
+    std::string number_str;
+    int current_col = 0;
+    while (current_col < experts_count && std::getline(ss, number_str, ',')) {
+      loads.push_back(std::stoull(number_str));
+      ++current_col;
+    }
+    if (current_col < experts_count) {
+      std::cerr << "MoE distribution file " << path << ": row " << rows_count
+                << " has " << current_col << " values, " << experts_count
+                << " experts expected" << std::endl;
+      exit(1);
+    }
+    ++rows_count;
+  }
+}
+
+int TrafficDistribution::get_rows_count() const {
+  return rows_count;
+}
+
+int TrafficDistribution::get_experts_count() const {
+  return experts_count;
+}
+} // namespace AstraSim
@@ -0,0 +1,81 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __TRAFFICDISTRIBUTION_HH__
+#define __TRAFFICDISTRIBUTION_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "InputFiles.hh"
+
+namespace AstraSim {
+/**
+ * Expert load of every layer of a Mixture-of-Experts model, which sets the
+ * data each NPU sends in a non-uniform All-to-All.
+ *
+ * Row r of the distribution file is the load of each expert in layer r,
+ * e.g., "[8194, 8702, 8114, 7814, 8598, 10094, 4426, 9593]". NPU i holds
+ * expert (i % experts_count), and sends
+ * load(r, i) * data_size / uniform_load bytes, where uniform_load is the
+ * load of an expert under a uniform split of the tokens
+ * (tokens_count / experts_count, 8192 for 8 experts).
+ *
+ * A file is parsed once per InputFiles: every NPU, collective and run of a
+ * sweep shares the same read-only table.
+ */
+class TrafficDistribution {
+ public:
+  /**
+   * tokens routed in each layer
+   */
+  static const uint64_t tokens_count = 65536;
+
+  /**
+   * Get the table of a distribution file, parsing it on first use.
+   * Exits if the file cannot be read, experts_count is not in
+   * [1, tokens_count], a row has fewer than experts_count values, or a blank
+   * line precedes a row (rows are indexed by line).
+   * @param input_files parsed files of the simulation
+   * @param path distribution file
+   * @param experts_count number of experts (values used in each row)
+   * @return shared table
+   */
+  static std::shared_ptr<const TrafficDistribution> load(
+      InputFiles& input_files,
+      const std::string& path,
+      int experts_count);
+
+  /**
+   * @param row layer (row of the file)
+   * @param rank NPU id
+   * @return load of the expert of rank in row
+   */
+  uint64_t get_load(int row, int rank) const {
+    return loads[row * experts_count + rank % experts_count];
+  }
+
+  /**
+   * @return bytes rank sends in row when a uniform split sends data_size
+   */
+  uint64_t scale(uint64_t data_size, int row, int rank) const {
+    return get_load(row, rank) * data_size / uniform_load;
+  }
+
+  int get_rows_count() const;
+  int get_experts_count() const;
+
+ private:
+  TrafficDistribution(const std::string& path, int experts_count);
+
+  int experts_count;
+  int rows_count;
+  uint64_t uniform_load; // load of an expert under a uniform split
+  std::vector<uint64_t> loads; // row-major, experts_count values per row
+};
+} // namespace AstraSim
+
+#endif
@@ -0,0 +1,323 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "TrafficMatrix.hh"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace AstraSim {
+namespace {
+const char binary_magic[] = "A2AVBIN1";
+
+template <typename T>
+bool read_binary(std::istream& infile, T& value) {
+  // little-endian file, little-endian host
+  infile.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return (bool)infile;
+}
+} // namespace
+
+std::shared_ptr<const TrafficMatrix> TrafficMatrix::load(
+    InputFiles& input_files,
+    const std::string& path) {
+  return input_files.traffic_matrices.get(path, [&]() {
+    return std::shared_ptr<const TrafficMatrix>(new TrafficMatrix(path));
+  });
+}
+
+TrafficMatrix::TrafficMatrix(const std::string& path) : npus_count(0) {
+  std::ifstream infile(path, std::ios::binary);
+  if (!infile.is_open()) {
+    std::cerr << "Unable to open traffic matrix file: " << path << std::endl;
+    exit(1);
+  }
+
+  char magic[sizeof(binary_magic) - 1];
+  infile.read(magic, sizeof(magic));
+  if (infile && std::memcmp(magic, binary_magic, sizeof(magic)) == 0) {
+    parse_binary(path, infile);
+  } else {
+    infile.clear();
+    infile.seekg(0);
+    parse_text(path, infile);
+  }
+}
+
+void TrafficMatrix::parse_text(
+    const std::string& path,
+    std::istream& infile) {
+  auto malformed = [&path](int line_number, const std::string& line) {
+    std::cerr << "Traffic matrix file " << path << ", line " << line_number
+              << ": cannot parse \"" << line << "\"" << std::endl;
+    exit(1);
+  };
+
+  std::string line;
+  int line_number = 0;
+  int layer = -1;
+  while (std::getline(infile, line)) {
+    line_number++;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    std::stringstream ss(line);
+    std::string first;
+    if (!(ss >> first) || first[0] == '#') {
+      continue;
+    }
+    if (first == "npus:") {
+      if (!(ss >> npus_count) || npus_count <= 0) {
+        malformed(line_number, line);
+      }
+    } else if (first == "layer:") {
+      if (!(ss >> layer) || layer < 0) {
+        malformed(line_number, line);
+      }
+      entries_per_layer[layer];
+      total_bytes_per_layer[layer];
+    } else {
+      Entry entry;
+      std::stringstream entry_ss(line);
+      if (!(entry_ss >> entry.src >> entry.dst >> entry.bytes)) {
+        malformed(line_number, line);
+      }
+      if (npus_count == 0 || layer == -1) {
+        std::cerr << "Traffic matrix file " << path << ", line "
+                  << line_number << ": \"npus:\" and \"layer:\" must come "
+                  << "before the entries" << std::endl;
+        exit(1);
+      }
+      add_entry(path, layer, entry);
+    }
+  }
+  if (npus_count == 0) {
+    std::cerr << "Traffic matrix file " << path << ": \"npus:\" is missing"
+              << std::endl;
+    exit(1);
+  }
+}
+
+void TrafficMatrix::parse_binary(
+    const std::string& path,
+    std::istream& infile) {
+  auto truncated = [&path]() {
+    std::cerr << "Traffic matrix file " << path << " is truncated"
+              << std::endl;
+    exit(1);
+  };
+
+  uint32_t npus, layers_count;
+  if (!read_binary(infile, npus) || !read_binary(infile, layers_count)) {
+    truncated();
+  }
+  npus_count = npus;
+  for (uint32_t i = 0; i < layers_count; i++) {
+    uint32_t layer;
+    uint64_t entries_count;
+    if (!read_binary(infile, layer) || !read_binary(infile, entries_count)) {
+      truncated();
+    }
+    entries_per_layer[layer];
+    total_bytes_per_layer[layer];
+    for (uint64_t j = 0; j < entries_count; j++) {
+      uint32_t src, dst;
+      uint64_t bytes;
+      if (!read_binary(infile, src) || !read_binary(infile, dst) ||
+          !read_binary(infile, bytes)) {
+        truncated();
+      }
+      add_entry(path, layer, Entry{(int)src, (int)dst, bytes});
+    }
+  }
+}
+
+void TrafficMatrix::add_entry(
+    const std::string& path,
+    int layer,
+    const Entry& entry) {
+  if (entry.src < 0 || entry.src >= npus_count || entry.dst < 0 ||
+      entry.dst >= npus_count) {
+    std::cerr << "Traffic matrix file " << path << ", layer " << layer
+              << ": NPU pair (" << entry.src << ", " << entry.dst
+              << ") out of bounds of " << npus_count << " NPUs" << std::endl;
+    exit(1);
+  }
+  entries_per_layer[layer].push_back(entry);
+  total_bytes_per_layer[layer] += entry.bytes;
+}
+
+int TrafficMatrix::get_npus_count() const {
+  return npus_count;
+}
+
+bool TrafficMatrix::has_layer(int layer) const {
+  return entries_per_layer.find(layer) != entries_per_layer.end();
+}
+
+uint64_t TrafficMatrix::get_mean_send_size(int layer) const {
+  return total_bytes_per_layer.at(layer) / npus_count;
+}
+
+const std::vector<std::vector<double>>& TrafficMatrix::
+    get_stage_message_scales(
+        int layer,
+        const std::vector<int>& units_counts,
+        const std::vector<bool>& dimensions_done,
+        int dimension,
+        bool failed,
+        int messages_count) const {
+  std::lock_guard<std::mutex> lock(stage_scales_mutex);
+  auto key = std::make_tuple(
+      layer, units_counts, dimensions_done, dimension, failed, messages_count);
+  auto cached = stage_scales.find(key);
+  if (cached != stage_scales.end()) {
+    return cached->second;
+  }
+
+  auto dimensions_count = (int)units_counts.size();
+  std::vector<int> strides(dimensions_count);
+  auto stride = 1;
+  for (auto dim = 0; dim < dimensions_count; dim++) {
+    strides[dim] = stride;
+    stride *= units_counts[dim];
+  }
+  auto units_count = units_counts[dimension];
+  auto dim_stride = strides[dimension];
+
+  // bytes on the outgoing links of each NPU
+  LinkLoads loads(npus_count);
+  for (const auto& entry : entries_per_layer.at(layer)) {
+    auto src_pos = (entry.src / dim_stride) % units_count;
+    auto dst_pos = (entry.dst / dim_stride) % units_count;
+    if (src_pos == dst_pos || entry.bytes == 0) {
+      continue;
+    }
+    // NPU holding the data: dst's coordinates in the dimensions done
+    auto holder = 0;
+    for (auto dim = 0; dim < dimensions_count; dim++) {
+      auto npu = dimensions_done[dim] ? entry.dst : entry.src;
+      holder += ((npu / strides[dim]) % units_counts[dim]) * strides[dim];
+    }
+    auto ring_base = holder - src_pos * dim_stride;
+    route_on_ring(
+        loads,
+        ring_base,
+        dim_stride,
+        units_count,
+        src_pos,
+        dst_pos,
+        (double)entry.bytes,
+        failed);
+  }
+
+  // uniform All-to-All of the same total: every ordered pair of a ring
+  // exchanges mean_send_size / units_count bytes in the stage
+  LinkLoads uniform_loads(units_count);
+  auto pair_bytes = (double)get_mean_send_size(layer) / units_count;
+  for (auto src_pos = 0; src_pos < units_count; src_pos++) {
+    for (auto dst_pos = 0; dst_pos < units_count; dst_pos++) {
+      if (src_pos != dst_pos) {
+        route_on_ring(
+            uniform_loads,
+            0,
+            1,
+            units_count,
+            src_pos,
+            dst_pos,
+            pair_bytes,
+            failed);
+      }
+    }
+  }
+
+  auto& scales = stage_scales[key];
+  scales.resize(npus_count);
+  for (auto npu = 0; npu < npus_count; npu++) {
+    const auto& uniform_load = uniform_loads[(npu / dim_stride) % units_count];
+    auto total_uniform = 0.0;
+    for (const auto& hop : uniform_load) {
+      total_uniform += hop.second;
+    }
+    auto& npu_scales = scales[npu];
+    npu_scales.resize(messages_count, 0);
+    if (total_uniform == 0) {
+      continue;
+    }
+
+    // each message carries the next total_uniform / messages_count bytes of
+    // uniform traffic, hops are spread evenly over the messages they overlap
+    auto message_uniform = total_uniform / messages_count;
+    std::vector<double> actual(messages_count, 0);
+    std::vector<double> uniform(messages_count, 0);
+    auto begin = 0.0;
+    for (const auto& hop : uniform_load) {
+      auto end = begin + hop.second;
+      auto found = loads[npu].find(hop.first);
+      auto density =
+          found == loads[npu].end() ? 0.0 : found->second / hop.second;
+      auto message = std::min((int)(begin / message_uniform), messages_count - 1);
+      for (; message < messages_count; message++) {
+        auto message_begin = message * message_uniform;
+        auto message_end = message == messages_count - 1
+            ? end
+            : std::min(end, message_begin + message_uniform);
+        auto overlap = message_end - std::max(begin, message_begin);
+        if (overlap > 0) {
+          actual[message] += density * overlap;
+          uniform[message] += overlap;
+        }
+        if (message_end >= end) {
+          break;
+        }
+      }
+      begin = end;
+    }
+    for (auto message = 0; message < messages_count; message++) {
+      if (uniform[message] > 0) {
+        npu_scales[message] = actual[message] / uniform[message];
+      }
+    }
+  }
+  return scales;
+}
+
+void TrafficMatrix::route_on_ring(
+    LinkLoads& loads,
+    int ring_base,
+    int stride,
+    int units_count,
+    int src_pos,
+    int dst_pos,
+    double bytes,
+    bool failed) {
+  auto hop = [&](int pos, int step, int hops, double hop_bytes) {
+    for (auto i = 0; i < hops; i++) {
+      loads[ring_base + pos * stride][RouteHop(i, step, hops)] += hop_bytes;
+      pos = (pos + step + units_count) % units_count;
+    }
+  };
+
+  if (failed) {
+    // line from position 0 to units_count - 1
+    if (dst_pos > src_pos) {
+      hop(src_pos, 1, dst_pos - src_pos, bytes);
+    } else {
+      hop(src_pos, -1, src_pos - dst_pos, bytes);
+    }
+    return;
+  }
+  auto clockwise_hops = (dst_pos - src_pos + units_count) % units_count;
+  auto anticlockwise_hops = units_count - clockwise_hops;
+  if (clockwise_hops < anticlockwise_hops) {
+    hop(src_pos, 1, clockwise_hops, bytes);
+  } else if (clockwise_hops > anticlockwise_hops) {
+    hop(src_pos, -1, anticlockwise_hops, bytes);
+  } else {
+    hop(src_pos, 1, clockwise_hops, bytes / 2);
+    hop(src_pos, -1, anticlockwise_hops, bytes / 2);
+  }
+}
+} // namespace AstraSim
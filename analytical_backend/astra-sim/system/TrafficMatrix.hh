@@ -0,0 +1,144 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __TRAFFICMATRIX_HH__
+#define __TRAFFICMATRIX_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "InputFiles.hh"
+
+namespace AstraSim {
+/**
+ * Per-pair traffic of the All-to-Allv (ALLTOALLV) collectives of a workload:
+ * for each workload layer, the bytes every NPU sends to every other NPU.
+ *
+ * Text file (pairs not listed send nothing, lines starting with # are
+ * skipped):
+ *   npus: 64
+ *   layer: 0
+ *   0 1 4096
+ *   0 9 512
+ *   ...
+ * Binary file: "A2AVBIN1", uint32 npus, uint32 layers, then for each layer
+ * uint32 layer, uint64 entries, and entries of (uint32 src, uint32 dst,
+ * uint64 bytes), little-endian.
+ *
+ * HalfRing runs an All-to-All in one stage per dimension, moving data from
+ * the source's to the destination's coordinate along that dimension, as a
+ * sequence of equal messages to the next NPU of the ring. For All-to-Allv,
+ * each of these messages is scaled by the bytes the matrix routes through
+ * the NPU's outgoing link in the share of the uniform sequence it stands for
+ * (see get_stage_message_scales), so the peers of every NPU keep their own
+ * sizes within the stage.
+ *
+ * A file is parsed once per InputFiles and shared by every NPU and run.
+ */
+class TrafficMatrix {
+ public:
+  /**
+   * Get the matrix of a file, parsing it on first use.
+   * Exits if the file cannot be read or is malformed.
+   * @param input_files parsed files of the simulation
+   * @param path traffic matrix file (text or binary)
+   * @return shared matrix
+   */
+  static std::shared_ptr<const TrafficMatrix> load(
+      InputFiles& input_files,
+      const std::string& path);
+
+  int get_npus_count() const;
+  bool has_layer(int layer) const;
+
+  /**
+   * @return bytes an NPU sends on average in layer (total bytes / NPUs),
+   * the data size of the equivalent uniform All-to-All
+   */
+  uint64_t get_mean_send_size(int layer) const;
+
+  /**
+   * Scale of each message of every NPU in one stage of a dimension-ordered
+   * All-to-Allv, against the messages of the uniform All-to-All with the
+   * same total (every scale is 1 for a uniform matrix).
+   *
+   * Before the stage, the data of (src, dst) sits at the NPU with dst's
+   * coordinates in the dimensions already done and src's elsewhere. Rings
+   * route each message the shortest way around (half each way on a tie),
+   * and rings with a failed link route along the line between its last and
+   * first NPU.
+   *
+   * The traffic crossing the outgoing link of an NPU is ordered by the hops
+   * it already made, then by direction and distance, i.e. the order of a
+   * store-and-forward ring, and split into messages_count messages of equal
+   * uniform traffic. A message's scale is its actual over its uniform
+   * traffic, so the scales of an NPU add up to its total load.
+   * @param layer workload layer
+   * @param units_counts NPUs count of each dimension
+   * @param dimensions_done dimensions whose stage already ran
+   * @param dimension dimension of the stage
+   * @param failed whether the rings of dimension have a failed link
+   * @param messages_count messages every NPU sends in the stage
+   * @return messages_count scales for each NPU, valid as long as the matrix
+   */
+  const std::vector<std::vector<double>>& get_stage_message_scales(
+      int layer,
+      const std::vector<int>& units_counts,
+      const std::vector<bool>& dimensions_done,
+      int dimension,
+      bool failed,
+      int messages_count) const;
+
+ private:
+  struct Entry {
+    int src;
+    int dst;
+    uint64_t bytes;
+  };
+
+  explicit TrafficMatrix(const std::string& path);
+  void parse_text(const std::string& path, std::istream& infile);
+  void parse_binary(const std::string& path, std::istream& infile);
+  void add_entry(const std::string& path, int layer, const Entry& entry);
+
+  /**
+   * Part of a ring route crossing the outgoing link of an NPU: hops already
+   * made, direction (1 clockwise, -1 anticlockwise) and route length
+   */
+  using RouteHop = std::tuple<int, int, int>;
+  using LinkLoads = std::vector<std::map<RouteHop, double>>;
+
+  /**
+   * Add bytes to the outgoing links of every NPU on the route from position
+   * src_pos to dst_pos of a ring.
+   */
+  static void route_on_ring(
+      LinkLoads& loads,
+      int ring_base,
+      int stride,
+      int units_count,
+      int src_pos,
+      int dst_pos,
+      double bytes,
+      bool failed);
+
+  int npus_count;
+  std::map<int, std::vector<Entry>> entries_per_layer;
+  std::map<int, uint64_t> total_bytes_per_layer;
+
+  // message scales computed so far
+  using StageKey =
+      std::tuple<int, std::vector<int>, std::vector<bool>, int, bool, int>;
+  mutable std::mutex stage_scales_mutex;
+  mutable std::map<StageKey, std::vector<std::vector<double>>> stage_scales;
+};
+} // namespace AstraSim
+
+#endif
@@ -22,9 +22,11 @@ HalfRing::HalfRing(
     int num_dimensions,
     int chunk_stage,
     int nodes_num_of_failed_ring,
-    std::vector<int> physical_dims,
+    const std::vector<int>& physical_dims,
     int failure_type,
-    int non_uniform_flag) 
+    int non_uniform_flag,
+    const TrafficDistribution* moe_distribution,
+    const CollectivePlan::Phase::HalfRingMessages* messages)
     : Algorithm(layer_num) {
   // std::cout<<"Ring checkmark 0"<<std::endl;
   this->comType = type;
@@ -54,11 +56,14 @@ HalfRing::HalfRing(
   this->num_dimensions = num_dimensions;
   this->max_physical_dim_value = 0;
   this->non_uniform_flag = non_uniform_flag; 
+  this->moe_distribution = moe_distribution;
+  this->message_scales = messages ? messages->message_scales : nullptr;
 
   // Galois change: enable the non-uniform All-to-All
-  if (non_uniform_flag != 0) {
-    // Galois note: it's hard-coded
-    data_size = GetMoEDistributionValue("../../inputs/workload/Non-Uniform-MoE/MoE_Distribution.txt", non_uniform_flag-1, (id % 8)) * data_size / 8192; // Galois change: get the MoE distribution value from external txt file
+  // (only sizes the messages, which are given when planned, see CollectivePlan)
+  if (messages == nullptr) {
+    data_size = get_scaled_data_size(
+        data_size, id, non_uniform_flag, moe_distribution);
   }
   assert(!physical_dims.empty()); 
   this->max_physical_dim_value = *std::max_element(physical_dims.begin(), physical_dims.end()); 
@@ -75,68 +80,19 @@ HalfRing::HalfRing(
 
   assert (type == ComType::All_to_All); // HalfRing is only for All-to-All collective
 
-  if (link_failure_in_this_dimension == 0){
-    // Half Ring Algorithm without any failure
-    if (nodes_in_ring == 2){
-        this->stream_count = 1 * 2;
-    } else {
-        if (nodes_in_ring % 2 == 0) {
-          this->stream_count = ceil(nodes_in_ring * nodes_in_ring * 2 / 8);  
-        } else {
-          this->stream_count = (nodes_in_ring * nodes_in_ring - 1) * 2 / 8;
-        }
-    }
-  } else if (link_failure_in_this_dimension == 1) {
-    // Fault Tolerance Baseline Algorithm FoldedRing
-    if (nodes_in_ring == 2) {
-        std::cout << "Link failure happens in a 2-node ring!" << std::endl;
-        assert (nodes_in_ring != 2); 
-    } else {
-        this->stream_count = (nodes_in_ring - 1) * nodes_in_ring / 2; 
-    }
+  if (messages != nullptr) {
+    this->stream_count = messages->stream_count;
   } else {
-    std::cout << "Too many link failures in this ring!" << std::endl;
-    assert (link_failure_in_this_dimension == 1); 
+    this->stream_count = get_stream_count(
+        nodes_in_ring,
+        link_failure_in_this_dimension,
+        link_failure_scheduling,
+        chunk_stage,
+        nodes_num_of_failed_ring,
+        max_physical_dim_value,
+        failure_type);
   }
-  
-  if ((link_failure_scheduling == LinkFailureScheduling::Mate || 
-       link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced) &&
-      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) {
-    if (nodes_num_of_failed_ring % 2 == 0) {
-      this->stream_count = ceil(static_cast<double>(nodes_num_of_failed_ring * nodes_num_of_failed_ring) / 8 * 2);  
-    } else {
-      this->stream_count = (nodes_num_of_failed_ring * nodes_num_of_failed_ring - 1) / 8 * 2;
-    } 
-  } 
-  if (link_failure_scheduling == LinkFailureScheduling::Mate &&
-      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4)))) {
-    if (nodes_num_of_failed_ring == 2){
-        this->stream_count = 1 * 2;
-    } else {
-        if (nodes_num_of_failed_ring % 2 == 0) {
-        this->stream_count = ceil(static_cast<double>(max_physical_dim_value * max_physical_dim_value) / 8 * 2); 
-        } else {
-        this->stream_count = (max_physical_dim_value * max_physical_dim_value - 1) / 8 * 2;
-        }
-    } 
-  } 
-  if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
-      link_failure_in_this_dimension == 0) {
-    if (nodes_num_of_failed_ring == 2){
-        this->stream_count = 1 * 2;
-    } else {
-        if (nodes_num_of_failed_ring % 2 == 0) {
-        this->stream_count = ceil(static_cast<double>(max_physical_dim_value * max_physical_dim_value) / 8 * 2); 
-        } else {
-        this->stream_count = (max_physical_dim_value * max_physical_dim_value - 1) / 8 * 2;
-        }
-    } 
-  } 
-  
+
   this->total_stream_count = this->stream_count; 
   switch (injection_policy) {
   case InjectionPolicy::Aggressive:
@@ -174,49 +130,20 @@ HalfRing::HalfRing(
       break;
     case ComType::All_to_All:
       this->final_data_size = data_size;
-      this->msg_size = data_size / nodes_in_ring;
-      // for MATE, there are (N-1) halfring and 1 FORD ring in acceleration period
-      if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-          ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-           (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) { // TODO: a better implementation is to make sure every former chunk is finished and then start this multi-dimension accelerated stream
-        if (nodes_in_ring % 2 == 0) {
-          this->msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
-                                static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value) / (4 * (nodes_num_of_failed_ring - 1)))) *
-                               (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring + 1) / (4.0 * nodes_num_of_failed_ring)));
-        } else {
-          this->msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) * static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value + 1) / (4 * nodes_num_of_failed_ring))) * (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring) / (4.0 * (nodes_num_of_failed_ring - 1))));
-        }
-      } else if (link_failure_scheduling == LinkFailureScheduling::Mate &&
-                 ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-                  (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) {
-        if (nodes_in_ring % 2 == 0) {
-          this->msg_size = ceil(static_cast<double>(data_size) / nodes_num_of_failed_ring) * 
-                               (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring + 1) / (4.0 * nodes_num_of_failed_ring)));
-        } else {
-          this->msg_size = ceil(static_cast<double>(data_size) / nodes_num_of_failed_ring) *
-                               (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring) / (4.0 * (nodes_num_of_failed_ring - 1))));
-        }
-      } else if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-                 ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-                  (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
-                 link_failure_in_this_dimension == 1) {
-        if (nodes_in_ring % 2 == 0) {
-          this->msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
-                                (static_cast<double>(max_physical_dim_value) / (4.0 * (nodes_num_of_failed_ring - 1))));
-        } else {
-          this->msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
-                                (static_cast<double>(max_physical_dim_value + 1) / (4.0 * nodes_num_of_failed_ring)));
-        }
-      } else if (link_failure_scheduling == LinkFailureScheduling::Mate &&
-                 ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-                  (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4)))) {
-        this->msg_size = data_size / max_physical_dim_value;
-      } else if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-                 ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-                  (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
-                 link_failure_in_this_dimension == 0) {
-        this->msg_size = data_size / max_physical_dim_value;
+      if (messages != nullptr) {
+        this->msg_size = messages->msg_size;
+        break;
       }
+      this->msg_size = get_msg_size(
+          data_size,
+          nodes_in_ring,
+          link_failure_in_this_dimension,
+          link_failure_scheduling,
+          num_dimensions,
+          chunk_stage,
+          nodes_num_of_failed_ring,
+          max_physical_dim_value,
+          failure_type);
       break;
     default:;
   }
@@ -400,7 +327,7 @@ bool HalfRing::ready() {
   stream->owner->front_end_sim_send(
     0,
     Sys::dummy_data,
-    msg_size,
+    get_message_size(id),
     UINT8,
     packet.preferred_dest,
     stream->stream_num,
@@ -418,7 +345,9 @@ bool HalfRing::ready() {
       packet.stream_num);
 
   uint64_t recv_size;
-  if (this->non_uniform_flag!= 0) {
+  if (this->message_scales != nullptr) {
+    recv_size = get_message_size(packet.preferred_src);
+  } else if (this->non_uniform_flag != 0) {
     recv_size = Get_Recv_Size(packet.preferred_src);
   } else {
     recv_size = msg_size; // for uniform All-to-All
@@ -451,98 +380,168 @@ void HalfRing::exit() {
   return;
 }
 
-uint64_t HalfRing::GetMoEDistributionValue(const std::string& filepath, int line_idx, int col_idx) {
-  std::ifstream infile(filepath);
-  if (!infile.is_open()) {
-      std::cerr << "Failed to open file: " << filepath << std::endl;
-      perror("System error reason");
-      throw std::runtime_error("Failed to open file: " + filepath);
-  }
-
-  std::string line;
-  int current_line = 0;
-
-  while (std::getline(infile, line)) {
-      if (current_line == line_idx) {
-          // remove the [] in the line
-          if (!line.empty() && line.front() == '[') line.erase(0, 1);
-          if (!line.empty() && line.back() == ']') line.pop_back();
-
-          std::stringstream ss(line);
-          std::string number_str;
-          int current_col = 0;
+uint64_t HalfRing::Get_Recv_Size(int preferred_src) {
+  uint64_t src_data_size = get_scaled_data_size(
+      orig_data_size, preferred_src, non_uniform_flag, moe_distribution);
+  uint64_t new_msg_size = get_msg_size(
+      src_data_size,
+      nodes_in_ring,
+      local_link_failure_in_this_dimension,
+      local_link_failure_scheduling,
+      num_dimensions,
+      local_chunk_stage,
+      local_nodes_num_of_failed_ring,
+      max_physical_dim_value,
+      local_failure_type);
+  return new_msg_size;
+}
 
-          while (std::getline(ss, number_str, ',')) {
-              if (current_col == col_idx) {
-                  try {
-                      return std::stoull(number_str);  
-                  } catch (const std::exception& e) {
-                      std::cerr << "Failed to parse number: " << number_str << " at (" << line_idx << "," << col_idx << "): " << e.what() << std::endl;
-                      throw;
-                  }
-              }
-              ++current_col;
-          }
-          throw std::out_of_range("Column index out of range in line " + std::to_string(line_idx));
-      }
-      ++current_line;
+uint64_t HalfRing::get_message_size(int npu) {
+  if (message_scales == nullptr) {
+    return msg_size;
   }
-  throw std::out_of_range("Line index out of range: " + std::to_string(line_idx));
+  // All-to-Allv: the next message of npu, which sends as many as this node
+  int message = total_stream_count - stream_count;
+  return llround(msg_size * (*message_scales)[npu][message]);
 }
 
-uint64_t HalfRing::Get_Recv_Size(int preferred_src) {
-  // Galois note: it's hard-coded
-  uint64_t dist_val = GetMoEDistributionValue("../../inputs/workload/Non-Uniform-MoE/MoE_Distribution.txt", non_uniform_flag-1, (preferred_src % 8));
-  uint64_t src_data_size = dist_val * orig_data_size / 8192;
-  uint64_t new_msg_size;
-  new_msg_size = src_data_size / nodes_in_ring;
+uint64_t HalfRing::get_scaled_data_size(
+    uint64_t data_size,
+    int id,
+    int non_uniform_flag,
+    const TrafficDistribution* moe_distribution) {
+  if (non_uniform_flag != 0) {
+    return moe_distribution->scale(data_size, non_uniform_flag - 1, id);
+  }
+  return data_size;
+}
+int HalfRing::get_stream_count(
+    int nodes_in_ring,
+    int link_failure_in_this_dimension,
+    LinkFailureScheduling link_failure_scheduling,
+    int chunk_stage,
+    int nodes_num_of_failed_ring,
+    int max_physical_dim_value,
+    int failure_type) {
+  int stream_count = 0;
+  if (link_failure_in_this_dimension == 0){
+    // Half Ring Algorithm without any failure
+    if (nodes_in_ring == 2){
+        stream_count = 1 * 2;
+    } else {
+        if (nodes_in_ring % 2 == 0) {
+          stream_count = ceil(nodes_in_ring * nodes_in_ring * 2 / 8);  
+        } else {
+          stream_count = (nodes_in_ring * nodes_in_ring - 1) * 2 / 8;
+        }
+    }
+  } else if (link_failure_in_this_dimension == 1) {
+    // Fault Tolerance Baseline Algorithm FoldedRing
+    if (nodes_in_ring == 2) {
+        std::cout << "Link failure happens in a 2-node ring!" << std::endl;
+        assert (nodes_in_ring != 2); 
+    } else {
+        stream_count = (nodes_in_ring - 1) * nodes_in_ring / 2; 
+    }
+  } else {
+    std::cout << "Too many link failures in this ring!" << std::endl;
+    assert (link_failure_in_this_dimension == 1); 
+  }
+  
+  if ((link_failure_scheduling == LinkFailureScheduling::Mate || 
+       link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced) &&
+      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) {
+    if (nodes_num_of_failed_ring % 2 == 0) {
+      stream_count = ceil(static_cast<double>(nodes_num_of_failed_ring * nodes_num_of_failed_ring) / 8 * 2);  
+    } else {
+      stream_count = (nodes_num_of_failed_ring * nodes_num_of_failed_ring - 1) / 8 * 2;
+    } 
+  } 
+  if (link_failure_scheduling == LinkFailureScheduling::Mate &&
+      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4)))) {
+    if (nodes_num_of_failed_ring == 2){
+        stream_count = 1 * 2;
+    } else {
+        if (nodes_num_of_failed_ring % 2 == 0) {
+        stream_count = ceil(static_cast<double>(max_physical_dim_value * max_physical_dim_value) / 8 * 2); 
+        } else {
+        stream_count = (max_physical_dim_value * max_physical_dim_value - 1) / 8 * 2;
+        }
+    } 
+  } 
+  if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
+      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
+      link_failure_in_this_dimension == 0) {
+    if (nodes_num_of_failed_ring == 2){
+        stream_count = 1 * 2;
+    } else {
+        if (nodes_num_of_failed_ring % 2 == 0) {
+        stream_count = ceil(static_cast<double>(max_physical_dim_value * max_physical_dim_value) / 8 * 2); 
+        } else {
+        stream_count = (max_physical_dim_value * max_physical_dim_value - 1) / 8 * 2;
+        }
+    } 
+  }
+  return stream_count;
+}
 
-  if (local_link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-      ((local_chunk_stage % 2 == 1 && local_failure_type != 1 && local_failure_type != 4) ||
-       (local_chunk_stage % 3 != 0 && (local_failure_type == 1 || local_failure_type == 4)))) { // TODO: a better implementation is to make sure every former chunk is finished and then start this multi-dimension accelerated stream
+uint64_t HalfRing::get_msg_size(
+    uint64_t data_size,
+    int nodes_in_ring,
+    int link_failure_in_this_dimension,
+    LinkFailureScheduling link_failure_scheduling,
+    int num_dimensions,
+    int chunk_stage,
+    int nodes_num_of_failed_ring,
+    int max_physical_dim_value,
+    int failure_type) {
+  uint64_t msg_size = data_size / nodes_in_ring;
+  // for MATE, there are (N-1) halfring and 1 FORD ring in acceleration period
+  if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
+      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) { // TODO: a better implementation is to make sure every former chunk is finished and then start this multi-dimension accelerated stream
     if (nodes_in_ring % 2 == 0) {
-      // even
-      new_msg_size = ceil((static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                          static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value) / (4 * (local_nodes_num_of_failed_ring - 1)))) *
-                         (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(local_nodes_num_of_failed_ring + 1) / (4.0 * local_nodes_num_of_failed_ring)));
+      msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
+                            static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value) / (4 * (nodes_num_of_failed_ring - 1)))) *
+                           (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring + 1) / (4.0 * nodes_num_of_failed_ring)));
     } else {
-      // odd
-      new_msg_size = ceil((static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                          static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value + 1) / (4 * local_nodes_num_of_failed_ring))) *
-                         (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(local_nodes_num_of_failed_ring) / (4.0 * (local_nodes_num_of_failed_ring - 1))));
+      msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) * static_cast<double>(1.0 - static_cast<double>(max_physical_dim_value + 1) / (4 * nodes_num_of_failed_ring))) * (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring) / (4.0 * (nodes_num_of_failed_ring - 1))));
     }
-  } else if (local_link_failure_scheduling == LinkFailureScheduling::Mate &&
-             ((local_chunk_stage % 2 == 1 && local_failure_type != 1 && local_failure_type != 4) ||
-              (local_chunk_stage % 3 != 0 && (local_failure_type == 1 || local_failure_type == 4)))) {
+  } else if (link_failure_scheduling == LinkFailureScheduling::Mate &&
+             ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
+              (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) {
     if (nodes_in_ring % 2 == 0) {
-      new_msg_size = ceil(static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                         (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(local_nodes_num_of_failed_ring + 1) / (4.0 * local_nodes_num_of_failed_ring)));
+      msg_size = ceil(static_cast<double>(data_size) / nodes_num_of_failed_ring) * 
+                           (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring + 1) / (4.0 * nodes_num_of_failed_ring)));
     } else {
-      new_msg_size = ceil(static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                         (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(local_nodes_num_of_failed_ring) / (4.0 * (local_nodes_num_of_failed_ring - 1))));
+      msg_size = ceil(static_cast<double>(data_size) / nodes_num_of_failed_ring) *
+                           (1.0 / (static_cast<double>(num_dimensions - 1) + static_cast<double>(nodes_num_of_failed_ring) / (4.0 * (nodes_num_of_failed_ring - 1))));
     }
-  } else if (local_link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-             ((local_chunk_stage % 2 == 0 && local_failure_type != 1 && local_failure_type != 4) ||
-              (local_chunk_stage % 3 == 0 && (local_failure_type == 1 || local_failure_type == 4))) &&
-             local_link_failure_in_this_dimension == 1) {
+  } else if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
+             ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+              (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
+             link_failure_in_this_dimension == 1) {
     if (nodes_in_ring % 2 == 0) {
-      new_msg_size = ceil((static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                          (static_cast<double>(max_physical_dim_value) / (4.0 * (local_nodes_num_of_failed_ring - 1))));
+      msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
+                            (static_cast<double>(max_physical_dim_value) / (4.0 * (nodes_num_of_failed_ring - 1))));
     } else {
-      new_msg_size = ceil((static_cast<double>(src_data_size) / local_nodes_num_of_failed_ring) *
-                          (static_cast<double>(max_physical_dim_value + 1) / (4.0 * local_nodes_num_of_failed_ring)));
+      msg_size = ceil((static_cast<double>(data_size) / nodes_num_of_failed_ring) *
+                            (static_cast<double>(max_physical_dim_value + 1) / (4.0 * nodes_num_of_failed_ring)));
     }
-  } else if (local_link_failure_scheduling == LinkFailureScheduling::Mate &&
-             ((local_chunk_stage % 2 == 0 && local_failure_type != 1 && local_failure_type != 4) ||
-              (local_chunk_stage % 3 == 0 && (local_failure_type == 1 || local_failure_type == 4)))) {
-    new_msg_size = src_data_size / max_physical_dim_value;
-  } else if (local_link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
-             ((local_chunk_stage % 2 == 0 && local_failure_type != 1 && local_failure_type != 4) ||
-              (local_chunk_stage % 3 == 0 && (local_failure_type == 1 || local_failure_type == 4))) &&
-             local_link_failure_in_this_dimension == 0) {
-    new_msg_size = src_data_size / max_physical_dim_value;
+  } else if (link_failure_scheduling == LinkFailureScheduling::Mate &&
+             ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+              (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4)))) {
+    msg_size = data_size / max_physical_dim_value;
+  } else if (link_failure_scheduling == LinkFailureScheduling::Mate_Enhanced &&
+             ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+              (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
+             link_failure_in_this_dimension == 0) {
+    msg_size = data_size / max_physical_dim_value;
   }
-  return new_msg_size;
+  return msg_size;
 }
 
 } // namespace AstraSim
\ No newline at end of file
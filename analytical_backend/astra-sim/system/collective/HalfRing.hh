@@ -23,9 +23,11 @@
 #include <stdexcept>
 #include <iostream>
 #include "Algorithm.hh"
+#include "astra-sim/system/CollectivePlan.hh"
 #include "astra-sim/system/Common.hh"
 #include "astra-sim/system/MemBus.hh"
 #include "astra-sim/system/MyPacket.hh"
+#include "astra-sim/system/TrafficDistribution.hh"
 #include "astra-sim/system/topology/RingTopology.hh"
 
 namespace AstraSim {
@@ -64,6 +66,9 @@ class HalfRing : public Algorithm {
   int num_dimensions;
   int max_physical_dim_value;
   int non_uniform_flag;
+  const TrafficDistribution* moe_distribution;
+  // All-to-Allv scale of each message of each NPU, else nullptr
+  const std::vector<std::vector<double>>* message_scales;
   uint64_t orig_data_size;
   LinkFailureScheduling local_link_failure_scheduling;
   int local_nodes_num_of_failed_ring;
@@ -82,9 +87,11 @@ class HalfRing : public Algorithm {
       int num_dimensions,
       int chunk_stage,
       int nodes_num_of_failed_ring,
-      std::vector<int> physical_dims,
+      const std::vector<int>& physical_dims,
       int failure_type,
-      int non_uniform_flag);
+      int non_uniform_flag,
+      const TrafficDistribution* moe_distribution,
+      const CollectivePlan::Phase::HalfRingMessages* messages = nullptr);
   virtual void run(EventType event, CallData* data);
   void process_stream_count();
   // void call(EventType event,CallData *data);
@@ -95,9 +102,38 @@ class HalfRing : public Algorithm {
   virtual int get_non_zero_latency_packets();
   void insert_packet(Callable* sender);
   bool ready();
-  uint64_t GetMoEDistributionValue(const std::string& filepath, int line_idx, int col_idx);
   uint64_t Get_Recv_Size(int preferred_src);
+  // size of the next message npu sends (this node or the sender)
+  uint64_t get_message_size(int npu);
   void exit();
+  // data node id sends in one phase when it holds data_size bytes before
+  // the non-uniform (MoE) scaling
+  static uint64_t get_scaled_data_size(
+      uint64_t data_size,
+      int id,
+      int non_uniform_flag,
+      const TrafficDistribution* moe_distribution);
+  // number of messages every node sends in one phase (HalfRing, FoldedRing
+  // or MATE stage, depending on the failure and the chunk stage)
+  static int get_stream_count(
+      int nodes_in_ring,
+      int link_failure_in_this_dimension,
+      LinkFailureScheduling link_failure_scheduling,
+      int chunk_stage,
+      int nodes_num_of_failed_ring,
+      int max_physical_dim_value,
+      int failure_type);
+  // size of each of these messages when the node holds data_size bytes
+  static uint64_t get_msg_size(
+      uint64_t data_size,
+      int nodes_in_ring,
+      int link_failure_in_this_dimension,
+      LinkFailureScheduling link_failure_scheduling,
+      int num_dimensions,
+      int chunk_stage,
+      int nodes_num_of_failed_ring,
+      int max_physical_dim_value,
+      int failure_type);
 };
 } // namespace AstraSim
 #endif
\ No newline at end of file
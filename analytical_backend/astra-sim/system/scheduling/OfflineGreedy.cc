@@ -8,10 +8,6 @@ LICENSE file in the root directory of this source tree.
 #include <numeric>
 namespace AstraSim {
 
-std::map<long long, std::vector<int>> OfflineGreedy::chunk_schedule;
-std::map<long long, int> OfflineGreedy::schedule_consumer;
-std::map<long long, uint64_t> OfflineGreedy::global_chunk_size;
-
 DimElapsedTime::DimElapsedTime(int dim_num) {
   this->dim_num = dim_num;
   this->elapsed_time = 0;
@@ -84,9 +80,12 @@ std::vector<int> OfflineGreedy::get_chunk_scheduling(
     std::vector<bool>& dimensions_involved,
     InterDimensionScheduling inter_dim_scheduling,
     ComType comm_type) {
+  auto& chunk_schedule = sys->context->chunk_schedule;
+  auto& schedule_consumer = sys->context->schedule_consumer;
+  auto& global_chunk_size = sys->context->global_chunk_size;
   if (chunk_schedule.find(chunk_id) != chunk_schedule.end()) {
     schedule_consumer[chunk_id]++;
-    if (schedule_consumer[chunk_id] == sys->all_generators.size()) {
+    if (schedule_consumer[chunk_id] == sys->context->generators_count) {
       std::vector<int> res = chunk_schedule[chunk_id];
       remaining_data_size -= global_chunk_size[chunk_id];
       chunk_schedule.erase(chunk_id);
@@ -98,7 +97,7 @@ std::vector<int> OfflineGreedy::get_chunk_scheduling(
     return chunk_schedule[chunk_id];
   }
   if (sys->id != 0) {
-    return sys->all_generators[0]->offline_greedy->get_chunk_scheduling(
+    return sys->context->all_generators[0]->offline_greedy->get_chunk_scheduling(
         chunk_id,
         remaining_data_size,
         recommended_chunk_size,
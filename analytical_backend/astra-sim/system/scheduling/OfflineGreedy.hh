@@ -37,9 +37,6 @@ class OfflineGreedy {
       double elapsed_time,
       DimElapsedTime dim,
       ComType comm_type);
-  static std::map<long long, std::vector<int>> chunk_schedule;
-  static std::map<long long, int> schedule_consumer;
-  static std::map<long long, uint64_t> global_chunk_size;
 };
 } // namespace AstraSim
 #endif
\ No newline at end of file
@@ -4,36 +4,35 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "CSVWriter.hh"
+#include <cstdio>
+#include <iterator>
+#include <sstream>
 #include "astra-sim/system/Common.hh"
 namespace AstraSim {
 CSVWriter::CSVWriter(std::string path, std::string name) {
   this->path = path;
   this->name = name;
+  this->initialized = false;
+  this->dirty = false;
+  this->rows = 0;
+  this->cols = 0;
+  this->fragment = -1;
 }
 void CSVWriter::initialize_csv(int rows, int cols) {
   std::cout << "CSV path and filename: " << path + name << std::endl;
-  int trial = 10000;
-  do {
-    myFile.open(path + name, std::fstream::out);
-    trial--;
-  } while (!myFile.is_open() && trial > 0);
-  if (trial == 0) {
-    std::cerr << "Unable to create file: " << path << std::endl;
-    std::cerr
-        << "This error is fatal. Please make sure the CSV write path exists."
-        << std::endl;
-    exit(1);
+  this->rows = rows;
+  this->cols = cols;
+  pending.clear();
+  initialized = true;
+  dirty = true;
+  if (fragment >= 0) {
+    return;
   }
-  do {
-    myFile.close();
-  } while (myFile.is_open());
-
-  do {
-    myFile.open(path + name, std::fstream::out | std::fstream::in);
-  } while (!myFile.is_open());
-
-  if (!myFile) {
-    std::cerr << "Unable to open file: " << path << std::endl;
+  // write the empty table right away: runs of other stat rows merge their
+  // cells into it while this run is going
+  myFile.open(path + name, std::fstream::out);
+  if (!myFile.is_open()) {
+    std::cerr << "Unable to create file: " << path << std::endl;
     std::cerr
         << "This error is fatal. Please make sure the CSV write path exists."
         << std::endl;
@@ -42,22 +41,8 @@ void CSVWriter::initialize_csv(int rows, int cols) {
     std::cout << "Success in opening CSV file for writing the report."
               << std::endl;
   }
-
-  myFile.seekp(0, std::ios_base::beg);
-  myFile.seekg(0, std::ios_base::beg);
-  /*if(!File.eof()){
-      std::cout<<"eof reached"<<std::endl;
-      return;
-  }*/
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < cols - 1; j++) {
-      myFile << ',';
-    }
-    myFile << '\n';
-  }
-  do {
-    myFile.close();
-  } while (myFile.is_open());
+  myFile << format_table(Table(rows, std::vector<std::string>(cols)));
+  myFile.close();
 }
 void CSVWriter::finalize_csv(
     std::list<std::list<std::pair<uint64_t, double>>> dims) {
@@ -139,59 +124,212 @@ void CSVWriter::finalize_csv(
   myFile.close();
 }
 void CSVWriter::write_cell(int row, int column, std::string data) {
-  std::string str = "";
-  std::string tmp;
+  Cell cell;
+  cell.row = row;
+  cell.column = column;
+  cell.data = data;
+  pending.push_back(cell);
+  dirty = true;
+}
+void CSVWriter::flush() {
+  if (!dirty) {
+    return;
+  }
+  dirty = false;
+
+  if (fragment >= 0) {
+    std::string records;
+    if (initialized) {
+      records += "init," + std::to_string(rows) + "," +
+          std::to_string(cols) + "\n";
+    }
+    for (auto& cell : pending) {
+      records += "cell," + std::to_string(cell.row) + "," +
+          std::to_string(cell.column) + "," + cell.data + "\n";
+    }
+    // the fragment appears complete (renamed) to concurrent merges
+    std::string fragment_name =
+        path + name + "." + std::to_string(fragment);
+    std::ifstream previous_file(fragment_name);
+    if (previous_file.is_open()) {
+      records = std::string(
+                    (std::istreambuf_iterator<char>(previous_file)),
+                    std::istreambuf_iterator<char>()) +
+          records;
+    }
+    std::string writing_name = fragment_name + ".writing";
+    {
+      std::ofstream fragment_file(writing_name, std::ofstream::trunc);
+      if (!fragment_file.is_open()) {
+        std::cerr << "Unable to open file: " << writing_name << std::endl;
+        std::cerr
+            << "This error is fatal. Please make sure the CSV write path exists."
+            << std::endl;
+        exit(1);
+      }
+      fragment_file << records;
+    }
+    std::rename(writing_name.c_str(), fragment_name.c_str());
+    initialized = false;
+    pending.clear();
+    return;
+  }
 
-  int status = 1;
+  if (pending.empty()) {
+    return;
+  }
+  // merge the cells into the file under one lock, waiting for the run of
+  // stat row 0 to create it if needed
   int fildes = -1;
   do {
     fildes = open((path + name).c_str(), O_RDWR);
   } while (fildes == -1);
-
-  do {
-    status = lockf(fildes, F_TLOCK, (off_t)1000000);
-  } while (status != 0);
-  char buf[1];
-  while (row > 0) {
-    status = read(fildes, buf, 1);
-    str = str + (*buf);
-    if (*buf == '\n') {
-      row--;
-    }
+  lockf(fildes, F_LOCK, 0);
+  std::string contents;
+  char buf[4096];
+  ssize_t count;
+  while ((count = read(fildes, buf, sizeof(buf))) > 0) {
+    contents.append(buf, count);
   }
-  while (column > 0) {
-    status = read(fildes, buf, 1);
-    str = str + (*buf);
-    if (*buf == ',') {
-      column--;
-    }
-    if (*buf == '\n') {
-      std::cerr << "fatal error in inserting cewll!" << std::endl;
+  Table file_table = parse_table(contents);
+  for (auto& cell : pending) {
+    insert_cell(file_table, cell.row, cell.column, cell.data);
+  }
+  pending.clear();
+  contents = format_table(file_table);
+  lseek(fildes, 0, SEEK_SET);
+  size_t written = 0;
+  while (written < contents.length()) {
+    count = write(
+        fildes, contents.c_str() + written, contents.length() - written);
+    if (count < 0) {
+      std::cerr << "Unable to write file: " << path + name << std::endl;
       exit(1);
     }
+    written += count;
   }
-  str = str + data;
-  while (read(fildes, buf, 1)) {
-    str = str + (*buf);
+  if (ftruncate(fildes, written) != 0) {
+    std::cerr << "Unable to write file: " << path + name << std::endl;
+    exit(1);
+  }
+  lseek(fildes, 0, SEEK_SET);
+  lockf(fildes, F_ULOCK, 0);
+  close(fildes);
+}
+void CSVWriter::write_to_fragment(int fragment) {
+  this->fragment = fragment;
+}
+bool CSVWriter::merge_fragments(
+    std::string path,
+    std::string name,
+    int fragments_count) {
+  std::vector<std::string> fragments;
+  for (int i = 0; i < fragments_count; i++) {
+    std::ifstream fragment_file(path + name + "." + std::to_string(i));
+    if (!fragment_file.is_open()) {
+      return false;
+    }
+    fragments.push_back(std::string(
+        (std::istreambuf_iterator<char>(fragment_file)),
+        std::istreambuf_iterator<char>()));
   }
 
-  do {
-    lseek(fildes, 0, SEEK_SET);
-    status = write(fildes, str.c_str(), str.length());
-  } while (status != str.length());
-
-  do {
-    status = lseek(fildes, 0, SEEK_SET);
-  } while (status == -1);
-
-  do {
-    status = lockf(fildes, F_ULOCK, (off_t)1000000);
-  } while (status != 0);
+  Table table;
+  for (auto& records : fragments) {
+    std::stringstream stream(records);
+    std::string record;
+    while (std::getline(stream, record)) {
+      size_t first = record.find(',');
+      size_t second = record.find(',', first + 1);
+      if (first == std::string::npos || second == std::string::npos) {
+        continue;
+      }
+      std::string kind = record.substr(0, first);
+      int row = std::stoi(record.substr(first + 1, second - first - 1));
+      if (kind == "init") {
+        int cols = std::stoi(record.substr(second + 1));
+        table = Table(row, std::vector<std::string>(cols));
+        continue;
+      }
+      size_t third = record.find(',', second + 1);
+      int column = std::stoi(record.substr(second + 1, third - second - 1));
+      std::string data =
+          third == std::string::npos ? "" : record.substr(third + 1);
+      insert_cell(table, row, column, data);
+    }
+  }
 
-  do {
-    status = close(fildes);
-  } while (status == -1);
-  return;
+  // concurrent merges of the same fragments write the same table
+  std::string merging_name =
+      path + name + ".merging." + std::to_string(getpid());
+  {
+    std::ofstream file(merging_name, std::ofstream::trunc);
+    if (!file.is_open()) {
+      std::cerr << "Unable to create file: " << merging_name << std::endl;
+      exit(1);
+    }
+    file << format_table(table);
+  }
+  std::rename(merging_name.c_str(), (path + name).c_str());
+  for (int i = 0; i < fragments_count; i++) {
+    std::remove((path + name + "." + std::to_string(i)).c_str());
+  }
+  std::cout << "Merged " << fragments_count
+            << " fragments into CSV: " << path + name << std::endl;
+  return true;
+}
+void CSVWriter::insert_cell(
+    Table& table,
+    int row,
+    int column,
+    const std::string& data) {
+  if (row >= (int)table.size()) {
+    table.resize(row + 1, std::vector<std::string>(1));
+  }
+  std::vector<std::string>& cells = table[row];
+  if (column >= (int)cells.size()) {
+    cells.resize(column + 1);
+  }
+  // data goes in front of the content of the cell
+  cells[column] = data + cells[column];
+}
+CSVWriter::Table CSVWriter::parse_table(const std::string& contents) {
+  Table table;
+  size_t line_start = 0;
+  while (line_start < contents.length()) {
+    size_t line_end = contents.find('\n', line_start);
+    if (line_end == std::string::npos) {
+      line_end = contents.length();
+    }
+    std::vector<std::string> cells;
+    size_t cell_start = line_start;
+    while (true) {
+      size_t cell_end = contents.find(',', cell_start);
+      if (cell_end == std::string::npos || cell_end > line_end) {
+        cells.push_back(
+            contents.substr(cell_start, line_end - cell_start));
+        break;
+      }
+      cells.push_back(contents.substr(cell_start, cell_end - cell_start));
+      cell_start = cell_end + 1;
+    }
+    table.push_back(cells);
+    line_start = line_end + 1;
+  }
+  return table;
+}
+std::string CSVWriter::format_table(const Table& table) {
+  std::string contents;
+  for (auto& cells : table) {
+    for (size_t column = 0; column < cells.size(); column++) {
+      if (column > 0) {
+        contents += ',';
+      }
+      contents += cells[column];
+    }
+    contents += '\n';
+  }
+  return contents;
 }
 
 } // namespace AstraSim
@@ -17,10 +17,20 @@ LICENSE file in the root directory of this source tree.
 #include <iostream>
 #include <list>
 #include <map>
+#include <string>
 #include <tuple>
 #include <vector>
 
 namespace AstraSim {
+/**
+ * CSV report of a run. initialize_csv() creates the file with an empty
+ * table. The cells of write_cell() are kept in memory and merged into the
+ * file once, by flush() (or the destructor), under a single file lock, so
+ * runs of different stat rows sharing the file keep each other's cells.
+ *
+ * With write_to_fragment(), the cells are appended to a fragment file of
+ * the run instead, without locking, and merge_fragments() assembles the CSV.
+ */
 class CSVWriter {
  public:
   // std::fstream inFile;
@@ -29,9 +39,28 @@ class CSVWriter {
   void finalize_csv(std::list<std::list<std::pair<uint64_t, double>>> dims);
   CSVWriter(std::string path, std::string name);
   void write_cell(int row, int column, std::string data);
+  /**
+   * Write the buffered cells into the file (or the fragment file).
+   */
+  void flush();
+  /**
+   * Append the cells of this writer to <name>.<fragment> instead of the CSV
+   * (call before initialize_csv() and write_cell()).
+   * @param fragment index of the fragment, e.g., the stat row of the run
+   */
+  void write_to_fragment(int fragment);
+  /**
+   * Replay the fragments 0..fragments_count-1 of a CSV in order and write
+   * the CSV. Does nothing (returns false) until every fragment exists.
+   */
+  static bool merge_fragments(
+      std::string path,
+      std::string name,
+      int fragments_count);
   std::string path;
   std::string name;
   ~CSVWriter() {
+    flush();
     if (myFile.is_open()) {
       myFile.close();
     }
@@ -40,6 +69,31 @@ class CSVWriter {
     struct stat buffer;
     return (stat(name.c_str(), &buffer) == 0);
   }
+
+ private:
+  typedef std::vector<std::vector<std::string>> Table;
+  struct Cell {
+    int row;
+    int column;
+    std::string data;
+  };
+  static void insert_cell(
+      Table& table,
+      int row,
+      int column,
+      const std::string& data);
+  static Table parse_table(const std::string& contents);
+  static std::string format_table(const Table& table);
+
+  // size given to initialize_csv(), recorded in the fragment
+  bool initialized;
+  bool dirty;
+  int rows;
+  int cols;
+  // cells written since the last flush(), in order
+  std::vector<Cell> pending;
+  // -1 unless write_to_fragment() was called
+  int fragment;
 };
 } // namespace AstraSim
 #endif
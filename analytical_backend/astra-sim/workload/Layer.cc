@@ -8,48 +8,24 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/IntData.hh"
 namespace AstraSim {
 Layer::Layer(
-    std::string id,
+    const LayerSpec* spec,
     int layer_num,
     Sys* generator,
     Workload* workload,
-    Tick fwd_pass_compute_time,
-    ComType fwd_pass_comm_type,
-    uint64_t fwd_pass_comm_size,
     std::vector<bool> fwd_pass_comm_involved_dimensions,
-    Tick input_grad_compute_time,
-    ComType input_grad_comm_type,
-    uint64_t input_grad_comm_size,
     std::vector<bool> input_grad_comm_involved_dimensions,
-    Tick weight_grad_compute_time,
-    ComType weight_grad_comm_type,
-    uint64_t weight_grad_comm_size,
-    std::vector<bool> weight_grad_comm_involved_dimensions,
-    Tick weight_grad_update_time,
-    ParallelismPolicy specific_policy) {
-  this->id = id;
+    std::vector<bool> weight_grad_comm_involved_dimensions) {
+  this->spec = spec;
   this->layer_num = layer_num;
   this->generator = generator;
   this->workload = workload;
-  this->fwd_pass_compute_time = fwd_pass_compute_time;
-  this->fwd_pass_comm_type = fwd_pass_comm_type;
-  this->fwd_pass_comm_size = fwd_pass_comm_size;
   this->fwd_pass_comm_involved_dimensions = fwd_pass_comm_involved_dimensions;
-  this->input_grad_compute_time = input_grad_compute_time;
-  this->input_grad_comm_type = input_grad_comm_type;
-  this->input_grad_comm_size = input_grad_comm_size;
   this->input_grad_comm_involved_dimensions =
       input_grad_comm_involved_dimensions;
-  this->weight_grad_compute_time = weight_grad_compute_time;
-  this->weight_grad_comm_type = weight_grad_comm_type;
-  this->weight_grad_comm_size = weight_grad_comm_size;
   this->weight_grad_comm_involved_dimensions =
       weight_grad_comm_involved_dimensions;
   this->collective_counter = 0;
 
-  this->weight_grad_update_time = weight_grad_update_time;
-  this->fwd_update_time = weight_grad_update_time;
-  this->input_grad_update_time = weight_grad_update_time;
-
   // this->fwd_pass_dataset=NULL;
   //->input_grad_dataset=NULL;
   // this->weight_grad_dataset=NULL;
@@ -65,9 +41,6 @@ Layer::Layer(
   this->last_fwd_finished = 0;
   this->last_ig_finished = 0;
   this->last_wg_finished = 0;
-  this->needs_fwd_in_bckwd_initiation = false;
-  this->is_checkpoint = false;
-  this->specific_parallellism = specific_policy;
   assert(generator != NULL);
 
 }
@@ -79,7 +52,7 @@ void Layer::call(EventType event, CallData* mdata) {
         this,
         EventType::Wight_Grad_Comm_Finished_After_Delay,
         mdata,
-        weight_grad_update_time);
+        spec->weight_grad_update_time);
     return;
   } else if (event == EventType::Input_Grad_Comm_Finished) {
     last_ig_finished = Sys::boostedTick();
@@ -87,22 +60,22 @@ void Layer::call(EventType event, CallData* mdata) {
         this,
         EventType::Input_Grad_Comm_Finished_After_Delay,
         mdata,
-        input_grad_update_time);
+        spec->input_grad_update_time);
     return;
   } else if (event == EventType::Fwd_Comm_Finished) {
     last_fwd_finished = Sys::boostedTick();
     generator->register_event(
-        this, EventType::Fwd_Comm_Finished_After_Delay, mdata, fwd_update_time);
+        this, EventType::Fwd_Comm_Finished_After_Delay, mdata, spec->fwd_update_time);
     return;
   }
   int data = ((IntData*)mdata)->data;
   IntData* intData = ((IntData*)mdata);
   if (event == EventType::Wight_Grad_Comm_Finished_After_Delay) {
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << " ***** info: weight gradient collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << " ***** info: weight gradient collective for layer: " << spec->id
                 << " is finished************" << std::endl;
     }
-    weight_grad_datasets[data]->finish_tick += weight_grad_update_time;
+    weight_grad_datasets[data]->finish_tick += spec->weight_grad_update_time;
     total_weight_grad_comm += weight_grad_datasets[data]->finish_tick -
         weight_grad_datasets[data]->creation_tick;
     if (weight_grad_datasets.size() == 1 &&
@@ -139,10 +112,10 @@ void Layer::call(EventType event, CallData* mdata) {
     return;
   } else if (event == EventType::Input_Grad_Comm_Finished_After_Delay) {
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << " ***** info: input gradient collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << " ***** info: input gradient collective for layer: " << spec->id
                 << " is finished************" << std::endl;
     }
-    input_grad_datasets[data]->finish_tick += input_grad_update_time;
+    input_grad_datasets[data]->finish_tick += spec->input_grad_update_time;
     total_input_grad_comm += input_grad_datasets[data]->finish_tick -
         input_grad_datasets[data]->creation_tick;
     if (input_grad_datasets.size() == 1 &&
@@ -179,10 +152,10 @@ void Layer::call(EventType event, CallData* mdata) {
     return;
   } else if (event == EventType::Fwd_Comm_Finished_After_Delay) {
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << " ***** info: fwd pass comm collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << " ***** info: fwd pass comm collective for layer: " << spec->id
                 << " is finished************" << std::endl;
     }
-    fwd_pass_datasets[data]->finish_tick += fwd_update_time;
+    fwd_pass_datasets[data]->finish_tick += spec->fwd_update_time;
     total_fwd_comm += fwd_pass_datasets[data]->finish_tick -
         fwd_pass_datasets[data]->creation_tick;
     if (fwd_pass_datasets.size() == 1 &&
@@ -225,16 +198,16 @@ void Layer::call(EventType event, CallData* mdata) {
 }
 
 Tick Layer::get_fwd_pass_compute() {
-  total_forward_pass_compute += fwd_pass_compute_time;
-  return fwd_pass_compute_time;
+  total_forward_pass_compute += spec->fwd_pass_compute_time;
+  return spec->fwd_pass_compute_time;
 }
 Tick Layer::get_input_grad_compute() {
-  total_input_grad_compute += input_grad_compute_time;
-  return input_grad_compute_time;
+  total_input_grad_compute += spec->input_grad_compute_time;
+  return spec->input_grad_compute_time;
 }
 Tick Layer::get_weight_grad_compute() {
-  total_weight_grad_compute += weight_grad_compute_time;
-  return weight_grad_compute_time;
+  total_weight_grad_compute += spec->weight_grad_compute_time;
+  return spec->weight_grad_compute_time;
 }
 void Layer::increment_waiting_for_wg() {
   total_waiting_for_wg_comm++;
@@ -305,6 +278,19 @@ void Layer::print_involved_dimensions(std::vector<bool>& involved_dimensions) {
   }
   std::cout << std::endl;
 }
+DataSet* Layer::generate_all_to_all(
+    ComType comm_type,
+    uint64_t comm_size,
+    std::vector<bool>& involved_dimensions,
+    SchedulingPolicy pref_scheduling) {
+  if (comm_type == ComType::All_to_Allv) {
+    // the sizes come from the traffic matrix of the layer
+    return generator->generate_all_to_allv(
+        involved_dimensions, pref_scheduling, layer_num);
+  }
+  return generator->generate_all_to_all(
+      comm_size, involved_dimensions, pref_scheduling, layer_num);
+}
 LayerData Layer::report(
     std::string run_name,
     int layer_num,
@@ -323,7 +309,7 @@ LayerData Layer::report(
   total_exposed += (total_waiting_for_fwd_comm / FREQ);
   total_exposed += (total_waiting_for_wg_comm / FREQ);
   total_exposed += (total_waiting_for_ig_comm / FREQ);
-  layerData.layer_name = id;
+  layerData.layer_name = spec->id;
   layerData.total_forward_pass_compute = total_forward_pass_compute / FREQ;
   layerData.total_weight_grad_compute = total_weight_grad_compute / FREQ;
   layerData.total_input_grad_compute = total_input_grad_compute / FREQ;
@@ -343,21 +329,21 @@ LayerData Layer::report(
   }
   if (seprate_log) {
     std::cout << "*******************" << std::endl;
-    std::cout << "Layer id: " << id << std::endl;
+    std::cout << "Layer id: " << spec->id << std::endl;
     std::cout << "Total collectives issued for this layer: "
               << collective_counter << std::endl;
     if (stat_row == 0) {
-      EndToEnd->write_cell(layer_num * total_rows + 1, 0, id);
-      detailed->write_cell(layer_num * total_rows + 1, 0, id);
+      EndToEnd->write_cell(layer_num * total_rows + 1, 0, spec->id);
+      detailed->write_cell(layer_num * total_rows + 1, 0, spec->id);
     }
     EndToEnd->write_cell(layer_num * total_rows + 1 + stat_row, 1, run_name);
     detailed->write_cell(layer_num * total_rows + 1 + stat_row, 1, run_name);
 
     std::cout << "*************************  Workload stats  "
                  "************************* "
-              << id << std::endl;
+              << spec->id << std::endl;
 
-    std::cout << "id: " << id << " ,Total cycles spent on fwd pass compute: "
+    std::cout << "id: " << spec->id << " ,Total cycles spent on fwd pass compute: "
               << total_forward_pass_compute << std::endl;
     if (stat_row == 0 && layer_num == 0) {
       EndToEnd->write_cell(0, 2, "fwd compute");
@@ -367,7 +353,7 @@ LayerData Layer::report(
         2,
         std::to_string(total_forward_pass_compute / FREQ));
 
-    std::cout << "id: " << id << " ,Total cycles spent on weight grad compute: "
+    std::cout << "id: " << spec->id << " ,Total cycles spent on weight grad compute: "
               << total_weight_grad_compute << std::endl;
     if (stat_row == 0 && layer_num == 0) {
       EndToEnd->write_cell(0, 3, "wg compute");
@@ -377,7 +363,7 @@ LayerData Layer::report(
         3,
         std::to_string(total_weight_grad_compute / FREQ));
 
-    std::cout << "id: " << id << " ,Total cycles spent on input grad compute: "
+    std::cout << "id: " << spec->id << " ,Total cycles spent on input grad compute: "
               << total_input_grad_compute << std::endl;
     if (stat_row == 0 && layer_num == 0) {
       EndToEnd->write_cell(0, 4, "ig compute");
@@ -387,7 +373,7 @@ LayerData Layer::report(
         4,
         std::to_string(total_input_grad_compute / FREQ));
 
-    std::cout << "id: " << id
+    std::cout << "id: " << spec->id
               << " ,Total cycles spent idle waiting for fwd finish: "
               << total_waiting_for_fwd_comm << std::endl;
     if (stat_row == 0 && layer_num == 0) {
@@ -398,7 +384,7 @@ LayerData Layer::report(
         5,
         std::to_string(total_waiting_for_fwd_comm / FREQ));
 
-    std::cout << "id: " << id
+    std::cout << "id: " << spec->id
               << " ,Total cycles spent idle waiting for weight grad finish: "
               << total_waiting_for_wg_comm << std::endl;
     if (stat_row == 0 && layer_num == 0) {
@@ -409,7 +395,7 @@ LayerData Layer::report(
         6,
         std::to_string(total_waiting_for_wg_comm / FREQ));
 
-    std::cout << "id: " << id
+    std::cout << "id: " << spec->id
               << " ,Total cycles spent idle waiting for input grad finish: "
               << total_waiting_for_ig_comm << std::endl;
     if (stat_row == 0 && layer_num == 0) {
@@ -420,7 +406,7 @@ LayerData Layer::report(
         7,
         std::to_string(total_waiting_for_ig_comm / FREQ));
 
-    std::cout << "id: " << id
+    std::cout << "id: " << spec->id
               << " ,Total cycles spent on fwd pass comm: " << total_fwd_comm
               << std::endl;
     if (stat_row == 0 && layer_num == 0) {
@@ -431,7 +417,7 @@ LayerData Layer::report(
         8,
         std::to_string(total_fwd_comm / FREQ));
 
-    std::cout << "id: " << id << " ,Total cycles spent on weight grad comm: "
+    std::cout << "id: " << spec->id << " ,Total cycles spent on weight grad comm: "
               << total_weight_grad_comm << std::endl;
     if (stat_row == 0 && layer_num == 0) {
       EndToEnd->write_cell(0, 9, "wg total comm");
@@ -441,7 +427,7 @@ LayerData Layer::report(
         9,
         std::to_string(total_weight_grad_comm / FREQ));
 
-    std::cout << "id: " << id << " ,Total cycles spent on input grad comm: "
+    std::cout << "id: " << spec->id << " ,Total cycles spent on input grad comm: "
               << total_input_grad_comm << std::endl;
     if (stat_row == 0 && layer_num == 0) {
       EndToEnd->write_cell(0, 10, "ig total comm");
@@ -470,11 +456,11 @@ LayerData Layer::report(
 
     std::cout << "*************************  Queuing stats  "
                  "************************* "
-              << id << std::endl;
+              << spec->id << std::endl;
     int count = 2;
     int i = 0;
     for (auto& qd : queuing_delay) {
-      std::cout << "id: " << id
+      std::cout << "id: " << spec->id
                 << " ,Average cycles spent on queuing for phase " << i++
                 << " of algorithm (per chunk): " << qd << std::endl;
       if (stat_row == 0 && layer_num == 0) {
@@ -488,10 +474,10 @@ LayerData Layer::report(
     }
     std::cout << "*************************  Network stats  "
                  "************************* "
-              << id << std::endl;
+              << spec->id << std::endl;
     i = 1;
     for (auto& ml : net_message_latency) {
-      std::cout << "id: " << id
+      std::cout << "id: " << spec->id
                 << " ,Average cycles spent on network for phase " << i++
                 << " of algorithm (per message): " << ml << std::endl;
       if (stat_row == 0 && layer_num == 0) {
@@ -507,7 +493,7 @@ LayerData Layer::report(
       std::cout
           << "*************************  Chunk Stats Per Logical Dimension (for all layers) "
              "************************* "
-          << id << std::endl;
+          << spec->id << std::endl;
       i = 1;
       std::vector<double> avg_chunk_latency_per_dimension =
           generator->scheduler_unit->get_average_latency_per_dimension();
@@ -530,9 +516,9 @@ void Layer::issue_forward_pass_comm(
   DataSet* fp = NULL;
   fwd_barrier = barrier;
   collective_counter++;
-  if (fwd_pass_comm_type == ComType::All_Reduce) {
+  if (spec->fwd_pass_comm_type == ComType::All_Reduce) {
     fp = generator->generate_all_reduce(
-        fwd_pass_comm_size,
+        spec->fwd_pass_comm_size,
         fwd_pass_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -540,7 +526,7 @@ void Layer::issue_forward_pass_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no forward pass collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete fp;
@@ -551,20 +537,21 @@ void Layer::issue_forward_pass_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-reduce forward pass collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(fwd_pass_comm_involved_dimensions);
     }
-  } else if (fwd_pass_comm_type == ComType::All_to_All) { 
-    fp = generator->generate_all_to_all(
-        fwd_pass_comm_size,
+  } else if (spec->fwd_pass_comm_type == ComType::All_to_All ||
+             spec->fwd_pass_comm_type == ComType::All_to_Allv) {
+    fp = generate_all_to_all(
+        spec->fwd_pass_comm_type,
+        spec->fwd_pass_comm_size,
         fwd_pass_comm_involved_dimensions,
-        pref_scheduling,
-        layer_num);
+        pref_scheduling);
     if (!fp->active) {
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no forward pass collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete fp;
@@ -575,12 +562,12 @@ void Layer::issue_forward_pass_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-to-all forward pass collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(fwd_pass_comm_involved_dimensions);
     }
-  } else if (fwd_pass_comm_type == ComType::All_Gather) {
+  } else if (spec->fwd_pass_comm_type == ComType::All_Gather) {
     fp = generator->generate_all_gather(
-        fwd_pass_comm_size,
+        spec->fwd_pass_comm_size,
         fwd_pass_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -588,7 +575,7 @@ void Layer::issue_forward_pass_comm(
       if (generator->id == 0) {
         std::cout
              << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no forward pass collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete fp;
@@ -599,12 +586,12 @@ void Layer::issue_forward_pass_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-gather forward pass collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(fwd_pass_comm_involved_dimensions);
     }
-  } else if (fwd_pass_comm_type == ComType::Reduce_Scatter) {
+  } else if (spec->fwd_pass_comm_type == ComType::Reduce_Scatter) {
     fp = generator->generate_reduce_scatter(
-        fwd_pass_comm_size,
+        spec->fwd_pass_comm_size,
         fwd_pass_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -612,7 +599,7 @@ void Layer::issue_forward_pass_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no forward pass collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete fp;
@@ -624,13 +611,13 @@ void Layer::issue_forward_pass_comm(
     if (generator->id == 0) {
       std::cout
           << "At Time " << Sys::boostedTick() << ", info: reduce-scatter forward pass collective issued for layer: "
-          << id << ",";
+          << spec->id << ",";
       print_involved_dimensions(fwd_pass_comm_involved_dimensions);
     }
-  } else if (fwd_pass_comm_type == ComType::None) {
+  } else if (spec->fwd_pass_comm_type == ComType::None) {
     collective_counter--;
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << ", info: no forward pass collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << ", info: no forward pass collective for layer: " << spec->id
                 << std::endl;
     }
     if (barrier == CollectiveBarrier::Blocking) {
@@ -649,9 +636,9 @@ void Layer::issue_input_grad_comm(
   DataSet* ig = NULL;
   ig_barrier = barrier;
   collective_counter++;
-  if (input_grad_comm_type == ComType::All_Reduce) {
+  if (spec->input_grad_comm_type == ComType::All_Reduce) {
     ig = generator->generate_all_reduce(
-        input_grad_comm_size,
+        spec->input_grad_comm_size,
         input_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -659,7 +646,7 @@ void Layer::issue_input_grad_comm(
       if (generator->id == 0) {
         std::cout
              << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no input grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete ig;
@@ -670,20 +657,21 @@ void Layer::issue_input_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-reduce input grad collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(input_grad_comm_involved_dimensions);
     }
-  } else if (input_grad_comm_type == ComType::All_to_All) {
-    ig = generator->generate_all_to_all(
-        input_grad_comm_size,
+  } else if (spec->input_grad_comm_type == ComType::All_to_All ||
+             spec->input_grad_comm_type == ComType::All_to_Allv) {
+    ig = generate_all_to_all(
+        spec->input_grad_comm_type,
+        spec->input_grad_comm_size,
         input_grad_comm_involved_dimensions,
-        pref_scheduling,
-        layer_num);
+        pref_scheduling);
     if (!ig->active) {
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no input grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete ig;
@@ -694,12 +682,12 @@ void Layer::issue_input_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-to-all input grad collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(input_grad_comm_involved_dimensions);
     }
-  } else if (input_grad_comm_type == ComType::All_Gather) {
+  } else if (spec->input_grad_comm_type == ComType::All_Gather) {
     ig = generator->generate_all_gather(
-        input_grad_comm_size,
+        spec->input_grad_comm_size,
         input_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -707,7 +695,7 @@ void Layer::issue_input_grad_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no input grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete ig;
@@ -718,12 +706,12 @@ void Layer::issue_input_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-gather input grad collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(input_grad_comm_involved_dimensions);
     }
-  } else if (input_grad_comm_type == ComType::Reduce_Scatter) {
+  } else if (spec->input_grad_comm_type == ComType::Reduce_Scatter) {
     ig = generator->generate_reduce_scatter(
-        input_grad_comm_size,
+        spec->input_grad_comm_size,
         input_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -731,7 +719,7 @@ void Layer::issue_input_grad_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no input grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete ig;
@@ -743,13 +731,13 @@ void Layer::issue_input_grad_comm(
     if (generator->id == 0) {
       std::cout
           << "At Time " << Sys::boostedTick() << ", info: reduce-scatter input grad collective issued for layer: "
-          << id << ",";
+          << spec->id << ",";
       print_involved_dimensions(input_grad_comm_involved_dimensions);
     }
-  } else if (input_grad_comm_type == ComType::None) {
+  } else if (spec->input_grad_comm_type == ComType::None) {
     collective_counter--;
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << ", info: no input grad collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << ", info: no input grad collective for layer: " << spec->id
                 << std::endl;
     }
     if (barrier == CollectiveBarrier::Blocking) {
@@ -757,7 +745,7 @@ void Layer::issue_input_grad_comm(
     }
     return;
   } else {
-    std::cout << "no known collective operation! for layer: " << id
+    std::cout << "no known collective operation! for layer: " << spec->id
               << std::endl;
     Sys::sys_panic("no known collective operation! ");
   }
@@ -772,9 +760,9 @@ void Layer::issue_weight_grad_comm(
   DataSet* wg = NULL;
   wg_barrier = barrier;
   collective_counter++;
-  if (weight_grad_comm_type == ComType::All_Reduce) {
+  if (spec->weight_grad_comm_type == ComType::All_Reduce) {
     wg = generator->generate_all_reduce(
-        weight_grad_comm_size,
+        spec->weight_grad_comm_size,
         weight_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -782,7 +770,7 @@ void Layer::issue_weight_grad_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no weight grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete wg;
@@ -793,20 +781,21 @@ void Layer::issue_weight_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-reduce weight grad collective issued for layer: "
-                << id << " with size: " << weight_grad_comm_size << ",";
+                << spec->id << " with size: " << spec->weight_grad_comm_size << ",";
       print_involved_dimensions(weight_grad_comm_involved_dimensions);
     }
-  } else if (weight_grad_comm_type == ComType::All_to_All) {
-    wg = generator->generate_all_to_all(
-        weight_grad_comm_size,
+  } else if (spec->weight_grad_comm_type == ComType::All_to_All ||
+             spec->weight_grad_comm_type == ComType::All_to_Allv) {
+    wg = generate_all_to_all(
+        spec->weight_grad_comm_type,
+        spec->weight_grad_comm_size,
         weight_grad_comm_involved_dimensions,
-        pref_scheduling,
-        layer_num);
+        pref_scheduling);
     if (!wg->active) {
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no weight grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete wg;
@@ -817,12 +806,12 @@ void Layer::issue_weight_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-to-all weight grad collective issued for layer: "
-                << id << " with size: " << weight_grad_comm_size << ",";
+                << spec->id << " with size: " << spec->weight_grad_comm_size << ",";
       print_involved_dimensions(weight_grad_comm_involved_dimensions);
     }
-  } else if (weight_grad_comm_type == ComType::All_Gather) {
+  } else if (spec->weight_grad_comm_type == ComType::All_Gather) {
     wg = generator->generate_all_gather(
-        weight_grad_comm_size,
+        spec->weight_grad_comm_size,
         weight_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -830,7 +819,7 @@ void Layer::issue_weight_grad_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no weight grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete wg;
@@ -841,12 +830,12 @@ void Layer::issue_weight_grad_comm(
     }
     if (generator->id == 0) {
       std::cout << "At Time " << Sys::boostedTick() << ", info: all-gather weight grad collective issued for layer: "
-                << id << ",";
+                << spec->id << ",";
       print_involved_dimensions(weight_grad_comm_involved_dimensions);
     }
-  } else if (weight_grad_comm_type == ComType::Reduce_Scatter) {
+  } else if (spec->weight_grad_comm_type == ComType::Reduce_Scatter) {
     wg = generator->generate_reduce_scatter(
-        weight_grad_comm_size,
+        spec->weight_grad_comm_size,
         weight_grad_comm_involved_dimensions,
         pref_scheduling,
         layer_num);
@@ -854,7 +843,7 @@ void Layer::issue_weight_grad_comm(
       if (generator->id == 0) {
         std::cout
             << "At Time " << Sys::boostedTick() << ", info: all dims disabled, no weight grad collective for layer: "
-            << id << std::endl;
+            << spec->id << std::endl;
       }
       collective_counter--;
       delete wg;
@@ -866,13 +855,13 @@ void Layer::issue_weight_grad_comm(
     if (generator->id == 0) {
       std::cout
           << "At Time " << Sys::boostedTick() << ", info: reduce-scatter weight grad collective issued for layer: "
-          << id << ",";
+          << spec->id << ",";
       print_involved_dimensions(weight_grad_comm_involved_dimensions);
     }
-  } else if (weight_grad_comm_type == ComType::None) {
+  } else if (spec->weight_grad_comm_type == ComType::None) {
     collective_counter--;
     if (generator->id == 0) {
-      std::cout << "At Time " << Sys::boostedTick() << ", info: no weight grad collective for layer: " << id
+      std::cout << "At Time " << Sys::boostedTick() << ", info: no weight grad collective for layer: " << spec->id
                 << std::endl;
     }
     if (barrier == CollectiveBarrier::Blocking) {
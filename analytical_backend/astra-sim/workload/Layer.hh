@@ -26,33 +26,19 @@ namespace AstraSim {
 class DataSet;
 class Layer : public Callable, public StreamStat {
  public:
-  std::string id;
+  /**
+   * static parameters, shared by the layers of all NPUs (see WorkloadSpec)
+   */
+  const LayerSpec* spec;
   int layer_num;
   Sys* generator;
   Workload* workload;
 
-  Tick fwd_pass_compute_time;
-  ComType fwd_pass_comm_type;
-  uint64_t fwd_pass_comm_size;
-  Tick fwd_update_time;
+  // dimensions of this NPU involved in each collective of the layer
   std::vector<bool> fwd_pass_comm_involved_dimensions;
-
-  Tick input_grad_compute_time;
-  ComType input_grad_comm_type;
-  uint64_t input_grad_comm_size;
-  Tick input_grad_update_time;
   std::vector<bool> input_grad_comm_involved_dimensions;
-
-  Tick weight_grad_compute_time;
-  ComType weight_grad_comm_type;
-  uint64_t weight_grad_comm_size;
-  Tick weight_grad_update_time;
   std::vector<bool> weight_grad_comm_involved_dimensions;
 
-  bool needs_fwd_in_bckwd_initiation;
-  bool is_checkpoint;
-  ParallelismPolicy specific_parallellism;
-
   int lookup_table_size;
   int collective_counter;
 
@@ -88,24 +74,13 @@ class Layer : public Callable, public StreamStat {
   CollectiveBarrier ig_barrier;
 
   Layer(
-      std::string id,
+      const LayerSpec* spec,
       int layer_num,
       Sys* generator,
       Workload* workload,
-      Tick fwd_pass_compute_time,
-      ComType fwd_pass_comm_type,
-      uint64_t fwd_pass_comm_size,
       std::vector<bool> fwd_pass_comm_involved_dimensions,
-      Tick input_grad_compute_time,
-      ComType input_grad_comm_type,
-      uint64_t input_grad_comm_size,
       std::vector<bool> input_grad_comm_involved_dimensions,
-      Tick weight_grad_compute_time,
-      ComType weight_grad_comm_type,
-      uint64_t weight_grad_comm_size,
-      std::vector<bool> weight_grad_comm_involved_dimensions,
-      Tick weight_grad_update_time,
-      ParallelismPolicy specific_policy);
+      std::vector<bool> weight_grad_comm_involved_dimensions);
   void call(EventType event, CallData* mdata);
   Tick get_fwd_pass_compute();
   Tick get_input_grad_compute();
@@ -139,6 +114,11 @@ class Layer : public Callable, public StreamStat {
       SchedulingPolicy pref_scheduling,
       CollectiveBarrier barrier);
   void print_involved_dimensions(std::vector<bool>& involved_dimensions);
+  DataSet* generate_all_to_all(
+      ComType comm_type,
+      uint64_t comm_size,
+      std::vector<bool>& involved_dimensions,
+      SchedulingPolicy pref_scheduling);
 };
 } // namespace AstraSim
 #endif
@@ -67,6 +67,10 @@ Workload::Workload(
     end_to_end = new CSVWriter(path, "EndToEnd.csv");
     dimension_utilization =
         new CSVWriter(path, run_name + "_dimension_utilization.csv");
+    if (generator->context->csv_fragments) {
+      detailed->write_to_fragment(stat_row);
+      end_to_end->write_to_fragment(stat_row);
+    }
     if (stat_row == 0) {
       initialize_stat_files();
     }
@@ -138,10 +142,12 @@ void Workload::report() {
   }
   std::cout << "*************************" << std::endl;
   std::cout << "all passes finished at time: " << Sys::boostedTick()
-            << ", id of first layer: " << layers[0]->id << std::endl;
+            << ", id of first layer: " << layers[0]->spec->id << std::endl;
   generator->NI->pass_front_end_report(astraSimDataAPI);
 
   if (this->seprate_log) {
+    detailed->flush();
+    end_to_end->flush();
     std::list<std::list<std::pair<uint64_t, double>>> dims;
     for (int i = 0; i < generator->scheduler_unit->usage.size(); i++) {
       dims.push_back(
@@ -923,9 +929,9 @@ void Workload::iterate_hybrid_parallel_Transformer_fwd_in_bckwd() {
     generator->register_event(this, EventType::General, NULL, 1);
     return;
   } else if (current_state == LoopState::Input_Gradient) {
-    if (layers[index]->needs_fwd_in_bckwd_initiation && !checkpoint_initiated) {
+    if (layers[index]->spec->needs_fwd_in_bckwd_initiation && !checkpoint_initiated) {
       int tmp = index;
-      while (!layers[index--]->is_checkpoint)
+      while (!layers[index--]->spec->is_checkpoint)
         ;
       index++;
       current_state = LoopState::Forward_In_BackPass;
@@ -993,7 +999,7 @@ void Workload::iterate_hybrid_parallel_Transformer_fwd_in_bckwd() {
     index++;
     delay_loaded = false;
     collective_issued = false;
-    if (layers[index]->needs_fwd_in_bckwd_initiation) {
+    if (layers[index]->spec->needs_fwd_in_bckwd_initiation) {
       current_state = LoopState::Input_Gradient;
     }
     generator->register_event(this, EventType::General, NULL, 1);
@@ -1033,7 +1039,7 @@ void Workload::iterate_hybrid_parallel_DLRM() {
       return;
     }
     if (!collective_issued &&
-        layers[index]->fwd_pass_comm_type == ComType::All_to_All) {
+        layers[index]->spec->fwd_pass_comm_type == ComType::All_to_All) {
       collective_issued = true;
       layers[index]->issue_forward_pass_comm(
           SchedulingPolicy::HIGHEST, CollectiveBarrier::Non_Blocking);
@@ -1254,219 +1260,81 @@ std::map<std::string, std::vector<bool>> Workload::decode_involved_dimensions(
   return result;
 }
 bool Workload::initialize_workload(std::string name) {
-  std::map<int, bool> chekpoints;
-  std::map<int, bool> need_checkpoint_initiation;
-  std::ifstream inFile;
-  inFile.open(name);
-  if (!inFile) {
-    std::cerr << "Unable to open file: " << name << std::endl;
-    std::cerr << "######### Exiting because unable to open the workload input "
-                 "file #########"
-              << std::endl;
-    std::cerr << "This error is fatal. Please check your path and filename."
-              << std::endl;
-    exit(1);
-  } else {
-    if (generator->id == 0) {
-      std::cout << "Success in opening workload file" << std::endl;
-    }
+  spec = WorkloadSpec::load(
+      *generator->context->input_files,
+      name,
+      generator->compute_scale,
+      generator->comm_scale);
+  if (generator->id == 0) {
+    std::cout << "Success in opening workload file" << std::endl;
   }
-  std::string type;
-  int lines;
-  inFile >> type;
-  parallelismPolicy = decode_parallelsim(type);
+  parallelismPolicy = spec->parallelism_policy;
   int model_parallel_npu_group = -1;
   if (parallelismPolicy == ParallelismPolicy::TransformerFwdInBckwd ||
-      parallelismPolicy == ParallelismPolicy::Transformer) {    
-    std::string tmp;
-    int i;
-    inFile >> tmp;
-    inFile >> model_parallel_npu_group;
+      parallelismPolicy == ParallelismPolicy::Transformer) {
+    model_parallel_npu_group = spec->model_parallel_npu_group;
     if (generator->id == 0) {
-      std::cout << tmp << " is: " << model_parallel_npu_group << std::endl;
-    }
-    if (parallelismPolicy == ParallelismPolicy::TransformerFwdInBckwd) {
-      inFile >> tmp;
-      inFile >> i;
-      if (generator->id == 0) {
-        std::cout << "checkpoints layers are: ";
-      }
-      while (i-- > 0) {
-        int layer;
-        inFile >> layer;
-        chekpoints[layer] = true;
-        if (generator->id == 0) {
-          std::cout << layer << ", ";
-        }
+      std::cout << spec->model_parallel_npu_group_name
+                << " is: " << model_parallel_npu_group << std::endl;
+    }
+    if (parallelismPolicy == ParallelismPolicy::TransformerFwdInBckwd &&
+        generator->id == 0) {
+      std::cout << "checkpoints layers are: ";
+      for (int layer : spec->checkpoint_layers) {
+        std::cout << layer << ", ";
       }
-      if (generator->id == 0) {
-        std::cout << std::endl;
-        std::cout << "layers initiating fwd_in_bckwd are: ";
-      }
-      inFile >> tmp;
-      inFile >> i;
-      while (i-- > 0) {
-        int layer;
-        inFile >> layer;
-        need_checkpoint_initiation[layer] = true;
-        if (generator->id == 0) {
-          std::cout << layer << ", ";
-        }
-      }
-      if (generator->id == 0) {
-        std::cout << std::endl;
+      std::cout << std::endl;
+      std::cout << "layers initiating fwd_in_bckwd are: ";
+      for (int layer : spec->fwd_in_bckwd_layers) {
+        std::cout << layer << ", ";
       }
+      std::cout << std::endl;
     }
   } else if (
       parallelismPolicy == ParallelismPolicy::DLRM ||
       parallelismPolicy == ParallelismPolicy::DLRMEnhanced) {
-    inFile >> DLRM_LAST_BOTTOM_LAYER;
+    DLRM_LAST_BOTTOM_LAYER = spec->dlrm_last_bottom_layer;
     if (generator->id == 0) {
       std::cout
           << "****************** info: DLRM workload last bottom layer is: "
           << DLRM_LAST_BOTTOM_LAYER << std::endl;
     }
-  } else if (parallelismPolicy == ParallelismPolicy::None) {
-    std::cerr << "######### Exiting because unable to decode the workload "
-                 "parallelization strategy #########"
-              << std::endl;
-    inFile.close();
-    exit(1);
   }
   std::map<std::string, std::vector<bool>> general_involved_dimensions =
       decode_involved_dimensions(parallelismPolicy, model_parallel_npu_group);
-  inFile >> lines;
-  run_type = type;
-  SIZE = lines;
+  run_type = spec->run_type;
+  SIZE = spec->layers.size();
   layers = new Layer*[SIZE];
-  for (int i = 0; i < lines; i++) {
-    std::string id;
-    inFile >> id;
-    int depen; 
-    inFile >> depen;
-
-    Tick fp_compute_time;
-    inFile >> fp_compute_time;
-    std::string fp_comm_type_s;
-    inFile >> fp_comm_type_s;
-    uint64_t fp_comm_size;
-    inFile >> fp_comm_size;
-
-    Tick ig_compute_time;
-    inFile >> ig_compute_time;
-    std::string ig_comm_type_s;
-    inFile >> ig_comm_type_s;
-    uint64_t ig_comm_size;
-    inFile >> ig_comm_size;
-
-    Tick wg_compute_time;
-    inFile >> wg_compute_time;
-    std::string wg_comm_type_s;
-    inFile >> wg_comm_type_s;
-    uint64_t wg_comm_size;
-    inFile >> wg_comm_size;
-    // wg_comm_size=2048;
-
-    Tick wg_update_time;
-    inFile >> wg_update_time;
-
-    ParallelismPolicy specific_policy = ParallelismPolicy::None;
-    std::map<std::string, std::vector<bool>> selected_involved_dimensions;
-    ComType fp_type = ComType::None;
-    ComType ig_type = ComType::None;
-    ComType wg_type = ComType::None;
-
-    // assign the read value to variables
-    if (wg_comm_type_s == "ALLREDUCE") {
-      wg_type = ComType::All_Reduce;
-    } else if (wg_comm_type_s == "ALLTOALL") {
-      wg_type = ComType::All_to_All;
-    } else if (wg_comm_type_s == "ALLREDUCEALLTOALL") {
-      wg_type = ComType::All_Reduce_All_to_All;
-    } else if (wg_comm_type_s == "ALLGATHER") {
-      wg_type = ComType::All_Gather;
-    } else if (wg_comm_type_s == "REDUCESCATTER") {
-      wg_type = ComType::Reduce_Scatter;
-    }
-
-    if (ig_comm_type_s == "ALLREDUCE") {
-      ig_type = ComType::All_Reduce;
-    } else if (ig_comm_type_s == "ALLTOALL") {
-      ig_type = ComType::All_to_All;
-    } else if (ig_comm_type_s == "ALLREDUCEALLTOALL") {
-      ig_type = ComType::All_Reduce_All_to_All;
-    } else if (ig_comm_type_s == "ALLGATHER") {
-      ig_type = ComType::All_Gather;
-    } else if (ig_comm_type_s == "REDUCESCATTER") {
-      ig_type = ComType::Reduce_Scatter;
-    }
-
-    if (fp_comm_type_s == "ALLREDUCE") {
-      fp_type = ComType::All_Reduce;
-    } else if (fp_comm_type_s == "ALLTOALL") {
-      fp_type = ComType::All_to_All;
-    } else if (fp_comm_type_s == "ALLREDUCEALLTOALL") {
-      fp_type = ComType::All_Reduce_All_to_All;
-    } else if (fp_comm_type_s == "ALLGATHER") {
-      fp_type = ComType::All_Gather;
-    } else if (fp_comm_type_s == "REDUCESCATTER") {
-      fp_type = ComType::Reduce_Scatter;
-    }
-
+  for (int i = 0; i < SIZE; i++) {
+    const LayerSpec& layer_spec = spec->layers[i];
     if (generator->id == 0) {
-      std::cout << "id: " << id << " , depen: " << depen
-                << " , wg_comp_time: " << wg_compute_time << std::endl;
-    }
-    if (parallelismPolicy == ParallelismPolicy::HybridCustomized) {
-      std::string specific_parallelsim;
-      inFile >> specific_parallelsim;
-      specific_policy = decode_parallelsim(specific_parallelsim);
-    }
-    if ((parallelismPolicy == ParallelismPolicy::DLRM ||
-         parallelismPolicy == ParallelismPolicy::DLRMEnhanced) && i == 0) {
-      specific_policy = ParallelismPolicy::All;
+      std::cout << "id: " << layer_spec.id
+                << " , depen: " << layer_spec.dependency
+                << " , wg_comp_time: " << layer_spec.weight_grad_compute_time
+                << std::endl;
     }
-    if (specific_policy != ParallelismPolicy::None) {
-      selected_involved_dimensions =
-          decode_involved_dimensions(specific_policy, model_parallel_npu_group);
+    std::map<std::string, std::vector<bool>> selected_involved_dimensions;
+    if (layer_spec.specific_parallellism != ParallelismPolicy::None) {
+      selected_involved_dimensions = decode_involved_dimensions(
+          layer_spec.specific_parallellism, model_parallel_npu_group);
     } else {
       selected_involved_dimensions = general_involved_dimensions;
     }
-    Layer* l = new Layer(
-        id,
+    layers[i] = new Layer(
+        &layer_spec,
         i,
         generator,
         this,
-        fp_compute_time * generator->compute_scale,
-        fp_type,
-        fp_comm_size * generator->comm_scale,
         selected_involved_dimensions["fwd"],
-        ig_compute_time * generator->compute_scale,
-        ig_type,
-        ig_comm_size * generator->comm_scale,
         selected_involved_dimensions["ig"],
-        wg_compute_time * generator->compute_scale,
-        wg_type,
-        wg_comm_size * generator->comm_scale,
-        selected_involved_dimensions["wg"],
-        wg_update_time,
-        specific_policy);
-    if (chekpoints.find(i) != chekpoints.end()) {
-      l->is_checkpoint = true;
-    }
-    if (need_checkpoint_initiation.find(i) !=
-        need_checkpoint_initiation.end()) {
-      l->needs_fwd_in_bckwd_initiation = true;
-    }
-    layers[i] = l;
+        selected_involved_dimensions["wg"]);
   }
   if (generator->id == 0) {
-    std::cout << "type: " << type << " ,num passes: " << TOTAL_PASS
-              << " ,lines: " << lines
+    std::cout << "type: " << run_type << " ,num passes: " << TOTAL_PASS
+              << " ,lines: " << SIZE
               << " compute scale: " << generator->compute_scale
               << " ,comm scale: " << generator->comm_scale << std::endl;
   }
-  inFile.close();
   return true;
 }
 void Workload::fire() {
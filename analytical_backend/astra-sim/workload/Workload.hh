@@ -16,7 +16,9 @@ LICENSE file in the root directory of this source tree.
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <tuple>
+#include "WorkloadSpec.hh"
 #include "astra-sim/system/Callable.hh"
 
 namespace AstraSim {
@@ -31,22 +33,6 @@ class CSVWriter;
 #include "astra-sim/system/Sys.hh"
 
 namespace AstraSim {
-enum class ParallelismPolicy {
-  MicroBenchmark,
-  Data,
-  Transformer,
-  TransformerFwdInBckwd,
-  DLRM,
-  DLRMEnhanced,
-  Model,
-  HybridDataModel,
-  HybridModelData,
-  HybridCustomized,
-  DistributedInference,
-  All,
-  None
-};
-
 class Workload : Callable {
  public:
   enum class LoopState {
@@ -74,6 +60,7 @@ class Workload : Callable {
   int pass_counter;
   int pending_collectives;
   ParallelismPolicy parallelismPolicy;
+  std::shared_ptr<const WorkloadSpec> spec;
   // reports
   Tick waiting_for_comm;
   Workload(
@@ -85,7 +72,7 @@ class Workload : Callable {
       int stat_row,
       std::string path,
       bool seprate_log);
-  ParallelismPolicy decode_parallelsim(std::string parallelism);
+  static ParallelismPolicy decode_parallelsim(std::string parallelism);
   void call(EventType event, CallData* data);
   void iterate_micro_benchmark();
   void iterate_data_parallel();
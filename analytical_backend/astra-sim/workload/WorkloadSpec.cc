@@ -0,0 +1,164 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "WorkloadSpec.hh"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+#include "Workload.hh"
+
+namespace AstraSim {
+namespace {
+ComType decode_comm_type(const std::string& comm_type) {
+  if (comm_type == "ALLREDUCE") {
+    return ComType::All_Reduce;
+  } else if (comm_type == "ALLTOALL") {
+    return ComType::All_to_All;
+  } else if (comm_type == "ALLTOALLV") {
+    return ComType::All_to_Allv;
+  } else if (comm_type == "ALLREDUCEALLTOALL") {
+    return ComType::All_Reduce_All_to_All;
+  } else if (comm_type == "ALLGATHER") {
+    return ComType::All_Gather;
+  } else if (comm_type == "REDUCESCATTER") {
+    return ComType::Reduce_Scatter;
+  }
+  return ComType::None;
+}
+} // namespace
+
+std::shared_ptr<const WorkloadSpec> WorkloadSpec::load(
+    InputFiles& input_files,
+    const std::string& path,
+    double compute_scale,
+    double comm_scale) {
+  return input_files.workload_specs.get(
+      std::make_tuple(path, compute_scale, comm_scale), [&]() {
+        return std::shared_ptr<const WorkloadSpec>(
+            new WorkloadSpec(path, compute_scale, comm_scale));
+      });
+}
+
+WorkloadSpec::WorkloadSpec(
+    const std::string& path,
+    double compute_scale,
+    double comm_scale)
+    : model_parallel_npu_group(-1), dlrm_last_bottom_layer(0) {
+  std::ifstream inFile;
+  inFile.open(path);
+  if (!inFile) {
+    std::cerr << "Unable to open file: " << path << std::endl;
+    std::cerr << "######### Exiting because unable to open the workload input "
+                 "file #########"
+              << std::endl;
+    std::cerr << "This error is fatal. Please check your path and filename."
+              << std::endl;
+    exit(1);
+  }
+  inFile >> run_type;
+  parallelism_policy = Workload::decode_parallelsim(run_type);
+  if (parallelism_policy == ParallelismPolicy::TransformerFwdInBckwd ||
+      parallelism_policy == ParallelismPolicy::Transformer) {
+    std::string tmp;
+    int i;
+    inFile >> model_parallel_npu_group_name;
+    inFile >> model_parallel_npu_group;
+    if (parallelism_policy == ParallelismPolicy::TransformerFwdInBckwd) {
+      inFile >> tmp;
+      inFile >> i;
+      while (i-- > 0) {
+        int layer;
+        inFile >> layer;
+        checkpoint_layers.push_back(layer);
+      }
+      inFile >> tmp;
+      inFile >> i;
+      while (i-- > 0) {
+        int layer;
+        inFile >> layer;
+        fwd_in_bckwd_layers.push_back(layer);
+      }
+    }
+  } else if (
+      parallelism_policy == ParallelismPolicy::DLRM ||
+      parallelism_policy == ParallelismPolicy::DLRMEnhanced) {
+    inFile >> dlrm_last_bottom_layer;
+  } else if (parallelism_policy == ParallelismPolicy::None) {
+    std::cerr << "######### Exiting because unable to decode the workload "
+                 "parallelization strategy #########"
+              << std::endl;
+    inFile.close();
+    exit(1);
+  }
+
+  int lines;
+  inFile >> lines;
+  layers.resize(lines);
+  for (int i = 0; i < lines; i++) {
+    LayerSpec& layer = layers[i];
+    inFile >> layer.id;
+    inFile >> layer.dependency;
+
+    Tick fp_compute_time;
+    inFile >> fp_compute_time;
+    std::string fp_comm_type_s;
+    inFile >> fp_comm_type_s;
+    uint64_t fp_comm_size;
+    inFile >> fp_comm_size;
+
+    Tick ig_compute_time;
+    inFile >> ig_compute_time;
+    std::string ig_comm_type_s;
+    inFile >> ig_comm_type_s;
+    uint64_t ig_comm_size;
+    inFile >> ig_comm_size;
+
+    Tick wg_compute_time;
+    inFile >> wg_compute_time;
+    std::string wg_comm_type_s;
+    inFile >> wg_comm_type_s;
+    uint64_t wg_comm_size;
+    inFile >> wg_comm_size;
+
+    Tick wg_update_time;
+    inFile >> wg_update_time;
+
+    layer.fwd_pass_compute_time = fp_compute_time * compute_scale;
+    layer.fwd_pass_comm_type = decode_comm_type(fp_comm_type_s);
+    layer.fwd_pass_comm_size = fp_comm_size * comm_scale;
+    layer.input_grad_compute_time = ig_compute_time * compute_scale;
+    layer.input_grad_comm_type = decode_comm_type(ig_comm_type_s);
+    layer.input_grad_comm_size = ig_comm_size * comm_scale;
+    layer.weight_grad_compute_time = wg_compute_time * compute_scale;
+    layer.weight_grad_comm_type = decode_comm_type(wg_comm_type_s);
+    layer.weight_grad_comm_size = wg_comm_size * comm_scale;
+    layer.weight_grad_update_time = wg_update_time;
+    layer.fwd_update_time = wg_update_time;
+    layer.input_grad_update_time = wg_update_time;
+
+    layer.specific_parallellism = ParallelismPolicy::None;
+    if (parallelism_policy == ParallelismPolicy::HybridCustomized) {
+      std::string specific_parallelsim;
+      inFile >> specific_parallelsim;
+      layer.specific_parallellism =
+          Workload::decode_parallelsim(specific_parallelsim);
+    }
+    if ((parallelism_policy == ParallelismPolicy::DLRM ||
+         parallelism_policy == ParallelismPolicy::DLRMEnhanced) &&
+        i == 0) {
+      layer.specific_parallellism = ParallelismPolicy::All;
+    }
+    layer.is_checkpoint =
+        std::find(checkpoint_layers.begin(), checkpoint_layers.end(), i) !=
+        checkpoint_layers.end();
+    layer.needs_fwd_in_bckwd_initiation =
+        std::find(
+            fwd_in_bckwd_layers.begin(), fwd_in_bckwd_layers.end(), i) !=
+        fwd_in_bckwd_layers.end();
+  }
+  inFile.close();
+}
+} // namespace AstraSim
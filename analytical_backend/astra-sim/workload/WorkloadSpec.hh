@@ -0,0 +1,114 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __WORKLOADSPEC_HH__
+#define __WORKLOADSPEC_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "astra-sim/system/Common.hh"
+#include "astra-sim/system/InputFiles.hh"
+
+namespace AstraSim {
+enum class ParallelismPolicy {
+  MicroBenchmark,
+  Data,
+  Transformer,
+  TransformerFwdInBckwd,
+  DLRM,
+  DLRMEnhanced,
+  Model,
+  HybridDataModel,
+  HybridModelData,
+  HybridCustomized,
+  DistributedInference,
+  All,
+  None
+};
+
+/**
+ * Static parameters of one layer of a workload (see Layer), with compute
+ * times and communication sizes already scaled.
+ */
+struct LayerSpec {
+  std::string id;
+  int dependency;
+
+  Tick fwd_pass_compute_time;
+  ComType fwd_pass_comm_type;
+  uint64_t fwd_pass_comm_size;
+  Tick fwd_update_time;
+
+  Tick input_grad_compute_time;
+  ComType input_grad_comm_type;
+  uint64_t input_grad_comm_size;
+  Tick input_grad_update_time;
+
+  Tick weight_grad_compute_time;
+  ComType weight_grad_comm_type;
+  uint64_t weight_grad_comm_size;
+  Tick weight_grad_update_time;
+
+  bool needs_fwd_in_bckwd_initiation;
+  bool is_checkpoint;
+  ParallelismPolicy specific_parallellism;
+};
+
+/**
+ * Parsed workload input file.
+ *
+ * A file is parsed once per InputFiles and pair of compute and communication
+ * scales: every NPU and run of a sweep builds its Workload on the
+ * same read-only spec, and its Layer objects only keep their runtime state.
+ */
+class WorkloadSpec {
+ public:
+  /**
+   * Get the spec of a workload input file, parsing it on first use.
+   * Exits if the file cannot be read or its parallelization strategy is
+   * unknown.
+   * @param input_files parsed files of the simulation
+   * @param path workload input file
+   * @param compute_scale factor of the compute times
+   * @param comm_scale factor of the communication sizes
+   * @return shared spec
+   */
+  static std::shared_ptr<const WorkloadSpec> load(
+      InputFiles& input_files,
+      const std::string& path,
+      double compute_scale,
+      double comm_scale);
+
+  std::string run_type;
+  ParallelismPolicy parallelism_policy;
+
+  /**
+   * Transformer workloads: NPUs of a model-parallel group, and the name of
+   * that variable in the file
+   */
+  std::string model_parallel_npu_group_name;
+  int model_parallel_npu_group;
+
+  /**
+   * TransformerFwdInBckwd workloads, as listed in the file
+   */
+  std::vector<int> checkpoint_layers;
+  std::vector<int> fwd_in_bckwd_layers;
+
+  /**
+   * DLRM workloads
+   */
+  int dlrm_last_bottom_layer;
+
+  std::vector<LayerSpec> layers;
+
+ private:
+  WorkloadSpec(const std::string& path, double compute_scale, double comm_scale);
+};
+} // namespace AstraSim
+
+#endif
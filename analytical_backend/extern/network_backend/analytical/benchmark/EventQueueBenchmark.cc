@@ -0,0 +1,131 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+// Microbenchmark of the EventQueue engines (classic "hold" model).
+// `pending_count` events are kept in flight: every event, when run, schedules
+// one new event at current_time + random delta. Deltas are quantized so that
+// many events share a time_stamp, like chunk-heavy All-to-All runs do.
+// Both engines must execute events in exactly the same order; a checksum of
+// the execution order is compared for each configuration.
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "extern/network_backend/analytical/src/event-queue/EventQueue.hh"
+
+namespace {
+struct HoldModel {
+  Analytical::EventQueue* event_queue;
+  std::mt19937_64 rng;
+  std::uniform_int_distribution<int> delta_distribution;
+  uint64_t events_to_run;
+  uint64_t events_run;
+  uint64_t checksum;
+};
+
+struct HoldEvent {
+  HoldModel* model;
+  uint64_t event_id;
+};
+
+void hold_event_handler(void* fun_arg) {
+  auto event = (HoldEvent*)fun_arg;
+  auto model = event->model;
+  auto current_time = model->event_queue->get_current_time();
+
+  // order-sensitive checksum of (time, event_id)
+  model->checksum = model->checksum * 1000003 +
+      (uint64_t)current_time.time_val * 31 + event->event_id;
+  model->events_run++;
+
+  if (model->events_run >= model->events_to_run) {
+    return;
+  }
+
+  // reschedule this event (hold)
+  auto delta = model->delta_distribution(model->rng);
+  auto event_time = current_time;
+  event_time.time_val += delta * 100; // quantize into 100ns buckets
+  event->event_id += 1'000'000;
+  model->event_queue->add_event(event_time, &hold_event_handler, event);
+}
+
+struct BenchmarkResult {
+  double seconds;
+  uint64_t events_run;
+  uint64_t checksum;
+};
+
+BenchmarkResult run_hold_model(
+    Analytical::EventQueue::EngineType engine_type,
+    int pending_count,
+    uint64_t events_to_run) {
+  auto event_queue = Analytical::EventQueue(engine_type);
+  auto model = HoldModel{
+      &event_queue,
+      std::mt19937_64(2025),
+      std::uniform_int_distribution<int>(0, pending_count),
+      events_to_run,
+      0,
+      0};
+  auto events = std::vector<HoldEvent>(pending_count);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < pending_count; i++) {
+    events[i] = HoldEvent{&model, (uint64_t)i};
+    auto event_time = event_queue.get_current_time();
+    event_time.time_val += model.delta_distribution(model.rng) * 100;
+    event_queue.add_event(event_time, &hold_event_handler, &events[i]);
+  }
+  while (!event_queue.empty()) {
+    event_queue.proceed();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  auto seconds = std::chrono::duration<double>(end - start).count();
+  return {seconds, model.events_run, model.checksum};
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  using EngineType = Analytical::EventQueue::EngineType;
+
+  uint64_t events_to_run = 200'000;
+  if (argc > 1) {
+    events_to_run = std::stoull(argv[1]);
+  }
+
+  std::cout << "[EventQueueBenchmark] hold model, " << events_to_run
+            << " events per run" << std::endl;
+  std::cout << std::setw(10) << "pending" << std::setw(16) << "list (Mev/s)"
+            << std::setw(16) << "heap (Mev/s)" << std::setw(12) << "speedup"
+            << std::setw(12) << "order" << std::endl;
+
+  auto all_identical = true;
+  for (auto pending_count : {16, 128, 1024, 8192}) {
+    auto list_result =
+        run_hold_model(EngineType::List, pending_count, events_to_run);
+    auto heap_result =
+        run_hold_model(EngineType::Heap, pending_count, events_to_run);
+
+    auto identical = (list_result.checksum == heap_result.checksum) &&
+        (list_result.events_run == heap_result.events_run);
+    all_identical &= identical;
+
+    std::cout << std::setw(10) << pending_count << std::fixed
+              << std::setprecision(3) << std::setw(16)
+              << list_result.events_run / list_result.seconds / 1e6
+              << std::setw(16)
+              << heap_result.events_run / heap_result.seconds / 1e6
+              << std::setw(11) << list_result.seconds / heap_result.seconds
+              << "x" << std::setw(12) << (identical ? "same" : "DIFFERENT")
+              << std::endl;
+  }
+
+  return all_identical ? 0 : 1;
+}
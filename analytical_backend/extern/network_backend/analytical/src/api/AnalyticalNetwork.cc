@@ -7,56 +7,17 @@ LICENSE file in the root directory of this source tree.
 
 using namespace Analytical;
 
-std::shared_ptr<EventQueue> AnalyticalNetwork::event_queue;
-
-std::shared_ptr<Topology> AnalyticalNetwork::topology;
-
-SendRecvTrackingMap AnalyticalNetwork::send_recv_tracking_map;
-
-CostModel* AnalyticalNetwork::cost_model;
-
-std::shared_ptr<PayloadSizeTracker> AnalyticalNetwork::payload_size_tracker;
-
-std::string AnalyticalNetwork::stat_path;
-
-int AnalyticalNetwork::stat_row;
-
-int AnalyticalNetwork::total_stat_rows;
-
-std::shared_ptr<AstraSim::CSVWriter> AnalyticalNetwork::end_to_end_csv;
-
-std::shared_ptr<AstraSim::CSVWriter> AnalyticalNetwork::dimensional_info_csv;
-
-void AnalyticalNetwork::setEventQueue(
-    const std::shared_ptr<EventQueue>& event_queue_ptr) noexcept {
-  AnalyticalNetwork::event_queue = event_queue_ptr;
-}
-
-void AnalyticalNetwork::setTopology(
-    const std::shared_ptr<Topology>& topology_ptr) noexcept {
-  AnalyticalNetwork::topology = topology_ptr;
-}
-
-void AnalyticalNetwork::setCostModel(CostModel* const cost_model_ptr) noexcept {
-  AnalyticalNetwork::cost_model = cost_model_ptr;
-}
-
-void AnalyticalNetwork::setCsvConfiguration(
-    const std::string& stat_path,
-    int stat_row,
-    int total_stat_rows,
-    std::shared_ptr<AstraSim::CSVWriter> end_to_end_csv,
-    std::shared_ptr<AstraSim::CSVWriter> dimensional_info_csv) noexcept {
-  AnalyticalNetwork::stat_path = stat_path;
-  AnalyticalNetwork::stat_row = stat_row;
-  AnalyticalNetwork::total_stat_rows = total_stat_rows;
-  AnalyticalNetwork::end_to_end_csv = end_to_end_csv;
-  AnalyticalNetwork::dimensional_info_csv = dimensional_info_csv;
-}
-
-AnalyticalNetwork::AnalyticalNetwork(int rank, int dims_count) noexcept
-    : AstraSim::AstraNetworkAPI(rank), dims_count(dims_count) {
-  payload_size_tracker = std::make_shared<PayloadSizeTracker>(dims_count);
+AnalyticalNetwork::AnalyticalNetwork(
+    int rank,
+    int dims_count,
+    NetworkContext* context) noexcept
+    : AstraSim::AstraNetworkAPI(rank),
+      context(context),
+      dims_count(dims_count) {
+  if (context->payload_size_tracker == nullptr) {
+    context->payload_size_tracker =
+        std::make_shared<PayloadSizeTracker>(dims_count);
+  }
 }
 
 int AnalyticalNetwork::sim_comm_size(AstraSim::sim_comm comm, int* size) {
@@ -76,7 +37,7 @@ int AnalyticalNetwork::sim_init(AstraSim::AstraMemoryAPI* MEM) {
 }
 
 AstraSim::timespec_t AnalyticalNetwork::sim_get_time() {
-  return event_queue->get_current_time();
+  return context->event_queue->get_current_time();
 }
 
 void AnalyticalNetwork::sim_schedule(
@@ -90,7 +51,7 @@ void AnalyticalNetwork::sim_schedule(
   event_time.time_val += delta.time_val;
 
   // 2. schedule an event at the event_time
-  event_queue->add_event(event_time, fun_ptr, fun_arg);
+  context->event_queue->add_event(event_time, fun_ptr, fun_arg);
 }
 
 int AnalyticalNetwork::sim_send(
@@ -112,17 +73,25 @@ int AnalyticalNetwork::sim_send(
   auto used_dim = -1;
 
   std::tie(delta.time_val, used_dim) =
-      topology->send(src, dst, count, this->stream_num_ID, this->stream_count_ID, this->link_failure_scheduling_flag, this->chunk_stage, this->failure_type); // simulate src->dst and get latency
-  // accumulate total message size
+      context->topology->send(src, dst, count, this->stream_num_ID, this->stream_count_ID, this->link_failure_scheduling_flag, this->chunk_stage, this->failure_type, sim_get_time().time_val); // simulate src->dst and get latency
+  // accumulate total message size on every dimension the message crosses
   if (src == 0) {
-    payload_size_tracker->addPayloadSize(count, used_dim);
+    for (auto dim : context->topology->getRouteDimensions(src, dst)) {
+      context->payload_size_tracker->addPayloadSize(count, dim);
+    }
   }
 
-  if (send_recv_tracking_map.has_recv_operation(tag, src, dst, count)) {
+  // under symmetry reduction, dst may not be simulated: the message that
+  // arrives is the translated copy of this one at a representative
+  if (context->symmetry_reduction != nullptr) {
+    std::tie(src, dst) = context->symmetry_reduction->mirror(src, dst);
+  }
+
+  auto recv_event_handler = Event(nullptr, nullptr);
+  if (context->send_recv_tracking_map.try_match_recv(
+          tag, src, dst, count, recv_event_handler)) {
     // recv operation already issued.
     // Schedule both send and recv event handler.
-    auto recv_event_handler =
-        send_recv_tracking_map.pop_recv_event_handler(tag, src, dst, count);
     sim_schedule(delta, msg_handler, fun_arg); // update time stamp and add new event
     sim_schedule(
         delta,
@@ -141,7 +110,7 @@ int AnalyticalNetwork::sim_send(
     send_finish_time.time_val += delta.time_val;
 
     // schedule this into the tracker
-    send_recv_tracking_map.insert_send(tag, src, dst, count, send_finish_time);
+    context->send_recv_tracking_map.insert_send(tag, src, dst, count, send_finish_time);
   }
 
   return 0;
@@ -159,15 +128,15 @@ int AnalyticalNetwork::sim_recv(
   // get source id
   auto dst = sim_comm_get_rank();
 
-  if (send_recv_tracking_map.has_send_operation(tag, src, dst, count)) {
+  auto send_finish_time = AstraSim::timespec_t();
+  if (context->send_recv_tracking_map.try_match_send(
+          tag, src, dst, count, send_finish_time)) {
     // send operation already issued.
     // should compute delta
     AstraSim::timespec_t delta;
     delta.time_res = AstraSim::NS;
 
     auto current_time = sim_get_time();
-    auto send_finish_time =
-        send_recv_tracking_map.pop_send_finish_time(tag, src, dst, count);
 
     if (EventQueueEntry::compare_time_stamp(current_time, send_finish_time) <
         0) {
@@ -186,7 +155,7 @@ int AnalyticalNetwork::sim_recv(
     // send operation not issued.
     // Add recv to the tracker and wait until corresponding sim_send to be
     // invoked.
-    send_recv_tracking_map.insert_recv(
+    context->send_recv_tracking_map.insert_recv(
         tag, src, dst, count, msg_handler, fun_arg);
   }
 
@@ -195,56 +164,71 @@ int AnalyticalNetwork::sim_recv(
 
 void AnalyticalNetwork::pass_front_end_report(
     AstraSim::AstraSimDataAPI astraSimDataAPI) {
+  context->reported = true;
+  context->front_end_report = astraSimDataAPI;
+  context->reported_total_payload_size =
+      context->payload_size_tracker->totalPayloadSize();
+  context->reported_payload_size_per_dim.clear();
+  for (auto dim = 0; dim < dims_count; dim++) {
+    context->reported_payload_size_per_dim.emplace_back(
+        context->payload_size_tracker->payloadSizeThroughDim(dim));
+  }
+  if (context->end_to_end_csv == nullptr) {
+    return;
+  }
+
   auto run_name = astraSimDataAPI.run_name;
   auto running_time = std::to_string(astraSimDataAPI.workload_finished_time);
   auto compute_time = std::to_string(astraSimDataAPI.total_compute);
   auto exposed_comm_time = std::to_string(astraSimDataAPI.total_exposed_comm);
-  auto total_cost = std::to_string(cost_model->computeTotalCost());
+  auto total_cost = std::to_string(context->cost_model->computeTotalCost());
   auto total_payload_size =
-      AnalyticalNetwork::payload_size_tracker->totalPayloadSize();
+      context->payload_size_tracker->totalPayloadSize();
   auto total_payload_size_str =
       std::to_string((double)total_payload_size / (1024 * 1024)); // in MB
 
-  AnalyticalNetwork::end_to_end_csv->write_cell(stat_row + 1, 0, run_name);
-  AnalyticalNetwork::end_to_end_csv->write_cell(stat_row + 1, 1, running_time);
-  AnalyticalNetwork::end_to_end_csv->write_cell(stat_row + 1, 2, compute_time);
-  AnalyticalNetwork::end_to_end_csv->write_cell(
-      stat_row + 1, 3, exposed_comm_time);
-  AnalyticalNetwork::end_to_end_csv->write_cell(stat_row + 1, 4, total_cost);
-  AnalyticalNetwork::end_to_end_csv->write_cell(
-      stat_row + 1, 5, total_payload_size_str);
+  context->end_to_end_csv->write_cell(context->stat_row + 1, 0, run_name);
+  context->end_to_end_csv->write_cell(context->stat_row + 1, 1, running_time);
+  context->end_to_end_csv->write_cell(context->stat_row + 1, 2, compute_time);
+  context->end_to_end_csv->write_cell(
+      context->stat_row + 1, 3, exposed_comm_time);
+  context->end_to_end_csv->write_cell(context->stat_row + 1, 4, total_cost);
+  context->end_to_end_csv->write_cell(
+      context->stat_row + 1, 5, total_payload_size_str);
 
   for (auto dim = 0; dim < dims_count; dim++) {
     auto payload_size_through_dim =
-        (double)payload_size_tracker->payloadSizeThroughDim(dim) /
+        (double)context->payload_size_tracker->payloadSizeThroughDim(dim) /
         (1024 * 1024); // in MB
-    AnalyticalNetwork::end_to_end_csv->write_cell(
-        stat_row + 1, (6 + dim), std::to_string(payload_size_through_dim));
+    context->end_to_end_csv->write_cell(
+        context->stat_row + 1,
+        (6 + dim),
+        std::to_string(payload_size_through_dim));
   }
   for (auto dim = dims_count; dim < 7; dim++) {
-    AnalyticalNetwork::end_to_end_csv->write_cell(
-        stat_row + 1, (6 + dim), "-1");
+    context->end_to_end_csv->write_cell(
+        context->stat_row + 1, (6 + dim), "-1");
   }
 
   auto chunk_latencies =
       astraSimDataAPI.avg_chunk_latency_per_logical_dimension;
   // fixme: assuming max_dimension is 10
   // fixme: dimensions_count for every topology differs
-  auto base_index = (stat_row * 10) + 1;
+  auto base_index = (context->stat_row * 10) + 1;
   for (auto i = 0; i < chunk_latencies.size(); i++) {
     auto row_to_write = base_index + i;
     auto dimension_id = std::to_string(i);
     auto chunk_latency = std::to_string(chunk_latencies[i]);
 
-    AnalyticalNetwork::dimensional_info_csv->write_cell(
+    context->dimensional_info_csv->write_cell(
         row_to_write, 0, run_name);
-    AnalyticalNetwork::dimensional_info_csv->write_cell(
+    context->dimensional_info_csv->write_cell(
         row_to_write, 1, dimension_id);
-    AnalyticalNetwork::dimensional_info_csv->write_cell(
+    context->dimensional_info_csv->write_cell(
         row_to_write, 2, chunk_latency);
   }
 }
 
 double AnalyticalNetwork::get_BW_at_dimension(int dim) {
-  return AnalyticalNetwork::topology->getNpuTotalBandwidthPerDim(dim); // GB/s
+  return context->topology->getNpuTotalBandwidthPerDim(dim); // GB/s
 }
\ No newline at end of file
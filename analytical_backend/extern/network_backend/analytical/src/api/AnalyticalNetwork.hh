@@ -7,11 +7,7 @@ LICENSE file in the root directory of this source tree.
 #define __ANALYTICALNETWORK_HH__
 
 #include <memory>
-#include "../event-queue/EventQueue.hh"
-#include "../topology/CostModel.hh"
-#include "../topology/Topology.hh"
-#include "PayloadSizeTracker.hh"
-#include "SendRecvTrackingMap.hh"
+#include "NetworkContext.hh"
 #include "astra-sim/system/AstraNetworkAPI.hh"
 #include "astra-sim/system/AstraSimDataAPI.hh"
 #include "astra-sim/workload/CSVWriter.hh"
@@ -20,42 +16,16 @@ LICENSE file in the root directory of this source tree.
 namespace Analytical {
 class AnalyticalNetwork : public AstraSim::AstraNetworkAPI {
  public:
-  /**
-   * set event_queue to the given pointer.
-   * @param new_event_queue pointer to the new event_queue
-   */
-  static void setEventQueue(
-      const std::shared_ptr<EventQueue>& event_queue_ptr) noexcept;
-
-  /**
-   * set topology to the given pointer
-   * @param new_topology pointer to the new topology
-   */
-  static void setTopology(
-      const std::shared_ptr<Topology>& topology_ptr) noexcept;
-
-  static void setCostModel(CostModel* const cost_model_ptr) noexcept;
-
-  /**
-   * Set static values for backend CSV logging
-   * @param stat_path
-   * @param stat_row
-   * @param total_stat_rows
-   * @param end_to_end_csv
-   * @param dimensional_info_csv
-   */
-  static void setCsvConfiguration(
-      const std::string& stat_path,
-      int stat_row,
-      int total_stat_rows,
-      std::shared_ptr<AstraSim::CSVWriter> end_to_end_csv,
-      std::shared_ptr<AstraSim::CSVWriter> dimensional_info_csv) noexcept;
-
   /**
    * ========================= AstraNetworkAPIs
    * =================================================
    */
-  AnalyticalNetwork(int rank, int dims_count) noexcept;
+  /**
+   * @param rank NPU id
+   * @param dims_count number of dimensions
+   * @param context network state of the simulation this NPU belongs to
+   */
+  AnalyticalNetwork(int rank, int dims_count, NetworkContext* context) noexcept;
 
   int sim_comm_size(AstraSim::sim_comm comm, int* size) override;
 
@@ -102,17 +72,7 @@ class AnalyticalNetwork : public AstraSim::AstraNetworkAPI {
   
 
  private:
-  static std::shared_ptr<EventQueue> event_queue;
-  static std::shared_ptr<Topology> topology;
-  static SendRecvTrackingMap send_recv_tracking_map;
-  static CostModel* cost_model;
-  static std::shared_ptr<PayloadSizeTracker> payload_size_tracker;
-
-  static std::string stat_path;
-  static int stat_row;
-  static int total_stat_rows;
-  static std::shared_ptr<AstraSim::CSVWriter> end_to_end_csv;
-  static std::shared_ptr<AstraSim::CSVWriter> dimensional_info_csv;
+  NetworkContext* context;
 
   int dims_count;
 };
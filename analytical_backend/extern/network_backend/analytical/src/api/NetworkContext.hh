@@ -0,0 +1,66 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __NETWORKCONTEXT_HH__
+#define __NETWORKCONTEXT_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../event-queue/EventQueue.hh"
+#include "../topology/CostModel.hh"
+#include "../topology/SymmetryReduction.hh"
+#include "../topology/Topology.hh"
+#include "PayloadSizeTracker.hh"
+#include "SendRecvTrackingMap.hh"
+#include "astra-sim/system/AstraSimDataAPI.hh"
+#include "astra-sim/workload/CSVWriter.hh"
+
+namespace Analytical {
+/**
+ * Network-side state shared by all AnalyticalNetwork instances (NPUs) of one
+ * simulation. Each simulation owns its own NetworkContext, next to the
+ * system-layer AstraSim::SimulationContext.
+ */
+struct NetworkContext {
+ public:
+  std::shared_ptr<EventQueue> event_queue;
+  std::shared_ptr<Topology> topology;
+  SendRecvTrackingMap send_recv_tracking_map;
+  CostModel* cost_model = nullptr;
+
+  /**
+   * set if only orbit representatives are simulated: messages are delivered
+   * to the representative receiving their translated copy
+   */
+  std::shared_ptr<SymmetryReduction> symmetry_reduction;
+
+  /**
+   * payload accumulated by NPU 0 (created by the first AnalyticalNetwork)
+   */
+  std::shared_ptr<PayloadSizeTracker> payload_size_tracker;
+
+  /**
+   * front-end report of NPU 0 and its payload sizes at that time
+   * (set once the workload finishes)
+   */
+  bool reported = false;
+  AstraSim::AstraSimDataAPI front_end_report;
+  PayloadSizeTracker::PayloadSize reported_total_payload_size = 0;
+  std::vector<PayloadSizeTracker::PayloadSize> reported_payload_size_per_dim;
+
+  /**
+   * backend CSV logging
+   * (CSVs are not written if end_to_end_csv is not set)
+   */
+  std::string stat_path;
+  int stat_row = 0;
+  int total_stat_rows = 1;
+  std::shared_ptr<AstraSim::CSVWriter> end_to_end_csv;
+  std::shared_ptr<AstraSim::CSVWriter> dimensional_info_csv;
+};
+} // namespace Analytical
+
+#endif
@@ -6,83 +6,90 @@ LICENSE file in the root directory of this source tree.
 #include "SendRecvTrackingMap.hh"
 
 #include <cassert>
+#include <iostream>
 
-bool Analytical::SendRecvTrackingMap::has_send_operation(
+namespace {
+// initial slots count (must be a power of 2)
+constexpr size_t initial_slots_count = 1024;
+} // namespace
+
+Analytical::SendRecvTrackingMap::SendRecvTrackingMap() noexcept
+    : slots(initial_slots_count, Slot{{0, 0}, -1, -1}),
+      slot_mask(initial_slots_count - 1),
+      occupied_slots_count(0),
+      pending_operations_count(0) {}
+
+Analytical::SendRecvTrackingMap::Key Analytical::SendRecvTrackingMap::make_key(
     int tag,
     int src,
     int dest,
-    PayloadSize count) const noexcept {
-  auto search_result =
-      send_recv_tracking_map.find(std::make_tuple(tag, src, dest, count));
-
-  if (search_result == send_recv_tracking_map.end()) {
-    // no matching entry found
-    return false;
+    PayloadSize count) noexcept {
+  if (src < 0 || src > 0xFFFF || dest < 0 || dest > 0xFFFF) {
+    // packing an out-of-range id would silently alias another NPU's key
+    std::cout << "[SendRecvTrackingMap] Error: NPU id (src " << src
+              << ", dest " << dest << ") does not fit into 16 bits"
+              << std::endl;
+    exit(-1);
   }
 
-  // check if the found entry is send operation
-  return search_result->second.is_send();
+  auto low = ((uint64_t)(uint32_t)tag << 32) |
+      ((uint64_t)(uint16_t)src << 16) | (uint64_t)(uint16_t)dest;
+  return {(uint64_t)count, low};
 }
 
-bool Analytical::SendRecvTrackingMap::has_recv_operation(
-    int tag,
-    int src,
-    int dest,
-    PayloadSize count) const noexcept {
-  auto search_result =
-      send_recv_tracking_map.find(std::make_tuple(tag, src, dest, count));
+uint64_t Analytical::SendRecvTrackingMap::hash(const Key& key) noexcept {
+  // splitmix64 finalizer over both halves
+  auto mix = [](uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  };
+  return mix(key.low ^ mix(key.high));
+}
 
-  if (search_result == send_recv_tracking_map.end()) {
-    // no matching entry found
-    return false;
+size_t Analytical::SendRecvTrackingMap::probe(const Key& key) const noexcept {
+  auto index = hash(key) & slot_mask;
+  while (slots[index].head != -1 && !(slots[index].key == key)) {
+    index = (index + 1) & slot_mask;
   }
-
-  // check if the found entry is recv operation
-  return search_result->second.is_recv();
+  return index;
 }
 
-AstraSim::timespec_t Analytical::SendRecvTrackingMap::pop_send_finish_time(
+bool Analytical::SendRecvTrackingMap::try_match_send(
     int tag,
     int src,
     int dest,
-    PayloadSize count) noexcept {
-  assert(
-      has_send_operation(tag, src, dest, count) &&
-      "<SendRecvTrackingMap::pop_send_finish_time> no matching entry");
-
-  auto send_entry =
-      send_recv_tracking_map.find(std::make_tuple(tag, src, dest, count));
-
-  // move sim_finish_time
-  auto sim_finish_time = std::move(send_entry->second.get_send_finish_time());
-
-  // pop entry
-  send_recv_tracking_map.erase(send_entry);
+    PayloadSize count,
+    AstraSim::timespec_t& send_finish_time) noexcept {
+  auto slot_index = probe(make_key(tag, src, dest, count));
+  auto head = slots[slot_index].head;
+  if (head == -1 || !nodes[head].value.is_send()) {
+    // no pending send with this key
+    return false;
+  }
 
-  // return saved
-  return sim_finish_time;
+  send_finish_time = pop_front(slot_index).get_send_finish_time();
+  return true;
 }
 
-Analytical::Event Analytical::SendRecvTrackingMap::pop_recv_event_handler(
+bool Analytical::SendRecvTrackingMap::try_match_recv(
     int tag,
     int src,
     int dest,
-    PayloadSize count) noexcept {
-  assert(
-      has_recv_operation(tag, src, dest, count) &&
-      "<SendRecvTrackingMap::pop_recv_event_handler> no matching entry");
-
-  auto recv_entry =
-      send_recv_tracking_map.find(std::make_tuple(tag, src, dest, count));
-
-  // move event handler
-  auto event = std::move(recv_entry->second.get_recv_event());
-
-  // pop entry
-  send_recv_tracking_map.erase(recv_entry);
+    PayloadSize count,
+    Event& recv_event_handler) noexcept {
+  auto slot_index = probe(make_key(tag, src, dest, count));
+  auto head = slots[slot_index].head;
+  if (head == -1 || !nodes[head].value.is_recv()) {
+    // no pending recv with this key
+    return false;
+  }
 
-  // return saved
-  return event;
+  recv_event_handler = pop_front(slot_index).get_recv_event();
+  return true;
 }
 
 void Analytical::SendRecvTrackingMap::insert_send(
@@ -91,9 +98,8 @@ void Analytical::SendRecvTrackingMap::insert_send(
     int dest,
     PayloadSize count,
     AstraSim::timespec_t send_finish_time) noexcept {
-
-  send_recv_tracking_map.emplace(
-      std::make_tuple(tag, src, dest, count),
+  push_back(
+      make_key(tag, src, dest, count),
       SendRecvTrackingMapValue::make_send_value(send_finish_time));
 }
 
@@ -104,17 +110,96 @@ void Analytical::SendRecvTrackingMap::insert_recv(
     PayloadSize count,
     void (*fun_ptr)(void*),
     void* fun_arg) noexcept {
-  assert(
-      (send_recv_tracking_map.find(std::make_tuple(tag, src, dest, count)) ==
-       send_recv_tracking_map.end()) &&
-      "<SendRecvTrackingMap::insert_recv> Same key entry already exist.");
-
-  send_recv_tracking_map.emplace(
-      std::make_tuple(tag, src, dest, count),
+  push_back(
+      make_key(tag, src, dest, count),
       SendRecvTrackingMapValue::make_recv_value(fun_ptr, fun_arg));
 }
 
+void Analytical::SendRecvTrackingMap::push_back(
+    const Key& key,
+    SendRecvTrackingMapValue value) noexcept {
+  // keep load factor <= 0.5
+  if ((occupied_slots_count + 1) * 2 > slots.size()) {
+    grow();
+  }
+
+  // allocate node
+  auto node_index = 0;
+  if (free_nodes.empty()) {
+    node_index = nodes.size();
+    nodes.push_back({value, -1});
+  } else {
+    node_index = free_nodes.back();
+    free_nodes.pop_back();
+    nodes[node_index] = {value, -1};
+  }
+
+  auto& slot = slots[probe(key)];
+  if (slot.head == -1) {
+    // new key
+    slot = {key, node_index, node_index};
+    occupied_slots_count++;
+  } else {
+    assert(
+        (nodes[slot.head].value.is_send() == value.is_send()) &&
+        "<SendRecvTrackingMap::push_back> Opposite operation with same key is pending.");
+    nodes[slot.tail].next = node_index;
+    slot.tail = node_index;
+  }
+  pending_operations_count++;
+}
+
+Analytical::SendRecvTrackingMapValue Analytical::SendRecvTrackingMap::pop_front(
+    size_t slot_index) noexcept {
+  auto& slot = slots[slot_index];
+  auto node_index = slot.head;
+  auto value = nodes[node_index].value;
+
+  free_nodes.push_back(node_index);
+  pending_operations_count--;
+
+  if (nodes[node_index].next != -1) {
+    slot.head = nodes[node_index].next;
+    return value;
+  }
+
+  // FIFO drained: remove the slot with backward-shift deletion
+  occupied_slots_count--;
+  auto hole = slot_index;
+  auto index = slot_index;
+  while (true) {
+    index = (index + 1) & slot_mask;
+    if (slots[index].head == -1) {
+      break;
+    }
+    auto home = hash(slots[index].key) & slot_mask;
+    // move slots[index] into the hole if its home is not in (hole, index]
+    auto distance_to_home = (index - home) & slot_mask;
+    auto distance_to_hole = (index - hole) & slot_mask;
+    if (distance_to_home >= distance_to_hole) {
+      slots[hole] = slots[index];
+      hole = index;
+    }
+  }
+  slots[hole].head = -1;
+  slots[hole].tail = -1;
+
+  return value;
+}
+
+void Analytical::SendRecvTrackingMap::grow() noexcept {
+  auto old_slots = std::move(slots);
+  slots = std::vector<Slot>(old_slots.size() * 2, Slot{{0, 0}, -1, -1});
+  slot_mask = slots.size() - 1;
+
+  for (const auto& slot : old_slots) {
+    if (slot.head != -1) {
+      slots[probe(slot.key)] = slot;
+    }
+  }
+}
+
 void Analytical::SendRecvTrackingMap::print() const noexcept {
   std::cout << "[SendRecvTrackingMap] Entries not processed: "
-            << send_recv_tracking_map.size() << std::endl;
+            << pending_operations_count << std::endl;
 }
@@ -6,8 +6,8 @@ LICENSE file in the root directory of this source tree.
 #ifndef __SENDRECVTRACKINGMAP_HH__
 #define __SENDRECVTRACKINGMAP_HH__
 
-#include <map>
-#include <tuple>
+#include <cstdint>
+#include <vector>
 #include "SendRecvTrackingMapValue.hh"
 #include "../topology/TopologyConfig.hh"
 #include "astra-sim/system/AstraNetworkAPI.hh"
@@ -17,56 +17,46 @@ class SendRecvTrackingMap {
  public:
   using PayloadSize = TopologyConfig::PayloadSize;
 
-  /**
-   * Check whether send operation with given key entry exists.
-   * @param tag
-   * @param src
-   * @param dest
-   * @param count
-   * @return true if send operation exists, false if not
-   */
-  bool has_send_operation(int tag, int src, int dest, PayloadSize count) const noexcept;
+  SendRecvTrackingMap() noexcept;
 
   /**
-   * Check whether recv operation with given key entry exists.
+   * Match an incoming recv against the oldest pending send with given key.
+   * If found, the send entry is removed and its send_finish_time is returned.
    * @param tag
    * @param src
    * @param dest
    * @param count
-   * @return true if recv operation exists, false if not
+   * @param send_finish_time [out] send_finish_time of the matched send
+   * @return true if a pending send was matched, false if not
    */
-  bool has_recv_operation(int tag, int src, int dest, PayloadSize count) const noexcept;
-
-  /**
-   * Remove the send operation entry with given key, and return send_finish_time
-   * value. Assertion: send_operation with given key must exist.
-   * @param tag
-   * @param src
-   * @param dest
-   * @param count
-   * @return send_finish_time value
-   */
-  AstraSim::timespec_t pop_send_finish_time(
+  bool try_match_send(
       int tag,
       int src,
       int dest,
-      PayloadSize count) noexcept;
+      PayloadSize count,
+      AstraSim::timespec_t& send_finish_time) noexcept;
 
   /**
-   * Remove the recv operation entry with given key, and return
-   * recv_event_handler value. Assertion: recv operation with given key must
-   * exist.
+   * Match an incoming send against the oldest pending recv with given key.
+   * If found, the recv entry is removed and its event handler is returned.
    * @param tag
    * @param src
    * @param dest
    * @param count
-   * @return recv_event_handler
+   * @param recv_event_handler [out] event handler of the matched recv
+   * @return true if a pending recv was matched, false if not
    */
-  Event pop_recv_event_handler(int tag, int src, int dest, PayloadSize count) noexcept;
+  bool try_match_recv(
+      int tag,
+      int src,
+      int dest,
+      PayloadSize count,
+      Event& recv_event_handler) noexcept;
 
   /**
-   * Insert a new send operation with given key.
-   *      Assertion: given key entry should not exist in the map
+   * Append a new send operation to the FIFO of given key.
+   *      Assertion: no recv operation with given key is pending
+   *      (call try_match_recv first).
    * @param tag
    * @param src
    * @param dest
@@ -81,8 +71,9 @@ class SendRecvTrackingMap {
       AstraSim::timespec_t send_finish_time) noexcept;
 
   /**
-   * Insert a new recv operation with given key.
-   *      Assertion: given key entry should not exist in the map.
+   * Append a new recv operation to the FIFO of given key.
+   *      Assertion: no send operation with given key is pending
+   *      (call try_match_send first).
    * @param tag
    * @param src
    * @param dest
@@ -105,15 +96,65 @@ class SendRecvTrackingMap {
 
  private:
   /**
-   * tag, src, dest, count
+   * (tag, src, dest, count) packed into 128 bits:
+   *   high: count
+   *   low:  tag (32 bits) | src (16 bits) | dest (16 bits)
+   * make_key exits if src or dest does not fit into 16 bits.
+   */
+  struct Key {
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const Key& other) const noexcept {
+      return high == other.high && low == other.low;
+    }
+  };
+
+  /**
+   * One open-addressing slot: key and the FIFO of operations waiting on it.
+   * All operations queued on one key have the same type (send or recv).
    */
-  typedef std::tuple<int, int, int, PayloadSize> Key;
+  struct Slot {
+    Key key;
+    int head; // index into nodes, -1 if the slot is empty
+    int tail;
+  };
 
   /**
-   * Send and recv tracking map
-   * (tag, src, dest, count) -> Value
+   * FIFO node, linked through `next` (index into nodes, -1 for the last one).
    */
-  std::map<Key, SendRecvTrackingMapValue> send_recv_tracking_map;
+  struct Node {
+    SendRecvTrackingMapValue value;
+    int next;
+  };
+
+  static Key make_key(int tag, int src, int dest, PayloadSize count) noexcept;
+
+  static uint64_t hash(const Key& key) noexcept;
+
+  /**
+   * Linear probing: slot index holding key, or the empty slot where it would
+   * be inserted.
+   */
+  size_t probe(const Key& key) const noexcept;
+
+  /**
+   * Pop the oldest operation queued at slot_index.
+   * Removes the slot (backward-shift deletion) once its FIFO drains.
+   */
+  SendRecvTrackingMapValue pop_front(size_t slot_index) noexcept;
+
+  void push_back(const Key& key, SendRecvTrackingMapValue value) noexcept;
+
+  void grow() noexcept;
+
+  std::vector<Slot> slots;
+  size_t slot_mask;
+  size_t occupied_slots_count;
+
+  std::vector<Node> nodes;
+  std::vector<int> free_nodes;
+  size_t pending_operations_count;
 };
 } // namespace Analytical
 
@@ -4,41 +4,37 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "EventQueue.hh"
+#include "HeapEventQueueEngine.hh"
+#include "ListEventQueueEngine.hh"
+
+Analytical::EventQueue::EventQueue(EngineType engine_type) noexcept {
+  current_time.time_res = AstraSim::NS;
+  current_time.time_val = 0;
+
+  switch (engine_type) {
+    case EngineType::List:
+      engine = std::make_unique<ListEventQueueEngine>();
+      break;
+    case EngineType::Heap:
+    default:
+      engine = std::make_unique<HeapEventQueueEngine>();
+      break;
+  }
+}
 
 void Analytical::EventQueue::add_event(
     AstraSim::timespec_t time_stamp,
     void (*fun_ptr)(void*),
     void* fun_arg) noexcept {
-  // Event Queue is ordered by time_stamp in ascending order.
-  // 1. Search Event queue:
-  //      (1) if time_stamp is smaller, search next entry
-  //      (2) if time_stamp is equal, add event to that entry
-  //      (3) if time_stamp is larger, it means no entry matches time_stamp
-  //            -> insert new event queue element
+  engine->add_event(time_stamp, fun_ptr, fun_arg);
+}
 
-  for (auto it = event_queue.begin(); it != event_queue.end(); it++) {
-    auto time_stamp_compare_result =
-        EventQueueEntry::compare_time_stamp(it->get_time_stamp(), time_stamp);
-    // if time_stamp is smaller, do nothing
-    if (time_stamp_compare_result == 0) {
-      // equal time_stamp -> insert event here
-      it->add_event(fun_ptr, fun_arg);
-      return;
-    } else if (time_stamp_compare_result > 0) {
-      // entry's time stamp is larger -> no matching queue entry found
-      // insert new queue entry
-      auto new_queue_entry = event_queue.emplace(it, time_stamp);
-      new_queue_entry->add_event(fun_ptr, fun_arg);
-      return;
-    }
+void Analytical::EventQueue::set_clock(
+    AstraSim::SimulationClock* clock) noexcept {
+  this->clock = clock;
+  if (clock != nullptr) {
+    clock->set_time(current_time);
   }
-
-  // flow falls here when
-  // (1) event queue was empty
-  // (2) given time_stamp is larger than largest entry
-  //      -> for both cases, create new entry at the end of the event_queue
-  event_queue.emplace_back(time_stamp);
-  event_queue.back().add_event(fun_ptr, fun_arg);
 }
 
 AstraSim::timespec_t Analytical::EventQueue::get_current_time() const noexcept {
@@ -46,28 +42,28 @@ AstraSim::timespec_t Analytical::EventQueue::get_current_time() const noexcept {
 }
 
 void Analytical::EventQueue::proceed() noexcept {
-  auto& event_queue_entry = event_queue.front();
-
-  // proceed current time
-  current_time = event_queue_entry.get_time_stamp();
-
-  // run events
-  event_queue_entry.run_events();
-
-  // remove queue entry
-  event_queue.pop_front();
+  if (clock != nullptr) {
+    clock->set_time(engine->get_next_time_stamp());
+  }
+  engine->proceed(current_time);
 }
 
 bool Analytical::EventQueue::empty() const noexcept {
-  return event_queue.empty();
+  return engine->empty();
+}
+
+AstraSim::timespec_t Analytical::EventQueue::get_next_time_stamp()
+    const noexcept {
+  assert(
+      !engine->empty() &&
+      "<EventQueue::get_next_time_stamp> Event queue is empty.");
+  return engine->get_next_time_stamp();
 }
 
 void Analytical::EventQueue::print() const noexcept {
   std::cout << "===== event-queue =====" << std::endl;
   std::cout << "CurrentTime: " << current_time.time_val << std::endl
             << std::endl;
-  for (const auto& event_queue_entry : event_queue) {
-    event_queue_entry.print();
-  }
+  engine->print();
   std::cout << "======================" << std::endl << std::endl;
 }
@@ -7,21 +7,23 @@ LICENSE file in the root directory of this source tree.
 #define __EVENTQUEUE_HH__
 
 #include <cassert>
-#include <list>
+#include <memory>
 #include "Event.hh"
+#include "EventQueueEngine.hh"
 #include "EventQueueEntry.hh"
 #include "astra-sim/system/AstraNetworkAPI.hh"
+#include "astra-sim/system/SimulationClock.hh"
 
 namespace Analytical {
 class EventQueue {
  public:
+  using EngineType = EventQueueEngine::EngineType;
+
   /**
    * Create new event-queue.
+   * @param engine_type engine that stores and orders pending events
    */
-  EventQueue() {
-    current_time.time_res = AstraSim::NS;
-    current_time.time_val = 0;
-  }
+  explicit EventQueue(EngineType engine_type = EngineType::Heap) noexcept;
 
   /**
    * Add new event to the event-queue.
@@ -41,6 +43,13 @@ class EventQueue {
    */
   void proceed() noexcept;
 
+  /**
+   * Keep a system-layer clock at current_time: it is set now and before
+   * running each batch of events.
+   * @param clock clock to drive (nullptr to stop)
+   */
+  void set_clock(AstraSim::SimulationClock* clock) noexcept;
+
   /**
    * current_time getter
    */
@@ -53,6 +62,13 @@ class EventQueue {
    */
   bool empty() const noexcept;
 
+  /**
+   * time_stamp of the next events to be run by proceed().
+   *      Assertion: event_queue is not empty.
+   * @return earliest pending time_stamp
+   */
+  AstraSim::timespec_t get_next_time_stamp() const noexcept;
+
   /**
    * (For debugging purpose)
    * Print all EventQueueEntry in the event_queue.
@@ -66,9 +82,14 @@ class EventQueue {
   AstraSim::timespec_t current_time = AstraSim::timespec_t();
 
   /**
-   * event_queue list that holds events
+   * system-layer clock kept at current_time, if any
+   */
+  AstraSim::SimulationClock* clock = nullptr;
+
+  /**
+   * engine that holds events
    */
-  std::list<EventQueueEntry> event_queue;
+  std::unique_ptr<EventQueueEngine> engine;
 };
 } // namespace Analytical
 
@@ -0,0 +1,70 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __EVENTQUEUEENGINE_HH__
+#define __EVENTQUEUEENGINE_HH__
+
+#include "Event.hh"
+#include "EventQueueEntry.hh"
+#include "astra-sim/system/AstraNetworkAPI.hh"
+
+namespace Analytical {
+class EventQueueEngine {
+ public:
+  /**
+   * Engines that can be plugged into the EventQueue.
+   *   - List: sorted std::list, linear scan on every insert (legacy)
+   *   - Heap: binary min-heap of timestamps + hashed timestamp -> entry index
+   */
+  enum class EngineType { List, Heap };
+
+  virtual ~EventQueueEngine() noexcept = default;
+
+  /**
+   * Add new event to the engine.
+   * Events sharing the same time_stamp must be batched into a single
+   * EventQueueEntry, in insertion order.
+   *
+   * @param time_stamp time_stamp for the event
+   * @param fun_ptr pointer to the event handler
+   * @param fun_arg pointer to the event handler argument
+   */
+  virtual void add_event(
+      AstraSim::timespec_t time_stamp,
+      void (*fun_ptr)(void*),
+      void* fun_arg) noexcept = 0;
+
+  /**
+   * Fetch the earliest EventQueueEntry, update current_time, and run its
+   * events. Events added with the same time_stamp while the entry is running
+   * must be run as part of the same batch.
+   *
+   * @param current_time current_time of the owning event-queue
+   */
+  virtual void proceed(AstraSim::timespec_t& current_time) noexcept = 0;
+
+  /**
+   * Check whether the engine holds no pending entries.
+   * @return true when empty
+   *         false otherwise
+   */
+  virtual bool empty() const noexcept = 0;
+
+  /**
+   * time_stamp of the earliest pending EventQueueEntry.
+   *      Assertion: engine is not empty.
+   * @return earliest pending time_stamp
+   */
+  virtual AstraSim::timespec_t get_next_time_stamp() const noexcept = 0;
+
+  /**
+   * (For debugging purpose)
+   * Print all pending EventQueueEntry in time_stamp order.
+   */
+  virtual void print() const noexcept = 0;
+};
+} // namespace Analytical
+
+#endif
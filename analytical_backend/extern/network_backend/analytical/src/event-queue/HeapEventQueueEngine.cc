@@ -0,0 +1,60 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "HeapEventQueueEngine.hh"
+
+void Analytical::HeapEventQueueEngine::add_event(
+    AstraSim::timespec_t time_stamp,
+    void (*fun_ptr)(void*),
+    void* fun_arg) noexcept {
+  // 1. look up the entry of this time_stamp
+  //      (1) if found, add event to that entry
+  //      (2) if not, create a new entry and push its time_stamp into the heap
+  auto key = time_stamp.time_val;
+  auto search_result = entries.find(key);
+  if (search_result != entries.end()) {
+    search_result->second.add_event(fun_ptr, fun_arg);
+    return;
+  }
+
+  auto new_queue_entry = entries.emplace(key, time_stamp).first;
+  new_queue_entry->second.add_event(fun_ptr, fun_arg);
+  time_stamps.push(key);
+}
+
+void Analytical::HeapEventQueueEngine::proceed(
+    AstraSim::timespec_t& current_time) noexcept {
+  auto key = time_stamps.top();
+  time_stamps.pop();
+
+  auto& event_queue_entry = entries.find(key)->second;
+
+  // proceed current time
+  current_time = event_queue_entry.get_time_stamp();
+
+  // run events
+  event_queue_entry.run_events();
+
+  // remove queue entry
+  // (erase by key: running events may have rehashed the map)
+  entries.erase(key);
+}
+
+bool Analytical::HeapEventQueueEngine::empty() const noexcept {
+  return entries.empty();
+}
+
+AstraSim::timespec_t Analytical::HeapEventQueueEngine::get_next_time_stamp()
+    const noexcept {
+  return entries.find(time_stamps.top())->second.get_time_stamp();
+}
+
+void Analytical::HeapEventQueueEngine::print() const noexcept {
+  auto pending_time_stamps = time_stamps;
+  while (!pending_time_stamps.empty()) {
+    entries.find(pending_time_stamps.top())->second.print();
+    pending_time_stamps.pop();
+  }
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __HEAPEVENTQUEUEENGINE_HH__
+#define __HEAPEVENTQUEUEENGINE_HH__
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "EventQueueEngine.hh"
+
+namespace Analytical {
+class HeapEventQueueEngine : public EventQueueEngine {
+ public:
+  void add_event(
+      AstraSim::timespec_t time_stamp,
+      void (*fun_ptr)(void*),
+      void* fun_arg) noexcept override;
+
+  void proceed(AstraSim::timespec_t& current_time) noexcept override;
+
+  bool empty() const noexcept override;
+
+  AstraSim::timespec_t get_next_time_stamp() const noexcept override;
+
+  void print() const noexcept override;
+
+ private:
+  // assumption: time_res is always NS, so time_val alone identifies an entry
+  // (same as EventQueueEntry::compare_time_stamp)
+  using TimeKey = double;
+
+  /**
+   * min-heap of the time_stamps that own an entry in entries
+   * (each pending time_stamp is pushed exactly once)
+   */
+  std::priority_queue<TimeKey, std::vector<TimeKey>, std::greater<TimeKey>>
+      time_stamps;
+
+  /**
+   * time_stamp -> EventQueueEntry
+   * An entry stays here while its events are running, so that events
+   * scheduled for the same time_stamp join the running batch.
+   * (node-based map: references survive rehashing)
+   */
+  std::unordered_map<TimeKey, EventQueueEntry> entries;
+};
+} // namespace Analytical
+
+#endif
@@ -0,0 +1,71 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "ListEventQueueEngine.hh"
+
+void Analytical::ListEventQueueEngine::add_event(
+    AstraSim::timespec_t time_stamp,
+    void (*fun_ptr)(void*),
+    void* fun_arg) noexcept {
+  // Event Queue is ordered by time_stamp in ascending order.
+  // 1. Search Event queue:
+  //      (1) if time_stamp is smaller, search next entry
+  //      (2) if time_stamp is equal, add event to that entry
+  //      (3) if time_stamp is larger, it means no entry matches time_stamp
+  //            -> insert new event queue element
+
+  for (auto it = event_queue.begin(); it != event_queue.end(); it++) {
+    auto time_stamp_compare_result =
+        EventQueueEntry::compare_time_stamp(it->get_time_stamp(), time_stamp);
+    // if time_stamp is smaller, do nothing
+    if (time_stamp_compare_result == 0) {
+      // equal time_stamp -> insert event here
+      it->add_event(fun_ptr, fun_arg);
+      return;
+    } else if (time_stamp_compare_result > 0) {
+      // entry's time stamp is larger -> no matching queue entry found
+      // insert new queue entry
+      auto new_queue_entry = event_queue.emplace(it, time_stamp);
+      new_queue_entry->add_event(fun_ptr, fun_arg);
+      return;
+    }
+  }
+
+  // flow falls here when
+  // (1) event queue was empty
+  // (2) given time_stamp is larger than largest entry
+  //      -> for both cases, create new entry at the end of the event_queue
+  event_queue.emplace_back(time_stamp);
+  event_queue.back().add_event(fun_ptr, fun_arg);
+}
+
+void Analytical::ListEventQueueEngine::proceed(
+    AstraSim::timespec_t& current_time) noexcept {
+  auto& event_queue_entry = event_queue.front();
+
+  // proceed current time
+  current_time = event_queue_entry.get_time_stamp();
+
+  // run events
+  event_queue_entry.run_events();
+
+  // remove queue entry
+  event_queue.pop_front();
+}
+
+bool Analytical::ListEventQueueEngine::empty() const noexcept {
+  return event_queue.empty();
+}
+
+AstraSim::timespec_t Analytical::ListEventQueueEngine::get_next_time_stamp()
+    const noexcept {
+  return event_queue.front().get_time_stamp();
+}
+
+void Analytical::ListEventQueueEngine::print() const noexcept {
+  for (const auto& event_queue_entry : event_queue) {
+    event_queue_entry.print();
+  }
+}
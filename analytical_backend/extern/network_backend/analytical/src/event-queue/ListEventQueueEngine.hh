@@ -0,0 +1,36 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __LISTEVENTQUEUEENGINE_HH__
+#define __LISTEVENTQUEUEENGINE_HH__
+
+#include <list>
+#include "EventQueueEngine.hh"
+
+namespace Analytical {
+class ListEventQueueEngine : public EventQueueEngine {
+ public:
+  void add_event(
+      AstraSim::timespec_t time_stamp,
+      void (*fun_ptr)(void*),
+      void* fun_arg) noexcept override;
+
+  void proceed(AstraSim::timespec_t& current_time) noexcept override;
+
+  bool empty() const noexcept override;
+
+  AstraSim::timespec_t get_next_time_stamp() const noexcept override;
+
+  void print() const noexcept override;
+
+ private:
+  /**
+   * event_queue list that holds events, ordered by time_stamp
+   */
+  std::list<EventQueueEntry> event_queue;
+};
+} // namespace Analytical
+
+#endif
@@ -79,3 +79,11 @@ std::vector<NetworkConfigParser::Bandwidth> NetworkConfigParser::
     parseLinkBandwidthPerDim() const noexcept {
   return this->get<std::vector<Bandwidth>>("link-bandwidth");
 }
+
+std::vector<std::vector<int>> NetworkConfigParser::parseFaultyLinks()
+    const noexcept {
+  if (!json_configuration.contains("faulty-links")) {
+    return std::vector<std::vector<int>>();
+  }
+  return this->get<std::vector<std::vector<int>>>("faulty-links");
+}
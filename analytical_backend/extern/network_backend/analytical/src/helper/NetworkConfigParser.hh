@@ -36,6 +36,12 @@ class NetworkConfigParser {
 
   std::vector<Bandwidth> parseLinkBandwidthPerDim() const noexcept;
 
+  /**
+   * @return failed links given by "faulty-links" (e.g., [[2, 26], [3, 27]]),
+   * empty if the key is absent
+   */
+  std::vector<std::vector<int>> parseFaultyLinks() const noexcept;
+
  private:
   nlohmann::json json_configuration;
 };
@@ -0,0 +1,76 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "WorkStealingPool.hh"
+#include <cassert>
+#include <thread>
+
+using namespace Analytical;
+
+WorkStealingPool::WorkStealingPool(int threads_count) noexcept
+    : threads_count(threads_count), steals_count(0) {
+  assert(
+      threads_count > 0 &&
+      "<WorkStealingPool::WorkStealingPool> threads_count must be positive");
+
+  for (auto i = 0; i < threads_count; i++) {
+    queues.emplace_back(std::make_unique<WorkerQueue>());
+  }
+}
+
+void WorkStealingPool::run(std::vector<Task> tasks) noexcept {
+  for (size_t i = 0; i < tasks.size(); i++) {
+    queues[i % threads_count]->tasks.emplace_back(std::move(tasks[i]));
+  }
+
+  // the calling thread works as worker 0
+  auto workers = std::vector<std::thread>();
+  for (auto worker_id = 1; worker_id < threads_count; worker_id++) {
+    workers.emplace_back(&WorkStealingPool::work, this, worker_id);
+  }
+  work(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+uint64_t WorkStealingPool::get_steals_count() const noexcept {
+  return steals_count.load();
+}
+
+void WorkStealingPool::work(int worker_id) noexcept {
+  auto task = Task();
+  while (pop_own(worker_id, task) || steal(worker_id, task)) {
+    task();
+  }
+}
+
+bool WorkStealingPool::pop_own(int worker_id, Task& task) noexcept {
+  auto& queue = *queues[worker_id];
+  auto lock = std::lock_guard<std::mutex>(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  return true;
+}
+
+bool WorkStealingPool::steal(int worker_id, Task& task) noexcept {
+  // no task is added once run() started, so one empty sweep over all
+  // victims means the batch is drained
+  for (auto offset = 1; offset < threads_count; offset++) {
+    auto& victim = *queues[(worker_id + offset) % threads_count];
+    auto lock = std::lock_guard<std::mutex>(victim.mutex);
+    if (victim.tasks.empty()) {
+      continue;
+    }
+    task = std::move(victim.tasks.back());
+    victim.tasks.pop_back();
+    steals_count++;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __WORKSTEALINGPOOL_HH__
+#define __WORKSTEALINGPOOL_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Analytical {
+/**
+ * Fixed-size thread pool for a known batch of independent tasks.
+ *
+ * Tasks are dealt round-robin into one deque per worker. A worker takes
+ * tasks from the front of its own deque and, once that is empty, steals
+ * from the back of the other workers' deques, so a worker that drew short
+ * tasks keeps helping the ones that drew long tasks.
+ */
+class WorkStealingPool {
+ public:
+  using Task = std::function<void()>;
+
+  /**
+   * @param threads_count number of workers (the calling thread is one of
+   * them), at least 1
+   */
+  explicit WorkStealingPool(int threads_count) noexcept;
+
+  /**
+   * Run every task to completion, then return.
+   * @param tasks tasks to run; task i is first given to worker
+   * (i % threads_count)
+   */
+  void run(std::vector<Task> tasks) noexcept;
+
+  /**
+   * @return number of tasks taken from another worker's deque so far
+   */
+  uint64_t get_steals_count() const noexcept;
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  /**
+   * Main loop of worker worker_id: own tasks first, then steal until every
+   * deque is empty.
+   */
+  void work(int worker_id) noexcept;
+
+  bool pop_own(int worker_id, Task& task) noexcept;
+
+  bool steal(int worker_id, Task& task) noexcept;
+
+  int threads_count;
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::atomic<uint64_t> steals_count;
+};
+} // namespace Analytical
+
+#endif
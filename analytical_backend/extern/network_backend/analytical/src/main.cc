@@ -3,25 +3,17 @@ This source code is licensed under the MIT license found in the
 LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
-#include <array>
-#include <cassert>
-#include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <memory>
-#include "api/AnalyticalNetwork.hh"
-#include "astra-sim/system/Sys.hh"
-#include "astra-sim/system/memory/SimpleMemory.hh"
-#include "astra-sim/workload/CSVWriter.hh"
+#include <string>
+#include <thread>
 #include "event-queue/EventQueue.hh"
-#include "event-queue/EventQueueEntry.hh"
-#include "extern/network_backend/analytical/src/topology/HierarchicalTopology.hh"
-#include "extern/network_backend/analytical/src/topology/HierarchicalTopologyConfig.hh"
 #include "helper/CommandLineParser.hh"
-#include "helper/NetworkConfigParser.hh"
-#include "helper/json.hh"
-#include "topology/CostModel.hh"
-#include "topology/Topology.hh"
-#include "topology/TopologyConfig.hh"
+#include "simulation/NetworkConfig.hh"
+#include "simulation/Simulation.hh"
+#include "simulation/Sweep.hh"
+#include "simulation/SweepManifest.hh"
 
 namespace po = boost::program_options;
 
@@ -54,8 +46,30 @@ int main(int argc, char* argv[]) {
       "total-stat-rows", "Total number of concurrent runs");
   cmd_parser.add_command_line_option<int>(
       "stat-row", "Index of current run (index starts with 0)");
+  cmd_parser.add_command_line_option<bool>(
+      "csv-fragments",
+      "Write backend CSV rows into per-run files merged by the last run");
   cmd_parser.add_command_line_option<bool>(
       "rendezvous-protocol", "Whether to enable rendezvous protocol");
+  cmd_parser.add_command_line_option<std::string>(
+      "event-queue-engine", "Event queue engine (heap or list)");
+  cmd_parser.add_command_line_option<bool>(
+      "symmetry-reduction",
+      "Simulate one NPU per translation orbit when the run is symmetric");
+  cmd_parser.add_command_line_option<bool>(
+      "link-contention",
+      "Delay messages while their links are busy with other messages");
+  cmd_parser.add_command_line_option<bool>(
+      "clock-check",
+      "Check the system-layer clock against the backend time on every read");
+  cmd_parser.add_command_line_option<std::string>(
+      "estimate",
+      "Closed-form All-to-All estimate (off, only, or validate)");
+  cmd_parser.add_command_line_option<std::string>(
+      "sweep-manifest",
+      "Sweep manifest (.json or .csv): run all listed configurations");
+  cmd_parser.add_command_line_option<int>(
+      "sweep-threads", "Number of concurrent runs of a sweep");
 
   // Define network-related command line arguments here
   cmd_parser.add_command_line_multitoken_option<std::vector<int>>(
@@ -80,42 +94,73 @@ int main(int argc, char* argv[]) {
 
   cmd_parser.print_help_message_if_required();
 
-  // 1. Retrieve network-agnostic configs
-  std::string system_configuration = "system path not defined";
-  cmd_parser.set_if_defined("system-configuration", &system_configuration);
-
-  std::string workload_configuration = "workload path not defined";
-  cmd_parser.set_if_defined("workload-configuration", &workload_configuration);
-
-  int num_passes = 1;
-  cmd_parser.set_if_defined("num-passes", &num_passes);
-
-  int num_queues_per_dim = 1;
-  cmd_parser.set_if_defined("num-queues-per-dim", &num_queues_per_dim);
-
-  float comm_scale = 1;
-  cmd_parser.set_if_defined("comm-scale", &comm_scale);
-
-  float compute_scale = 1;
-  cmd_parser.set_if_defined("compute-scale", &compute_scale);
-
-  float injection_scale = 1;
-  cmd_parser.set_if_defined("injection-scale", &injection_scale);
-
-  std::string path = "path not defined";
-  cmd_parser.set_if_defined("path", &path);
-
-  std::string run_name = "unnamed run";
-  cmd_parser.set_if_defined("run-name", &run_name);
+  // Sweep mode: every run is described by the manifest
+  std::string sweep_manifest = "";
+  cmd_parser.set_if_defined("sweep-manifest", &sweep_manifest);
+  if (!sweep_manifest.empty()) {
+    int sweep_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    cmd_parser.set_if_defined("sweep-threads", &sweep_threads);
+    if (sweep_threads < 1) {
+      std::cout << "[Analytical, main] sweep-threads should be positive: "
+                << sweep_threads << std::endl;
+      exit(-1);
+    }
 
-  int total_stat_rows = 1;
-  cmd_parser.set_if_defined("total-stat-rows", &total_stat_rows);
+    auto sweep = Analytical::Sweep(
+        Analytical::SweepManifest::parse(sweep_manifest), sweep_threads);
+    return sweep.run() ? 0 : 1;
+  }
 
-  int stat_row = 0;
-  cmd_parser.set_if_defined("stat-row", &stat_row);
+  // 1. Retrieve network-agnostic configs
+  auto simulation_config = Analytical::SimulationConfig();
+  cmd_parser.set_if_defined(
+      "system-configuration", &simulation_config.system_configuration);
+  cmd_parser.set_if_defined(
+      "workload-configuration", &simulation_config.workload_configuration);
+  cmd_parser.set_if_defined("num-passes", &simulation_config.num_passes);
+  cmd_parser.set_if_defined(
+      "num-queues-per-dim", &simulation_config.num_queues_per_dim);
+  cmd_parser.set_if_defined("comm-scale", &simulation_config.comm_scale);
+  cmd_parser.set_if_defined("compute-scale", &simulation_config.compute_scale);
+  cmd_parser.set_if_defined(
+      "injection-scale", &simulation_config.injection_scale);
+  cmd_parser.set_if_defined("path", &simulation_config.path);
+  cmd_parser.set_if_defined("run-name", &simulation_config.run_name);
+  cmd_parser.set_if_defined(
+      "total-stat-rows", &simulation_config.total_stat_rows);
+  cmd_parser.set_if_defined("stat-row", &simulation_config.stat_row);
+  cmd_parser.set_if_defined(
+      "csv-fragments", &simulation_config.csv_fragments);
+  cmd_parser.set_if_defined(
+      "rendezvous-protocol", &simulation_config.rendezvous_protocol);
+  cmd_parser.set_if_defined(
+      "symmetry-reduction", &simulation_config.symmetry_reduction);
+  cmd_parser.set_if_defined(
+      "link-contention", &simulation_config.link_contention);
+  cmd_parser.set_if_defined("clock-check", &simulation_config.clock_check);
+
+  std::string event_queue_engine = "heap";
+  cmd_parser.set_if_defined("event-queue-engine", &event_queue_engine);
+  if (event_queue_engine == "list") {
+    simulation_config.event_queue_engine_type =
+        Analytical::EventQueue::EngineType::List;
+  } else if (event_queue_engine != "heap") {
+    std::cout << "[Analytical, main] Event queue engine not defined: "
+              << event_queue_engine << std::endl;
+    exit(-1);
+  }
 
-  bool rendezvous_protocol = false;
-  cmd_parser.set_if_defined("rendezvous-protocol", &rendezvous_protocol);
+  std::string estimate_mode = "off";
+  cmd_parser.set_if_defined("estimate", &estimate_mode);
+  if (estimate_mode == "only") {
+    simulation_config.estimate_mode = Analytical::EstimateMode::Only;
+  } else if (estimate_mode == "validate") {
+    simulation_config.estimate_mode = Analytical::EstimateMode::Validate;
+  } else if (estimate_mode != "off") {
+    std::cout << "[Analytical, main] Estimate mode not defined: "
+              << estimate_mode << std::endl;
+    exit(-1);
+  }
 
   // 2. Retrieve network configs
   std::string network_configuration = "";
@@ -126,197 +171,25 @@ int main(int argc, char* argv[]) {
     exit(-1);
   }
 
-  // parse configuration.json file
-  auto network_parser = Analytical::NetworkConfigParser(network_configuration);
-  auto topology_name = network_parser.get<std::string>("topology-name");
-  auto dimensions_count = network_parser.get<int>("dimensions-count");
-  auto units_counts = network_parser.get<std::vector<int>>("units-count");
-  cmd_parser.set_if_defined("units-count", &units_counts);
-  auto link_latencies = network_parser.get<std::vector<double>>("link-latency");
-  cmd_parser.set_if_defined("link-latency", &link_latencies);
-  auto link_bandwidths =
-      network_parser.get<std::vector<double>>("link-bandwidth");
-  cmd_parser.set_if_defined("link-bandwidth", &link_bandwidths);
-  auto nic_latencies = network_parser.get<std::vector<double>>("nic-latency");
-  auto router_latencies =
-      network_parser.get<std::vector<double>>("router-latency");
-  auto hbm_latencies = network_parser.get<std::vector<double>>("hbm-latency");
-  auto hbm_bandwidths =
-      network_parser.get<std::vector<double>>("hbm-bandwidth");
-  auto link_failures =
-      network_parser.get<std::vector<int>>("link-failure");
-  auto hbm_scales = network_parser.get<std::vector<double>>("hbm-scale");
-
-  /**
-   * Instantitiation: Event Queue, System, Memory, Topology, etc.
-   */
-  // event queue instantiation
-  auto event_queue = std::make_shared<Analytical::EventQueue>();
-
-  // compute total number of npus by multiplying counts of each dimension
-  auto npus_count = 1;
-  for (auto units_count : units_counts) {
-    npus_count *= units_count;
-  }
-
-  // number of nodes for each system layer dimension
-  auto physical_dims = std::vector<int>();
-
-  // Network and System layer initialization
-  std::unique_ptr<Analytical::AnalyticalNetwork>
-      analytical_networks[npus_count];
-  AstraSim::Sys* systems[npus_count];
-  std::unique_ptr<AstraSim::SimpleMemory> memories[npus_count];
-
-  // pointer to topology
-  std::shared_ptr<Analytical::Topology> topology;
-
-  // topology configuration for each dimension
-  auto topology_configs = Analytical::Topology::TopologyConfigs();
-  for (int i = 0; i < dimensions_count; i++) {
-    auto link_bandwidth_b_ns = (double)link_bandwidths[i] * (1 << 30) /
-        (1'000'000'000); // link bandwidth in B/ns
-
-    topology_configs.emplace_back(
-        units_counts[i], // NPUs count
-        link_latencies[i], // link latency (ns)
-        link_bandwidth_b_ns, // link bandwidth (B/ns)
-        nic_latencies[i], // nic latency (ns)
-        router_latencies[i], // router latency (ns)
-        hbm_latencies[i], // memory latency (ns),
-        hbm_bandwidths[i], // memory bandwidth (GB/s) = (B/ns)
-        link_failures[i], // link failures (int), currently it only supports one link failure in the system
-        hbm_scales[i] // memory scaling factor
-    );
-  }
-
-  // Instantiate topology
-  if (topology_name == "Hierarchical") {
-    // Parse networks per each dimension
-    auto topologies_per_dim = network_parser.parseHierarchicalTopologyList();
-    auto dimension_types = network_parser.parseHierarchicalDimensionType();
-    auto links_count_per_dim = network_parser.parseLinksCountPerDim();
-    cmd_parser.set_if_defined("links-count", &links_count_per_dim);
-
-    auto hierarchy_config = Analytical::HierarchicalTopologyConfig(
-        dimensions_count,
-        topologies_per_dim,
-        dimension_types,
-        links_count_per_dim,
-        link_bandwidths,
-        link_failures);
-
-    topology = std::make_shared<Analytical::HierarchicalTopology>(
-        topology_configs, hierarchy_config);
-    for (int dim = 0; dim < dimensions_count; dim++) {
-      physical_dims.emplace_back(units_counts[dim]);
-    }
-  } else {
-    std::cout << "[Analytical, main] Topology not defined: " << topology_name
-              << std::endl;
-    exit(-1);
-  }
-
-  // Retrieve cost_model
-  auto& cost_model = topology->getCostModel();
-
-  // Instantiate required network, memory, and system layers
-  auto queues_per_dim = std::vector<int>(dimensions_count, num_queues_per_dim);
-
-  // link event queue and topology
-  Analytical::AnalyticalNetwork::setEventQueue(event_queue);
-  Analytical::AnalyticalNetwork::setTopology(topology);
-  Analytical::AnalyticalNetwork::setCostModel(&cost_model);
-
-  for (int i = 0; i < npus_count; i++) {
-    analytical_networks[i] =
-        std::make_unique<Analytical::AnalyticalNetwork>(i, dimensions_count);
-
-    memories[i] = std::make_unique<AstraSim::SimpleMemory>(
-        (AstraSim::AstraNetworkAPI*)(analytical_networks[i].get()),
-        1,
-        500000,
-        12.5);
-
-    systems[i] = new AstraSim::Sys(
-        analytical_networks[i].get(), // AstraNetworkAPI
-        memories[i].get(), // AstraMemoryAPI
-        i, // id
-        num_passes, // num_passes
-        physical_dims, // dimensions
-        queues_per_dim, // queues per corresponding dimension
-        system_configuration, // system configuration
-        workload_configuration, // workload configuration
-        comm_scale,
-        compute_scale,
-        injection_scale, // communication, computation, injection scale
-        total_stat_rows,
-        stat_row, // total_stat_rows and stat_row
-        path, // stat file path
-        run_name, // run name
-        true, // separate_log
-        rendezvous_protocol // randezvous protocol
-    );
-  }
-
-  // link csv
-  auto end_to_env_csv =
-      std::make_shared<AstraSim::CSVWriter>(path, "backend_end_to_end.csv");
-  auto dimensional_info_csv =
-      std::make_shared<AstraSim::CSVWriter>(path, "backend_dim_info.csv");
-  if (stat_row == 0) {
-    end_to_env_csv->initialize_csv(total_stat_rows + 1, 13);
-
-    end_to_env_csv->write_cell(0, 0, "RunName");
-    end_to_env_csv->write_cell(0, 1, "CommsTime");
-    end_to_env_csv->write_cell(0, 2, "ComputeTime");
-    end_to_env_csv->write_cell(0, 3, "ExposedCommsTime");
-    end_to_env_csv->write_cell(0, 4, "Cost");
-    end_to_env_csv->write_cell(0, 5, "TotalPayloadSize");
-    for (auto dim = 0; dim < 7; dim++) {
-      end_to_env_csv->write_cell(
-          0, (6 + dim), "PayloadSize_Dim" + std::to_string(dim));
-    }
-
-    // fixme: assuming max_dimension is 10
-    // fixme: dimensions_count for every topology differs
-    auto dimension_csv_rows_count = (total_stat_rows * 10) + 1;
-    dimensional_info_csv->initialize_csv(dimension_csv_rows_count, 3);
-    dimensional_info_csv->write_cell(0, 0, "RunName");
-    dimensional_info_csv->write_cell(0, 1, "DimensionIndex");
-    dimensional_info_csv->write_cell(0, 2, "AverageChunkLatency");
-  }
-  Analytical::AnalyticalNetwork::setCsvConfiguration(
-      path, stat_row, total_stat_rows, end_to_env_csv, dimensional_info_csv);
+  // parse configuration.json file, then apply command line overrides
+  auto network_config = std::make_shared<Analytical::NetworkConfig>(
+      Analytical::NetworkConfig::parse(network_configuration));
+  cmd_parser.set_if_defined("units-count", &network_config->units_counts);
+  cmd_parser.set_if_defined("link-latency", &network_config->link_latencies);
+  cmd_parser.set_if_defined(
+      "link-bandwidth", &network_config->link_bandwidths);
+  cmd_parser.set_if_defined(
+      "links-count", &network_config->links_count_per_dim);
 
   /**
    * Run Analytical Model
    */
-  // Initialize event queue
-  for (int i = 0; i < npus_count; i++) {
-    systems[i]->workload->fire();
-  }
-
-  // Run events
-  while (!event_queue->empty()) {
-    event_queue->proceed();
-  }
-
-  /**
-   * Print results
-   */
-  auto topology_cost = cost_model.computeTotalCost();
-  std::cout << "\n[Analytical, main] Total Cost: $" << topology_cost
-            << std::endl;
-
-  /**
-   * Cleanup
-   */
-  // System class automatically deletes itself, so no need to free systems[i]
-  // here. Invoking `free systems[i]` here will trigger segfault (by trying to
-  // delete already deleted memory space)
+  auto simulation = Analytical::Simulation(network_config, simulation_config);
+  auto result = simulation.run();
 
   // terminate program
-  return 0;
+  if (!result.estimate_error.empty()) {
+    return -1;
+  }
+  return result.estimate_within_tolerance ? 0 : 1;
 }
-
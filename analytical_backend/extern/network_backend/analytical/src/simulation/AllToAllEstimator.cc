@@ -0,0 +1,300 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "AllToAllEstimator.hh"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include "astra-sim/system/Sys.hh"
+#include "astra-sim/system/collective/HalfRing.hh"
+
+using namespace Analytical;
+
+AllToAllEstimateConfig AllToAllEstimateConfig::from_sys(
+    const AstraSim::Sys& sys,
+    uint64_t collective_size,
+    std::vector<bool> involved_dimensions) noexcept {
+  auto config = AllToAllEstimateConfig();
+  config.collective_size = collective_size;
+  config.involved_dimensions = std::move(involved_dimensions);
+  config.preferred_dataset_splits = sys.preferred_dataset_splits;
+  config.endpoint_delay = sys.communication_delay;
+  config.queues_per_dim = sys.queues_per_dim.empty() ? 1 : sys.queues_per_dim[0];
+  config.inter_dimension_scheduling = sys.inter_dimension_scheduling;
+  config.link_failure_scheduling = sys.link_failure_scheduling;
+  config.link_failure_per_dimension = sys.link_failure_per_dimension;
+  config.failure_type = sys.failure_type;
+  return config;
+}
+
+AllToAllEstimator::AllToAllEstimator(
+    std::shared_ptr<const NetworkConfig> network_config) noexcept
+    : network_config(std::move(network_config)) {
+  topology_configs = this->network_config->get_topology_configs();
+  topology = std::make_unique<HierarchicalTopology>(
+      topology_configs, this->network_config->get_hierarchy_config());
+}
+
+std::string AllToAllEstimator::check(
+    const AllToAllEstimateConfig& config) const noexcept {
+  const auto& net = *network_config;
+  for (auto dim = 0; dim < net.dimensions_count; dim++) {
+    if (net.topologies_per_dim[dim] != NetworkConfig::TopologyList::Ring) {
+      return "dimension " + std::to_string(dim) + " is not a Ring";
+    }
+  }
+  if (!net.faulty_links.empty()) {
+    return "faulty links (failures differ between rings)";
+  }
+  if (config.preferred_dataset_splits < 1) {
+    return "preferred-dataset-splits should be positive";
+  }
+  if (config.queues_per_dim != 1) {
+    return "more than one queue per dimension";
+  }
+  if (config.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::Ascending &&
+      config.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::ND_Torus_Ring &&
+      config.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::
+              ND_Torus_Ring_AlltoAll_AllReduce) {
+    return "inter-dimension scheduling other than ascending/ND_Torus_Ring";
+  }
+  for (size_t dim = 0; dim < config.link_failure_per_dimension.size(); dim++) {
+    auto link_failures = config.link_failure_per_dimension[dim];
+    if (link_failures > 1 || (link_failures == 1 && net.units_counts[dim] == 2)) {
+      return "unsupported link failure on dimension " + std::to_string(dim);
+    }
+  }
+  return "";
+}
+
+std::string AllToAllEstimator::estimate(
+    const AllToAllEstimateConfig& config,
+    AllToAllEstimate& estimate) const noexcept {
+  auto reason = check(config);
+  if (!reason.empty()) {
+    return reason;
+  }
+
+  const auto& net = *network_config;
+  auto result = AllToAllEstimate();
+  auto latency_per_dim = std::vector<double>(net.dimensions_count, 0);
+  auto phases_per_dim = std::vector<double>(net.dimensions_count, 0);
+
+  // chunk sizes, as Sys::determine_chunk_size splits the collective
+  auto chunk_sizes = std::vector<uint64_t>();
+  auto chunk_size = (uint64_t)std::ceil(
+      (double)config.collective_size / config.preferred_dataset_splits);
+  for (auto size = config.collective_size; size > 0;) {
+    auto current_chunk_size = std::min(chunk_size, size);
+    chunk_sizes.emplace_back(current_chunk_size);
+    size -= current_chunk_size;
+  }
+
+  // chunk phases, each chunk ready at the issue time
+  auto chunks_count = (int)chunk_sizes.size();
+  auto chunk_phases = std::vector<std::vector<Phase>>();
+  for (auto chunk = 0; chunk < chunks_count; chunk++) {
+    chunk_phases.emplace_back(get_phases(config, chunk));
+  }
+  result.chunk_finish_times.resize(chunk_sizes.size(), 0);
+
+  // every dimension queue runs one chunk at a time, in arrival order
+  // (ties broken by chunk id, i.e., stream number)
+  using Arrival = std::tuple<double, int, int>; // time, chunk, phase index
+  auto arrivals =
+      std::priority_queue<Arrival, std::vector<Arrival>, std::greater<>>();
+  for (auto chunk = 0; chunk < chunks_count; chunk++) {
+    if (!chunk_phases[chunk].empty()) {
+      arrivals.emplace(0, chunk, 0);
+    }
+  }
+  auto queue_free_times = std::vector<double>(net.dimensions_count, 0);
+
+  while (!arrivals.empty()) {
+    auto [arrival_time, chunk, phase_index] = arrivals.top();
+    arrivals.pop();
+
+    const auto& phase = chunk_phases[chunk][phase_index];
+    auto phase_estimate = AllToAllPhaseEstimate();
+    phase_estimate.chunk = chunk;
+    phase_estimate.dimension = phase.dimension;
+    phase_estimate.chunk_stage = phase.network_stage;
+    phase_estimate.start_time =
+        std::max(arrival_time, queue_free_times[phase.dimension]);
+    phase_estimate.duration = get_phase_duration(
+        config,
+        phase,
+        chunk_sizes[chunk],
+        chunk,
+        phase_estimate.messages_count,
+        phase_estimate.message_size);
+
+    auto finish_time = phase_estimate.start_time + phase_estimate.duration;
+    queue_free_times[phase.dimension] = finish_time;
+    latency_per_dim[phase.dimension] += phase_estimate.duration;
+    phases_per_dim[phase.dimension]++;
+    result.phases.emplace_back(phase_estimate);
+
+    if (phase_index + 1 < (int)chunk_phases[chunk].size()) {
+      arrivals.emplace(finish_time, chunk, phase_index + 1);
+    } else {
+      result.chunk_finish_times[chunk] = finish_time;
+      result.collective_time = std::max(result.collective_time, finish_time);
+    }
+  }
+
+  // chunk-major order, as in the report
+  std::stable_sort(
+      result.phases.begin(),
+      result.phases.end(),
+      [](const AllToAllPhaseEstimate& a, const AllToAllPhaseEstimate& b) {
+        return a.chunk < b.chunk;
+      });
+
+  for (auto dim = 0; dim < net.dimensions_count; dim++) {
+    result.avg_chunk_latency_per_dim.emplace_back(
+        (phases_per_dim[dim] > 0) ? latency_per_dim[dim] / phases_per_dim[dim]
+                                  : 0);
+  }
+  estimate = std::move(result);
+  return "";
+}
+
+std::vector<AllToAllEstimator::Phase> AllToAllEstimator::get_phases(
+    const AllToAllEstimateConfig& config,
+    int chunk) const noexcept {
+  const auto& net = *network_config;
+  auto dimensions_count = net.dimensions_count;
+  auto mate = config.link_failure_scheduling ==
+          AstraSim::LinkFailureScheduling::Mate ||
+      config.link_failure_scheduling ==
+          AstraSim::LinkFailureScheduling::Mate_Enhanced;
+  auto multi_failure = config.failure_type == 1 || config.failure_type == 4;
+  auto nd_torus = config.inter_dimension_scheduling !=
+      AstraSim::InterDimensionScheduling::Ascending;
+
+  // dimension of each stage (ND_Torus_Ring rotates the start dimension, and
+  // MATE runs every dimension twice, or three times for two failures)
+  auto stages_per_dim = (mate && nd_torus) ? (multi_failure ? 3 : 2) : 1;
+  auto dim_mapper = std::vector<int>();
+  for (auto i = 0; i < dimensions_count; i++) {
+    auto dim = nd_torus ? (chunk + i) % dimensions_count : i;
+    for (auto j = 0; j < stages_per_dim; j++) {
+      dim_mapper.emplace_back(dim);
+    }
+  }
+
+  auto stages_count = (int)dim_mapper.size();
+  auto phases = std::vector<Phase>();
+  for (auto stage = 0; stage < stages_count; stage++) {
+    auto dim = dim_mapper[stage];
+    auto involved = config.involved_dimensions.empty() ||
+        (dim < (int)config.involved_dimensions.size() &&
+         config.involved_dimensions[dim]);
+    if (net.units_counts[dim] == 1 || !involved) {
+      continue;
+    }
+    phases.push_back({dim, stage, 0});
+  }
+
+  // HalfRing::ready derives the network stage from the remaining phases
+  auto stage_base = (multi_failure ? 3 : 2) * dimensions_count;
+  auto phases_count = (int)phases.size();
+  for (auto i = 0; i < phases_count; i++) {
+    auto phases_to_go = phases_count - i - 1;
+    phases[i].network_stage = stage_base - phases_to_go - 1;
+  }
+  return phases;
+}
+
+double AllToAllEstimator::get_phase_duration(
+    const AllToAllEstimateConfig& config,
+    const Phase& phase,
+    uint64_t chunk_size,
+    int chunk,
+    int& messages_count,
+    uint64_t& message_size) const noexcept {
+  const auto& net = *network_config;
+  auto dim = phase.dimension;
+  auto nodes_in_ring = net.units_counts[dim];
+  auto link_failure = (dim < (int)config.link_failure_per_dimension.size())
+      ? config.link_failure_per_dimension[dim]
+      : 0;
+
+  // ring with the failure (the last failed dimension, as in Sys)
+  auto failure_dim = 0;
+  auto dimensions_count = (int)config.link_failure_per_dimension.size();
+  for (auto i = 0; i < dimensions_count; i++) {
+    if (config.link_failure_per_dimension[i] != 0) {
+      failure_dim = i;
+    }
+  }
+  auto nodes_num_of_failed_ring = net.units_counts[failure_dim];
+  auto max_physical_dim_value =
+      *std::max_element(net.units_counts.begin(), net.units_counts.end());
+
+  messages_count = AstraSim::HalfRing::get_stream_count(
+      nodes_in_ring,
+      link_failure,
+      config.link_failure_scheduling,
+      phase.ring_stage,
+      nodes_num_of_failed_ring,
+      max_physical_dim_value,
+      config.failure_type);
+  message_size = AstraSim::HalfRing::get_msg_size(
+      chunk_size,
+      nodes_in_ring,
+      link_failure,
+      config.link_failure_scheduling,
+      net.dimensions_count,
+      phase.ring_stage,
+      nodes_num_of_failed_ring,
+      max_physical_dim_value,
+      config.failure_type);
+
+  // every message goes to the ring neighbor on this dimension
+  auto neighbor = 1;
+  for (auto i = 0; i < dim; i++) {
+    neighbor *= net.units_counts[i];
+  }
+  auto link_failure_scheduling_flag = 0;
+  if (config.link_failure_scheduling == AstraSim::LinkFailureScheduling::Mate) {
+    link_failure_scheduling_flag = 1;
+  } else if (
+      config.link_failure_scheduling ==
+      AstraSim::LinkFailureScheduling::Mate_Enhanced) {
+    link_failure_scheduling_flag = 2;
+  }
+  auto message_latency = [&](int stream_count_id) {
+    // events fire on whole ticks
+    return std::floor(
+        topology
+            ->send(
+                0,
+                neighbor,
+                message_size,
+                chunk,
+                stream_count_id,
+                link_failure_scheduling_flag,
+                phase.network_stage,
+                config.failure_type,
+                0)
+            .first);
+  };
+
+  // the ring starts one endpoint delay after init, and each message is
+  // handed over one endpoint delay after it arrives
+  double endpoint_delay = config.endpoint_delay;
+  if (messages_count <= 0) {
+    return endpoint_delay;
+  }
+  return endpoint_delay + (message_latency(0) + endpoint_delay) +
+      (messages_count - 1) * (message_latency(1) + endpoint_delay);
+}
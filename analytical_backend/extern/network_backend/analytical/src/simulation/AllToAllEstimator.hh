@@ -0,0 +1,150 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __ALLTOALLESTIMATOR_HH__
+#define __ALLTOALLESTIMATOR_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../topology/HierarchicalTopology.hh"
+#include "NetworkConfig.hh"
+#include "astra-sim/system/Common.hh"
+
+namespace AstraSim {
+class Sys;
+} // namespace AstraSim
+
+namespace Analytical {
+/**
+ * System-layer parameters of one uniform All-to-All collective
+ * (halfring on every dimension: HalfRing, FoldedRing or MATE phases).
+ */
+struct AllToAllEstimateConfig {
+ public:
+  /**
+   * Read the parameters from a parsed system layer.
+   * @param sys system layer (its system configuration parsed)
+   * @param collective_size bytes each NPU sends
+   * @param involved_dimensions dimensions the collective runs on
+   * @return parameters of the collective
+   */
+  static AllToAllEstimateConfig from_sys(
+      const AstraSim::Sys& sys,
+      uint64_t collective_size,
+      std::vector<bool> involved_dimensions) noexcept;
+
+  uint64_t collective_size = 0;
+  std::vector<bool> involved_dimensions; // empty: every dimension
+  int preferred_dataset_splits = 1;
+  int endpoint_delay = 1; // ns, already scaled by the injection scale
+  int queues_per_dim = 1;
+  AstraSim::InterDimensionScheduling inter_dimension_scheduling =
+      AstraSim::InterDimensionScheduling::ND_Torus_Ring;
+  AstraSim::LinkFailureScheduling link_failure_scheduling =
+      AstraSim::LinkFailureScheduling::Baseline;
+  std::vector<int> link_failure_per_dimension; // empty: no failure
+  int failure_type = 0;
+};
+
+/**
+ * One phase (a ring on one dimension) of one chunk.
+ */
+struct AllToAllPhaseEstimate {
+ public:
+  int chunk;
+  int dimension;
+  int chunk_stage;
+  int messages_count;
+  uint64_t message_size;
+  double start_time; // ns, from the issue of the collective
+  double duration; // ns
+};
+
+/**
+ * Estimated timing of one All-to-All collective (ns).
+ */
+struct AllToAllEstimate {
+ public:
+  double collective_time = 0;
+  std::vector<double> chunk_finish_times;
+  std::vector<double> avg_chunk_latency_per_dim; // same metric as SchedulerUnit
+  std::vector<AllToAllPhaseEstimate> phases; // chunk-major, in phase order
+};
+
+/**
+ * Closed-form timing of uniform All-to-All collectives, without event
+ * simulation.
+ *
+ * Every NPU runs the same schedule, so one phase takes
+ *   d + (L_0 + d) + (stream_count - 1) * (L_1 + d)
+ * where stream_count and the message size come from HalfRing, L_k is the
+ * HierarchicalTopology::send latency of the k-th message, and d is the
+ * endpoint delay of the memory bus. Chunks visit dimensions in the order of
+ * the inter-dimension scheduler, and each dimension queue serves one chunk
+ * at a time in arrival order.
+ *
+ * The result matches the event-driven simulation of an isolated collective
+ * (see Simulation, --estimate=validate).
+ */
+class AllToAllEstimator {
+ public:
+  /**
+   * @param network_config parsed network configuration
+   */
+  explicit AllToAllEstimator(
+      std::shared_ptr<const NetworkConfig> network_config) noexcept;
+
+  AllToAllEstimator(const AllToAllEstimator&) = delete;
+  AllToAllEstimator& operator=(const AllToAllEstimator&) = delete;
+
+  /**
+   * Estimate one collective.
+   * @param config system-layer parameters of the collective
+   * @param estimate timing of the collective (left untouched if it is not
+   * supported)
+   * @return why the collective cannot be estimated (see check()), empty if
+   * it was
+   */
+  std::string estimate(
+      const AllToAllEstimateConfig& config,
+      AllToAllEstimate& estimate) const noexcept;
+
+  /**
+   * @param config system-layer parameters of the collective
+   * @return why the collective cannot be estimated, empty if it can
+   */
+  std::string check(const AllToAllEstimateConfig& config) const noexcept;
+
+ private:
+  struct Phase {
+    int dimension;
+    int ring_stage; // chunk_stage given to HalfRing
+    int network_stage; // chunk_stage given to the network
+  };
+
+  /**
+   * Phases of one chunk, as Sys::generate_collective builds them.
+   */
+  std::vector<Phase> get_phases(
+      const AllToAllEstimateConfig& config,
+      int chunk) const noexcept;
+
+  double get_phase_duration(
+      const AllToAllEstimateConfig& config,
+      const Phase& phase,
+      uint64_t chunk_size,
+      int chunk,
+      int& messages_count,
+      uint64_t& message_size) const noexcept;
+
+  std::shared_ptr<const NetworkConfig> network_config;
+  Topology::TopologyConfigs topology_configs;
+  std::unique_ptr<HierarchicalTopology> topology;
+};
+} // namespace Analytical
+
+#endif
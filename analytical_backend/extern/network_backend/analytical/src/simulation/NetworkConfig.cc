@@ -0,0 +1,85 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "NetworkConfig.hh"
+#include <iostream>
+#include "../helper/NetworkConfigParser.hh"
+
+using namespace Analytical;
+
+NetworkConfig NetworkConfig::parse(
+    const std::string& network_configuration) noexcept {
+  auto network_parser = NetworkConfigParser(network_configuration);
+
+  auto network_config = NetworkConfig();
+  network_config.topology_name =
+      network_parser.get<std::string>("topology-name");
+  network_config.dimensions_count = network_parser.get<int>("dimensions-count");
+  network_config.units_counts =
+      network_parser.get<std::vector<int>>("units-count");
+  network_config.link_latencies =
+      network_parser.get<std::vector<double>>("link-latency");
+  network_config.link_bandwidths =
+      network_parser.get<std::vector<double>>("link-bandwidth");
+  network_config.nic_latencies =
+      network_parser.get<std::vector<double>>("nic-latency");
+  network_config.router_latencies =
+      network_parser.get<std::vector<double>>("router-latency");
+  network_config.hbm_latencies =
+      network_parser.get<std::vector<double>>("hbm-latency");
+  network_config.hbm_bandwidths =
+      network_parser.get<std::vector<double>>("hbm-bandwidth");
+  network_config.link_failures =
+      network_parser.get<std::vector<int>>("link-failure");
+  network_config.hbm_scales =
+      network_parser.get<std::vector<double>>("hbm-scale");
+  network_config.faulty_links = network_parser.parseFaultyLinks();
+
+  if (network_config.topology_name == "Hierarchical") {
+    network_config.topologies_per_dim =
+        network_parser.parseHierarchicalTopologyList();
+    network_config.dimension_types =
+        network_parser.parseHierarchicalDimensionType();
+    network_config.links_count_per_dim = network_parser.parseLinksCountPerDim();
+  } else {
+    std::cout << "[Analytical, main] Topology not defined: "
+              << network_config.topology_name << std::endl;
+    exit(-1);
+  }
+
+  return network_config;
+}
+
+Topology::TopologyConfigs NetworkConfig::get_topology_configs() const noexcept {
+  auto topology_configs = Topology::TopologyConfigs();
+  for (int i = 0; i < dimensions_count; i++) {
+    auto link_bandwidth_b_ns = (double)link_bandwidths[i] * (1 << 30) /
+        (1'000'000'000); // link bandwidth in B/ns
+
+    topology_configs.emplace_back(
+        units_counts[i], // NPUs count
+        link_latencies[i], // link latency (ns)
+        link_bandwidth_b_ns, // link bandwidth (B/ns)
+        nic_latencies[i], // nic latency (ns)
+        router_latencies[i], // router latency (ns)
+        hbm_latencies[i], // memory latency (ns),
+        hbm_bandwidths[i], // memory bandwidth (GB/s) = (B/ns)
+        link_failures[i], // link failures (int), currently it only supports one link failure in the system
+        hbm_scales[i] // memory scaling factor
+    );
+  }
+  return topology_configs;
+}
+
+HierarchicalTopologyConfig NetworkConfig::get_hierarchy_config()
+    const noexcept {
+  return HierarchicalTopologyConfig(
+      dimensions_count,
+      topologies_per_dim,
+      dimension_types,
+      links_count_per_dim,
+      link_bandwidths,
+      link_failures);
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __NETWORKCONFIG_HH__
+#define __NETWORKCONFIG_HH__
+
+#include <string>
+#include <vector>
+#include "../topology/HierarchicalTopologyConfig.hh"
+#include "../topology/Topology.hh"
+
+namespace Analytical {
+/**
+ * Parsed network configuration (.json). Immutable once parsed, so one
+ * NetworkConfig can be shared by any number of simulations.
+ */
+struct NetworkConfig {
+ public:
+  using TopologyList = HierarchicalTopologyConfig::TopologyList;
+  using DimensionType = HierarchicalTopologyConfig::DimensionType;
+
+  /**
+   * Parse a network configuration file.
+   * Only the Hierarchical topology is supported.
+   * @param network_configuration path to the .json file
+   * @return parsed configuration
+   */
+  static NetworkConfig parse(const std::string& network_configuration) noexcept;
+
+  /**
+   * Per-dimension topology configurations (link bandwidth in B/ns).
+   * A Topology keeps a reference to them: they must outlive it.
+   * @return configuration of each dimension
+   */
+  Topology::TopologyConfigs get_topology_configs() const noexcept;
+
+  /**
+   * @return hierarchy of the Hierarchical topology
+   */
+  HierarchicalTopologyConfig get_hierarchy_config() const noexcept;
+
+  std::string topology_name;
+  int dimensions_count;
+  std::vector<int> units_counts;
+  std::vector<double> link_latencies;
+  std::vector<double> link_bandwidths;
+  std::vector<double> nic_latencies;
+  std::vector<double> router_latencies;
+  std::vector<double> hbm_latencies;
+  std::vector<double> hbm_bandwidths;
+  std::vector<int> link_failures;
+  std::vector<double> hbm_scales;
+
+  /**
+   * explicitly placed failed links, as NPU id pairs (optional
+   * "faulty-links" key, see FaultyLinks)
+   */
+  std::vector<std::vector<int>> faulty_links;
+
+  // Hierarchical topology
+  std::vector<TopologyList> topologies_per_dim;
+  std::vector<DimensionType> dimension_types;
+  std::vector<int> links_count_per_dim;
+};
+} // namespace Analytical
+
+#endif
@@ -0,0 +1,789 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "Simulation.hh"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "../api/AnalyticalNetwork.hh"
+#include "../api/NetworkContext.hh"
+#include "../topology/FaultyLinks.hh"
+#include "../topology/HierarchicalTopology.hh"
+#include "../topology/HierarchicalTopologyConfig.hh"
+#include "../topology/SymmetryReduction.hh"
+#include "../topology/Topology.hh"
+#include "../topology/TopologyConfig.hh"
+#include "AllToAllEstimator.hh"
+#include "astra-sim/system/SimulationContext.hh"
+#include "astra-sim/system/Sys.hh"
+#include "astra-sim/system/memory/SimpleMemory.hh"
+#include "astra-sim/workload/CSVWriter.hh"
+#include "astra-sim/workload/Layer.hh"
+#include "astra-sim/workload/Workload.hh"
+
+using namespace Analytical;
+
+namespace {
+/**
+ * Fill the finish-time spread of result from the workload finish tick of
+ * every NPU (printed).
+ */
+void summarize_finished_times(
+    const std::map<int, AstraSim::Tick>& finished_ticks,
+    SimulationResult& result) noexcept {
+  if (finished_ticks.empty()) {
+    return;
+  }
+  auto finished_times = std::vector<std::pair<double, int>>();
+  for (const auto& finished_tick : finished_ticks) {
+    finished_times.emplace_back(
+        (double)finished_tick.second / FREQ, finished_tick.first);
+  }
+  std::sort(finished_times.begin(), finished_times.end());
+
+  auto percentile = [&finished_times](double fraction) {
+    auto index = (int)std::ceil(fraction * finished_times.size()) - 1;
+    return finished_times[std::max(index, 0)].first;
+  };
+  result.min_finished_time = finished_times.front().first;
+  result.median_finished_time = percentile(0.5);
+  result.tail_finished_time = percentile(0.99);
+  result.max_finished_time = finished_times.back().first;
+  result.slowest_npu = finished_times.back().second;
+
+  std::cout << "[Analytical, Simulation] NPU finish times: min "
+            << result.min_finished_time << ", median "
+            << result.median_finished_time << ", p99 "
+            << result.tail_finished_time << ", max "
+            << result.max_finished_time << " (NPU " << result.slowest_npu
+            << "), skew "
+            << result.max_finished_time - result.min_finished_time
+            << std::endl;
+}
+
+/**
+ * Create backend_npu_finish_time.csv of a stat path with its header (same
+ * rows as backend_end_to_end.csv); done by the run of stat row 0.
+ */
+void initialize_finished_times_csv(
+    AstraSim::CSVWriter& csv,
+    const SimulationConfig& sim) noexcept {
+  csv.initialize_csv(sim.total_stat_rows + 1, 7);
+  csv.write_cell(0, 0, "RunName");
+  csv.write_cell(0, 1, "MinFinishTime");
+  csv.write_cell(0, 2, "MedianFinishTime");
+  csv.write_cell(0, 3, "TailFinishTime");
+  csv.write_cell(0, 4, "MaxFinishTime");
+  csv.write_cell(0, 5, "FinishTimeSkew");
+  csv.write_cell(0, 6, "SlowestNpu");
+}
+
+/**
+ * Write the finish-time row of a run into backend_npu_finish_time.csv.
+ */
+void write_finished_times_csv(
+    AstraSim::CSVWriter& csv,
+    const SimulationConfig& sim,
+    const SimulationResult& result) noexcept {
+  auto row = sim.stat_row + 1;
+  csv.write_cell(row, 0, result.run_name);
+  csv.write_cell(row, 1, std::to_string(result.min_finished_time));
+  csv.write_cell(row, 2, std::to_string(result.median_finished_time));
+  csv.write_cell(row, 3, std::to_string(result.tail_finished_time));
+  csv.write_cell(row, 4, std::to_string(result.max_finished_time));
+  csv.write_cell(
+      row,
+      5,
+      std::to_string(result.max_finished_time - result.min_finished_time));
+  csv.write_cell(row, 6, std::to_string(result.slowest_npu));
+}
+
+/**
+ * Create backend_pool_stats.csv of a stat path with its header (same rows as
+ * backend_end_to_end.csv); done by the run of stat row 0.
+ */
+void initialize_pool_stats_csv(
+    AstraSim::CSVWriter& csv,
+    const SimulationConfig& sim) noexcept {
+  auto types_count = (int)AstraSim::ObjectPools::Type::TypesCount;
+  csv.initialize_csv(sim.total_stat_rows + 1, 1 + 2 * types_count);
+  csv.write_cell(0, 0, "RunName");
+  for (auto type = 0; type < types_count; type++) {
+    auto name = std::string(AstraSim::ObjectPools::get_type_name(
+        (AstraSim::ObjectPools::Type)type));
+    csv.write_cell(0, 1 + 2 * type, name + "Allocations");
+    csv.write_cell(0, 2 + 2 * type, name + "PeakInUse");
+  }
+}
+
+/**
+ * Fill the object pool counters of result.
+ * @param npus_per_generator NPUs each simulated NPU stands for: a symmetry
+ * reduced run scales its counters to the full run (exact for allocations, an
+ * upper bound for the peak, as the NPUs of an orbit reach it at the same tick
+ * but a full run handles their events one after another)
+ */
+void summarize_pool_stats(
+    const AstraSim::ObjectPools& object_pools,
+    int npus_per_generator,
+    SimulationResult& result) noexcept {
+  for (auto type = 0; type < (int)AstraSim::ObjectPools::Type::TypesCount;
+       type++) {
+    auto pool_type = (AstraSim::ObjectPools::Type)type;
+    result.pool_allocations_count.emplace_back(
+        object_pools.get_allocations_count(pool_type) * npus_per_generator);
+    result.pool_peak_in_use.emplace_back(
+        object_pools.get_peak_in_use(pool_type) * npus_per_generator);
+  }
+}
+
+/**
+ * Write the object pool counters of a run into backend_pool_stats.csv.
+ */
+void write_pool_stats_csv(
+    AstraSim::CSVWriter& csv,
+    const SimulationConfig& sim,
+    const SimulationResult& result) noexcept {
+  auto row = sim.stat_row + 1;
+  csv.write_cell(row, 0, result.run_name);
+  auto types_count = (int)result.pool_allocations_count.size();
+  for (auto type = 0; type < types_count; type++) {
+    csv.write_cell(
+        row,
+        1 + 2 * type,
+        std::to_string(result.pool_allocations_count[type]));
+    csv.write_cell(
+        row, 2 + 2 * type, std::to_string(result.pool_peak_in_use[type]));
+  }
+}
+
+/**
+ * Assemble the CSVs of a stat path once the fragments of all its runs are
+ * written (whichever run finishes last does it).
+ */
+void merge_csv_fragments(const SimulationConfig& sim) noexcept {
+  auto merged = true;
+  for (const auto& name :
+       {"backend_end_to_end.csv",
+        "backend_dim_info.csv",
+        "backend_npu_finish_time.csv",
+        "backend_pool_stats.csv",
+        "detailed.csv",
+        "EndToEnd.csv"}) {
+    merged &= AstraSim::CSVWriter::merge_fragments(
+        sim.path, name, sim.total_stat_rows);
+  }
+  if (!merged) {
+    std::cout << "[Analytical, Simulation] CSV fragment of stat row "
+              << sim.stat_row << " written, waiting for the other runs"
+              << std::endl;
+  }
+}
+
+/**
+ * Estimate of one All-to-All collective of the workload.
+ */
+struct CollectiveEstimate {
+  int layer_index;
+  std::string comm; // fwd, ig, or wg
+  AllToAllEstimate estimate;
+  double comm_time; // ns: collective and update time, one pass
+};
+
+/**
+ * Estimate every All-to-All collective of the workload of sys (printed).
+ * @param estimates estimate of each collective
+ * @return why the workload cannot be estimated (printed), empty if it was
+ */
+std::string estimate_all_to_all(
+    std::shared_ptr<const NetworkConfig> network_config,
+    const AstraSim::Sys& sys,
+    std::vector<CollectiveEstimate>& estimates) noexcept {
+  auto cannot_estimate = [&estimates](const std::string& reason) {
+    std::cout << "[Analytical, Simulation] Cannot estimate: " << reason
+              << std::endl;
+    estimates.clear();
+    return reason;
+  };
+  if (sys.rendezvous_enabled) {
+    return cannot_estimate("rendezvous protocol");
+  }
+  if (sys.boost_mode) {
+    return cannot_estimate("boost mode");
+  }
+  if (sys.model_shared_bus) {
+    return cannot_estimate("shared bus model");
+  }
+  if (sys.non_uniform_flag != 0) {
+    return cannot_estimate("non-uniform All-to-All");
+  }
+  if (sys.traffic_matrix != nullptr) {
+    return cannot_estimate("All-to-Allv traffic matrix");
+  }
+  for (const auto* implementation :
+       sys.all_to_all_implementation_per_dimension) {
+    if (implementation->type !=
+        AstraSim::CollectiveImplementationType::HalfRing) {
+      return cannot_estimate("all-to-all implementation other than halfring");
+    }
+  }
+
+  auto estimator = AllToAllEstimator(network_config);
+  auto workload = sys.workload;
+  for (auto i = 0; i < workload->SIZE; i++) {
+    const auto* layer = workload->layers[i];
+    auto comms = {
+        std::make_tuple(
+            "fwd",
+            layer->spec->fwd_pass_comm_type,
+            layer->spec->fwd_pass_comm_size,
+            layer->fwd_pass_comm_involved_dimensions,
+            layer->spec->fwd_update_time),
+        std::make_tuple(
+            "ig",
+            layer->spec->input_grad_comm_type,
+            layer->spec->input_grad_comm_size,
+            layer->input_grad_comm_involved_dimensions,
+            layer->spec->input_grad_update_time),
+        std::make_tuple(
+            "wg",
+            layer->spec->weight_grad_comm_type,
+            layer->spec->weight_grad_comm_size,
+            layer->weight_grad_comm_involved_dimensions,
+            layer->spec->weight_grad_update_time)};
+
+    for (const auto& [comm, type, size, involved_dimensions, update_time] :
+         comms) {
+      if (type != AstraSim::ComType::All_to_All || size == 0) {
+        continue;
+      }
+      auto config =
+          AllToAllEstimateConfig::from_sys(sys, size, involved_dimensions);
+      auto collective_estimate = CollectiveEstimate();
+      collective_estimate.layer_index = i;
+      collective_estimate.comm = comm;
+      auto reason = estimator.estimate(config, collective_estimate.estimate);
+      if (!reason.empty()) {
+        return cannot_estimate(reason);
+      }
+      collective_estimate.comm_time =
+          collective_estimate.estimate.collective_time + update_time;
+
+      const auto& estimate = collective_estimate.estimate;
+      std::cout << "[Analytical, Estimate] " << layer->spec->id << " " << comm
+                << " All-to-All of " << size
+                << " bytes: " << estimate.collective_time << " ns (+"
+                << update_time << " ns update)" << std::endl;
+      for (size_t dim = 0; dim < estimate.avg_chunk_latency_per_dim.size();
+           dim++) {
+        std::cout << "  dim " << dim << ": average chunk latency "
+                  << estimate.avg_chunk_latency_per_dim[dim] << " ns"
+                  << std::endl;
+      }
+      auto chunks_count = (int)estimate.chunk_finish_times.size();
+      for (auto chunk = 0; chunk < chunks_count; chunk++) {
+        std::cout << "  chunk " << chunk << ":";
+        for (const auto& phase : estimate.phases) {
+          if (phase.chunk == chunk) {
+            std::cout << " dim " << phase.dimension << " ["
+                      << phase.start_time << ", "
+                      << phase.start_time + phase.duration << ")";
+          }
+        }
+        std::cout << " finished at " << estimate.chunk_finish_times[chunk]
+                  << " ns" << std::endl;
+      }
+      estimates.emplace_back(std::move(collective_estimate));
+    }
+  }
+
+  if (estimates.empty()) {
+    std::cout << "[Analytical, Estimate] No All-to-All collective in the "
+              << "workload" << std::endl;
+  }
+  return "";
+}
+
+/**
+ * Compare the estimates with the communication time each layer reported.
+ * @return largest relative error of an estimate
+ */
+double validate_estimate(
+    const std::vector<CollectiveEstimate>& estimates,
+    const AstraSim::AstraSimDataAPI& report,
+    int num_passes) noexcept {
+  auto layers_stats = std::vector<AstraSim::LayerData>(
+      report.layers_stats.begin(), report.layers_stats.end());
+  auto within_tolerance = true;
+  auto max_error = 0.0;
+  for (const auto& collective_estimate : estimates) {
+    const auto& layer_stats = layers_stats[collective_estimate.layer_index];
+    auto simulated_time = layer_stats.total_weight_grad_comm;
+    if (collective_estimate.comm == "fwd") {
+      simulated_time = layer_stats.total_fwd_comm;
+    } else if (collective_estimate.comm == "ig") {
+      simulated_time = layer_stats.total_input_grad_comm;
+    }
+    simulated_time *= FREQ; // us to ns
+    auto estimated_time = collective_estimate.comm_time * num_passes;
+
+    auto error = (simulated_time > 0)
+        ? std::abs(estimated_time - simulated_time) / simulated_time
+        : std::abs(estimated_time);
+    max_error = std::max(max_error, error);
+    within_tolerance &= (error <= Simulation::estimate_tolerance);
+    std::cout << "[Analytical, Estimate] " << layer_stats.layer_name << " "
+              << collective_estimate.comm << ": estimated " << estimated_time
+              << " ns, simulated " << simulated_time << " ns (error "
+              << error * 100 << "%)" << std::endl;
+  }
+  std::cout << "[Analytical, Estimate] Maximum error " << max_error * 100
+            << "% " << (within_tolerance ? "within" : "exceeds")
+            << " the tolerance of " << Simulation::estimate_tolerance * 100
+            << "%" << std::endl;
+  return max_error;
+}
+} // namespace
+
+Simulation::Simulation(
+    std::shared_ptr<const NetworkConfig> network_config,
+    const SimulationConfig& simulation_config,
+    std::shared_ptr<AstraSim::InputFiles> input_files) noexcept
+    : network_config(std::move(network_config)),
+      simulation_config(simulation_config),
+      input_files(std::move(input_files)) {}
+
+SimulationResult Simulation::run() noexcept {
+  const auto& net = *network_config;
+  const auto& sim = simulation_config;
+  auto dimensions_count = net.dimensions_count;
+
+  /**
+   * Simulation state: everything below hangs off these two contexts
+   */
+  auto simulation_context = AstraSim::SimulationContext();
+  auto binding = AstraSim::SimulationContext::Binding(&simulation_context);
+  auto network_context = NetworkContext();
+  if (input_files != nullptr) {
+    simulation_context.input_files = input_files;
+  }
+
+  /**
+   * Instantitiation: Event Queue, System, Memory, Topology, etc.
+   */
+  // event queue instantiation
+  network_context.event_queue =
+      std::make_shared<EventQueue>(sim.event_queue_engine_type);
+  simulation_context.clock.set_checked(sim.clock_check);
+  simulation_context.csv_fragments = sim.csv_fragments;
+  network_context.event_queue->set_clock(&simulation_context.clock);
+
+  // compute total number of npus by multiplying counts of each dimension
+  auto npus_count = 1;
+  for (auto units_count : net.units_counts) {
+    npus_count *= units_count;
+  }
+
+  // number of nodes for each system layer dimension
+  auto physical_dims = std::vector<int>();
+
+  // Network and System layer initialization
+  auto analytical_networks =
+      std::vector<std::unique_ptr<AnalyticalNetwork>>(npus_count);
+  auto systems = std::vector<AstraSim::Sys*>(npus_count, nullptr);
+  auto memories =
+      std::vector<std::unique_ptr<AstraSim::SimpleMemory>>(npus_count);
+
+  // topology configuration for each dimension
+  // (kept alive for the whole run: Topology holds a reference to it)
+  auto topology_configs = net.get_topology_configs();
+
+  // Instantiate topology
+  auto hierarchy_config = net.get_hierarchy_config();
+
+  network_context.topology =
+      std::make_shared<HierarchicalTopology>(topology_configs, hierarchy_config);
+  auto hierarchical_topology =
+      std::static_pointer_cast<HierarchicalTopology>(network_context.topology);
+  if (sim.link_contention) {
+    hierarchical_topology->enableLinkContention();
+  }
+
+  // explicitly placed link failures replace link-failure
+  auto faulty_links = std::shared_ptr<FaultyLinks>(nullptr);
+  if (!net.faulty_links.empty()) {
+    for (auto link_failure : net.link_failures) {
+      if (link_failure != 0) {
+        std::cout << "[Analytical, Simulation] faulty-links cannot be "
+                  << "combined with link-failure" << std::endl;
+        exit(-1);
+      }
+    }
+    faulty_links = std::make_shared<FaultyLinks>(
+        net.units_counts, net.topologies_per_dim, net.faulty_links);
+    hierarchical_topology->setFaultyLinks(faulty_links);
+    std::cout << "[Analytical, Simulation] Faulty links: "
+              << faulty_links->get_failures_count() << " failed links"
+              << std::endl;
+  }
+  for (int dim = 0; dim < dimensions_count; dim++) {
+    physical_dims.emplace_back(net.units_counts[dim]);
+  }
+
+  // Retrieve cost_model
+  auto& cost_model = network_context.topology->getCostModel();
+  network_context.cost_model = &cost_model;
+
+  // Instantiate required network, memory, and system layers
+  auto queues_per_dim =
+      std::vector<int>(dimensions_count, sim.num_queues_per_dim);
+
+  auto network_failure_dim = 0;
+  if (faulty_links != nullptr) {
+    for (int dim = 0; dim < dimensions_count; dim++) {
+      if (faulty_links->has_failures(dim)) {
+        network_failure_dim = dim;
+      }
+    }
+  }
+
+  auto instantiate_npu = [&](int i) {
+    analytical_networks[i] = std::make_unique<AnalyticalNetwork>(
+        i, dimensions_count, &network_context);
+
+    memories[i] = std::make_unique<AstraSim::SimpleMemory>(
+        (AstraSim::AstraNetworkAPI*)(analytical_networks[i].get()),
+        1,
+        500000,
+        12.5);
+
+    systems[i] = new AstraSim::Sys(
+        &simulation_context, // SimulationContext
+        analytical_networks[i].get(), // AstraNetworkAPI
+        memories[i].get(), // AstraMemoryAPI
+        i, // id
+        sim.num_passes, // num_passes
+        physical_dims, // dimensions
+        queues_per_dim, // queues per corresponding dimension
+        sim.system_configuration, // system configuration
+        sim.workload_configuration, // workload configuration
+        sim.comm_scale,
+        sim.compute_scale,
+        sim.injection_scale, // communication, computation, injection scale
+        sim.total_stat_rows,
+        sim.stat_row, // total_stat_rows and stat_row
+        sim.path, // stat file path
+        sim.run_name, // run name
+        true, // separate_log
+        sim.rendezvous_protocol // randezvous protocol
+    );
+
+    // the rings of this NPU decide between HalfRing and FoldedRing, and
+    // MATE sizes its phases by the failed ring of this NPU (or, for an NPU
+    // on intact rings only, by a failed ring of the network)
+    if (faulty_links != nullptr) {
+      systems[i]->link_failure_per_dimension =
+          faulty_links->get_failures_per_dimension(i);
+      systems[i]->failure_dim = network_failure_dim;
+      for (int dim = 0; dim < dimensions_count; dim++) {
+        if (systems[i]->link_failure_per_dimension[dim] != 0) {
+          systems[i]->failure_dim = dim;
+        }
+      }
+    }
+  };
+
+  // NPU 0 first: its parsed system configuration decides whether the run is
+  // symmetric enough to simulate orbit representatives only
+  instantiate_npu(0);
+  if (faulty_links != nullptr &&
+      (systems[0]->link_failure_scheduling ==
+           AstraSim::LinkFailureScheduling::Mate ||
+       systems[0]->link_failure_scheduling ==
+           AstraSim::LinkFailureScheduling::Mate_Enhanced)) {
+    // MATE runs one schedule for a single failed ring size
+    for (int dim = 0; dim < dimensions_count; dim++) {
+      if (faulty_links->has_failures(dim) &&
+          net.units_counts[dim] != net.units_counts[network_failure_dim]) {
+        std::cout << "[Analytical, Simulation] MATE cannot schedule failed "
+                  << "rings of different sizes (dimensions " << dim << " and "
+                  << network_failure_dim << ")" << std::endl;
+        exit(-1);
+      }
+    }
+  }
+  auto collective_estimates = std::vector<CollectiveEstimate>();
+  auto estimate_error = std::string();
+  if (sim.estimate_mode != EstimateMode::Off) {
+    estimate_error = estimate_all_to_all(
+        network_config, *systems[0], collective_estimates);
+    if (sim.estimate_mode == EstimateMode::Only) {
+      // the workload never runs, so the System does not delete itself
+      delete systems[0];
+      auto result = SimulationResult();
+      result.run_name = sim.run_name;
+      result.estimate_mode = sim.estimate_mode;
+      result.estimate_error = estimate_error;
+      return result;
+    }
+  }
+
+  auto simulated_npus = std::vector<int>();
+  if (sim.symmetry_reduction) {
+    network_context.symmetry_reduction =
+        detect_symmetry(*systems[0], faulty_links.get());
+  }
+  if (network_context.symmetry_reduction != nullptr) {
+    simulated_npus = network_context.symmetry_reduction->get_representatives();
+    simulation_context.npus_per_generator =
+        network_context.symmetry_reduction->get_orbit_size();
+    std::cout << "[Analytical, Simulation] Symmetry reduction: simulating "
+              << simulated_npus.size() << " of " << npus_count << " NPUs"
+              << std::endl;
+  } else {
+    for (int i = 0; i < npus_count; i++) {
+      simulated_npus.emplace_back(i);
+    }
+  }
+  for (auto i : simulated_npus) {
+    if (i != 0) {
+      instantiate_npu(i);
+    }
+  }
+
+  // link csv
+  auto npu_finish_time_csv = std::shared_ptr<AstraSim::CSVWriter>(nullptr);
+  auto pool_stats_csv = std::shared_ptr<AstraSim::CSVWriter>(nullptr);
+  if (sim.write_backend_csv) {
+    auto end_to_env_csv = std::make_shared<AstraSim::CSVWriter>(
+        sim.path, "backend_end_to_end.csv");
+    auto dimensional_info_csv = std::make_shared<AstraSim::CSVWriter>(
+        sim.path, "backend_dim_info.csv");
+    npu_finish_time_csv = std::make_shared<AstraSim::CSVWriter>(
+        sim.path, "backend_npu_finish_time.csv");
+    pool_stats_csv = std::make_shared<AstraSim::CSVWriter>(
+        sim.path, "backend_pool_stats.csv");
+    if (sim.csv_fragments) {
+      end_to_env_csv->write_to_fragment(sim.stat_row);
+      dimensional_info_csv->write_to_fragment(sim.stat_row);
+      npu_finish_time_csv->write_to_fragment(sim.stat_row);
+      pool_stats_csv->write_to_fragment(sim.stat_row);
+    }
+    if (sim.stat_row == 0) {
+      end_to_env_csv->initialize_csv(sim.total_stat_rows + 1, 13);
+
+      end_to_env_csv->write_cell(0, 0, "RunName");
+      end_to_env_csv->write_cell(0, 1, "CommsTime");
+      end_to_env_csv->write_cell(0, 2, "ComputeTime");
+      end_to_env_csv->write_cell(0, 3, "ExposedCommsTime");
+      end_to_env_csv->write_cell(0, 4, "Cost");
+      end_to_env_csv->write_cell(0, 5, "TotalPayloadSize");
+      for (auto dim = 0; dim < 7; dim++) {
+        end_to_env_csv->write_cell(
+            0, (6 + dim), "PayloadSize_Dim" + std::to_string(dim));
+      }
+
+      // fixme: assuming max_dimension is 10
+      // fixme: dimensions_count for every topology differs
+      auto dimension_csv_rows_count = (sim.total_stat_rows * 10) + 1;
+      dimensional_info_csv->initialize_csv(dimension_csv_rows_count, 3);
+      dimensional_info_csv->write_cell(0, 0, "RunName");
+      dimensional_info_csv->write_cell(0, 1, "DimensionIndex");
+      dimensional_info_csv->write_cell(0, 2, "AverageChunkLatency");
+
+      initialize_finished_times_csv(*npu_finish_time_csv, sim);
+      initialize_pool_stats_csv(*pool_stats_csv, sim);
+    }
+    network_context.end_to_end_csv = end_to_env_csv;
+    network_context.dimensional_info_csv = dimensional_info_csv;
+  }
+  network_context.stat_path = sim.path;
+  network_context.stat_row = sim.stat_row;
+  network_context.total_stat_rows = sim.total_stat_rows;
+
+  /**
+   * Run Analytical Model
+   */
+  // Initialize event queue
+  for (auto i : simulated_npus) {
+    systems[i]->workload->fire();
+  }
+
+  // Run events
+  auto& event_queue = network_context.event_queue;
+  while (!event_queue->empty()) {
+    event_queue->proceed();
+  }
+
+  // allocation counters of the system-layer object pools
+  auto pools_summary =
+      std::stringstream(simulation_context.object_pools.get_summary());
+  auto pool_line = std::string();
+  while (std::getline(pools_summary, pool_line)) {
+    std::cout << "[Analytical, Simulation] Pooled " << pool_line << std::endl;
+  }
+
+  /**
+   * Print results
+   */
+  auto topology_cost = cost_model.computeTotalCost();
+  std::cout << "\n[Analytical, main] Total Cost: $" << topology_cost
+            << std::endl;
+
+  auto result = SimulationResult();
+  if (network_context.reported) {
+    const auto& report = network_context.front_end_report;
+    result.finished = true;
+    result.run_name = report.run_name;
+    result.workload_finished_time = report.workload_finished_time;
+    result.total_compute = report.total_compute;
+    result.total_exposed_comm = report.total_exposed_comm;
+    result.total_cost = topology_cost;
+    result.total_payload_size =
+        (double)network_context.reported_total_payload_size /
+        (1024 * 1024); // in MB
+    for (auto payload_size : network_context.reported_payload_size_per_dim) {
+      result.payload_size_per_dim.emplace_back(
+          (double)payload_size / (1024 * 1024)); // in MB
+    }
+    result.avg_chunk_latency_per_dim =
+        report.avg_chunk_latency_per_logical_dimension;
+
+    result.estimate_mode = sim.estimate_mode;
+    result.estimate_error = estimate_error;
+    if (sim.estimate_mode == EstimateMode::Validate) {
+      if (estimate_error.empty()) {
+        result.estimate_max_error =
+            validate_estimate(collective_estimates, report, sim.num_passes);
+        result.estimate_within_tolerance =
+            result.estimate_max_error <= estimate_tolerance;
+      } else {
+        result.estimate_within_tolerance = false;
+      }
+    }
+
+    // a reduced run gives every NPU the finish time of its representative
+    auto finished_ticks = simulation_context.workload_finished_ticks;
+    if (network_context.symmetry_reduction != nullptr) {
+      const auto& symmetry_reduction = *network_context.symmetry_reduction;
+      for (int i = 0; i < npus_count; i++) {
+        auto representative =
+            finished_ticks.find(symmetry_reduction.get_representative(i));
+        if (representative != finished_ticks.end()) {
+          finished_ticks[i] = representative->second;
+        }
+      }
+    }
+    summarize_finished_times(finished_ticks, result);
+    summarize_pool_stats(
+        simulation_context.object_pools,
+        simulation_context.npus_per_generator,
+        result);
+  }
+  if (sim.write_backend_csv) {
+    network_context.end_to_end_csv->flush();
+    network_context.dimensional_info_csv->flush();
+    if (result.finished) {
+      write_finished_times_csv(*npu_finish_time_csv, sim, result);
+      write_pool_stats_csv(*pool_stats_csv, sim, result);
+    }
+    npu_finish_time_csv->flush();
+    pool_stats_csv->flush();
+  }
+  if (sim.csv_fragments) {
+    merge_csv_fragments(sim);
+  }
+
+  /**
+   * Cleanup
+   */
+  // System class automatically deletes itself, so no need to free systems[i]
+  // here. Invoking `free systems[i]` here will trigger segfault (by trying to
+  // delete already deleted memory space)
+  return result;
+}
+
+std::shared_ptr<SymmetryReduction> Simulation::detect_symmetry(
+    const AstraSim::Sys& sys,
+    const FaultyLinks* faulty_links) const noexcept {
+  const auto& net = *network_config;
+  auto not_symmetric = [](const std::string& reason) {
+    std::cout << "[Analytical, Simulation] Symmetry reduction disabled: "
+              << reason << std::endl;
+    return std::shared_ptr<SymmetryReduction>(nullptr);
+  };
+
+  // link reservations need the messages of every NPU, and the full run
+  // serves translated messages contending for a link in NPU id order
+  if (simulation_config.link_contention) {
+    return not_symmetric("link contention");
+  }
+
+  // All-to-Allv sizes differ per NPU pair
+  if (sys.traffic_matrix != nullptr) {
+    return not_symmetric("All-to-Allv traffic matrix");
+  }
+
+  // every NPU must run the same, translation-invariant schedule
+  if (sys.rendezvous_enabled) {
+    return not_symmetric("rendezvous protocol");
+  }
+  if (sys.boost_mode) {
+    return not_symmetric("boost mode enables a subset of NPUs");
+  }
+  if (sys.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::Ascending &&
+      sys.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::ND_Torus_Ring &&
+      sys.inter_dimension_scheduling !=
+          AstraSim::InterDimensionScheduling::
+              ND_Torus_Ring_AlltoAll_AllReduce) {
+    return not_symmetric("inter-dimension scheduling");
+  }
+  for (const auto* implementations :
+       {&sys.all_reduce_implementation_per_dimension,
+        &sys.reduce_scatter_implementation_per_dimension,
+        &sys.all_gather_implementation_per_dimension,
+        &sys.all_to_all_implementation_per_dimension}) {
+    for (const auto* implementation : *implementations) {
+      if (implementation->type !=
+              AstraSim::CollectiveImplementationType::Ring &&
+          implementation->type !=
+              AstraSim::CollectiveImplementationType::HalfRing) {
+        return not_symmetric("collective other than ring/halfring");
+      }
+    }
+  }
+
+  // non-uniform All-to-All: message sizes depend on the expert of each NPU
+  // (npu id % experts count), so only translations keeping it are symmetries
+  auto period = (sys.non_uniform_flag != 0) ? sys.moe_experts_count : 1;
+  auto strides =
+      SymmetryReduction::strides_for_period(net.units_counts, period);
+
+  // faulty links: keep the smallest multiple of each stride that maps the
+  // failed links onto each other (the whole dimension if none does)
+  if (faulty_links != nullptr) {
+    for (auto dim = 0; dim < net.dimensions_count; dim++) {
+      auto units_count = net.units_counts[dim];
+      auto stride = strides[dim];
+      while (stride < units_count &&
+             (units_count % stride != 0 ||
+              !faulty_links->is_translation_invariant(dim, stride))) {
+        stride += strides[dim];
+      }
+      strides[dim] = stride;
+    }
+  }
+  auto symmetry_reduction =
+      std::make_shared<SymmetryReduction>(net.units_counts, strides);
+  if (symmetry_reduction->get_orbit_size() == 1) {
+    return not_symmetric("no translation symmetry");
+  }
+  return symmetry_reduction;
+}
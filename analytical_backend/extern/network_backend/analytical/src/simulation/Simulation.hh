@@ -0,0 +1,197 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SIMULATION_HH__
+#define __SIMULATION_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../event-queue/EventQueue.hh"
+#include "../topology/FaultyLinks.hh"
+#include "../topology/SymmetryReduction.hh"
+#include "NetworkConfig.hh"
+#include "astra-sim/system/InputFiles.hh"
+
+namespace AstraSim {
+class Sys;
+} // namespace AstraSim
+
+namespace Analytical {
+/**
+ * Closed-form estimate of the workload's All-to-All collectives
+ * (see AllToAllEstimator).
+ * - Off: event-driven simulation only
+ * - Only: print the estimate, skip the event-driven simulation
+ * - Validate: run both and compare each All-to-All collective
+ */
+enum class EstimateMode { Off, Only, Validate };
+
+/**
+ * Network-agnostic options of one run (system, workload, stats).
+ */
+struct SimulationConfig {
+ public:
+  std::string system_configuration = "system path not defined";
+  std::string workload_configuration = "workload path not defined";
+  int num_passes = 1;
+  int num_queues_per_dim = 1;
+  float comm_scale = 1;
+  float compute_scale = 1;
+  float injection_scale = 1;
+  std::string path = "path not defined";
+  std::string run_name = "unnamed run";
+  int total_stat_rows = 1;
+  int stat_row = 0;
+  bool rendezvous_protocol = false;
+  EventQueue::EngineType event_queue_engine_type = EventQueue::EngineType::Heap;
+
+  /**
+   * whether run() writes backend_end_to_end.csv and backend_dim_info.csv
+   * into path (the sweep driver writes them itself from SimulationResult)
+   */
+  bool write_backend_csv = true;
+
+  /**
+   * write the CSV cells of this run into per-run fragment files (indexed by
+   * stat_row) without locking; the run that completes the set merges them
+   * (see AstraSim::CSVWriter::merge_fragments)
+   */
+  bool csv_fragments = false;
+
+  /**
+   * simulate only one representative NPU per translation orbit when the
+   * configuration allows it (see Simulation::detect_symmetry)
+   */
+  bool symmetry_reduction = false;
+
+  /**
+   * charge messages for the time their links are busy with other messages
+   * (see HierarchicalTopology::enableLinkContention)
+   */
+  bool link_contention = false;
+
+  /**
+   * compare the system-layer clock against the backend time on every read
+   * (debugging aid, see Sys::boostedTick)
+   */
+  bool clock_check = false;
+
+  EstimateMode estimate_mode = EstimateMode::Off;
+};
+
+/**
+ * End-to-end result of one run, as reported by NPU 0.
+ * Times are in the units of AstraSimDataAPI, payload sizes in MB.
+ */
+struct SimulationResult {
+ public:
+  bool finished = false;
+  std::string run_name;
+  double workload_finished_time = 0;
+  double total_compute = 0;
+  double total_exposed_comm = 0;
+  double total_cost = 0;
+  double total_payload_size = 0;
+  std::vector<double> payload_size_per_dim;
+  std::vector<double> avg_chunk_latency_per_dim;
+
+  /**
+   * Workload finish times over all NPUs (a symmetry-reduced run gives each
+   * NPU the time of its orbit representative): fastest, median, 99th
+   * percentile (tail), and slowest, with the id of the slowest NPU.
+   * max_finished_time - min_finished_time is the finish-time skew.
+   */
+  double min_finished_time = 0;
+  double median_finished_time = 0;
+  double tail_finished_time = 0;
+  double max_finished_time = 0;
+  int slowest_npu = -1;
+
+  /**
+   * Blocks handed out and most blocks in use of each system-layer object
+   * pool (indexed by AstraSim::ObjectPools::Type), for all NPUs (see
+   * backend_pool_stats.csv)
+   */
+  std::vector<uint64_t> pool_allocations_count;
+  std::vector<uint64_t> pool_peak_in_use;
+
+  EstimateMode estimate_mode = EstimateMode::Off;
+
+  /**
+   * why the workload could not be estimated (see AllToAllEstimator::check),
+   * empty if it was or estimate_mode is Off
+   */
+  std::string estimate_error;
+
+  /**
+   * EstimateMode::Validate: whether every estimated collective is within
+   * Simulation::estimate_tolerance of the simulated one (false if the
+   * workload could not be estimated), and the largest relative error
+   */
+  bool estimate_within_tolerance = true;
+  double estimate_max_error = 0;
+};
+
+/**
+ * One analytical simulation: event queue, topology, and every NPU's network,
+ * memory, and system layer.
+ *
+ * All simulation state lives in the contexts owned by run(), so independent
+ * Simulation objects can run concurrently on different threads.
+ * (Runs writing into the same stat path must not overlap.)
+ * Only the parsed input files may be shared between runs.
+ */
+class Simulation {
+ public:
+  /**
+   * @param network_config parsed network configuration (shared, read-only)
+   * @param simulation_config options of this run
+   * @param input_files parsed system-layer input files shared with other
+   * runs, nullptr to parse them for this run only
+   */
+  Simulation(
+      std::shared_ptr<const NetworkConfig> network_config,
+      const SimulationConfig& simulation_config,
+      std::shared_ptr<AstraSim::InputFiles> input_files = nullptr) noexcept;
+
+  /**
+   * Build all NPUs and run the simulation to completion on the calling
+   * thread.
+   * @return end-to-end result reported by NPU 0
+   */
+  SimulationResult run() noexcept;
+
+  /**
+   * Largest relative error of an estimated All-to-All collective accepted by
+   * EstimateMode::Validate.
+   */
+  static constexpr double estimate_tolerance = 0.01;
+
+ private:
+  /**
+   * Check whether every NPU runs the same schedule up to a translation of
+   * the torus (uniform ring/halfring collectives, no rendezvous or boost
+   * mode, translation-invariant inter-dimension scheduling).
+   * link-failure is modeled per dimension by both the system layer and
+   * HierarchicalTopology, so it keeps the symmetry. Faulty links only keep
+   * the translations that map them onto each other: NPUs are then split
+   * into the (smaller) orbit classes of those translations.
+   * @param sys NPU 0, with its system configuration parsed
+   * @param faulty_links explicitly placed link failures, nullptr if none
+   * @return symmetry of the run, or nullptr if all NPUs must be simulated
+   */
+  std::shared_ptr<SymmetryReduction> detect_symmetry(
+      const AstraSim::Sys& sys,
+      const FaultyLinks* faulty_links) const noexcept;
+
+  std::shared_ptr<const NetworkConfig> network_config;
+  SimulationConfig simulation_config;
+  std::shared_ptr<AstraSim::InputFiles> input_files;
+};
+} // namespace Analytical
+
+#endif
@@ -0,0 +1,78 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "Sweep.hh"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include "../helper/WorkStealingPool.hh"
+#include "SweepResultWriter.hh"
+
+using namespace Analytical;
+
+Sweep::Sweep(std::vector<SweepEntry> entries, int threads_count) noexcept
+    : entries(std::move(entries)), threads_count(threads_count) {}
+
+bool Sweep::run() noexcept {
+  auto start_time = std::chrono::steady_clock::now();
+
+  // parse every network configuration once
+  auto network_configs =
+      std::map<std::string, std::shared_ptr<const NetworkConfig>>();
+  for (const auto& entry : entries) {
+    auto& network_config = network_configs[entry.network_configuration];
+    if (network_config == nullptr) {
+      network_config = std::make_shared<const NetworkConfig>(
+          NetworkConfig::parse(entry.network_configuration));
+    }
+  }
+
+  // system, workload and traffic files, parsed once for all runs
+  auto input_files = std::make_shared<AstraSim::InputFiles>();
+
+  auto result_writer = SweepResultWriter();
+  auto finished_runs_count = std::atomic<int>(0);
+  auto runs_count = (int)entries.size();
+  auto tasks = std::vector<WorkStealingPool::Task>();
+  for (const auto& entry : entries) {
+    const auto& config = entry.simulation_config;
+    if (config.stat_row == 0) {
+      result_writer.add_path(config.path, config.total_stat_rows);
+    }
+
+    // each run writes its system-layer CSVs alone, into its own directory
+    auto run_config = config;
+    run_config.path = config.path + config.run_name + "/";
+    run_config.stat_row = 0;
+    run_config.total_stat_rows = 1;
+    run_config.write_backend_csv = false;
+    std::filesystem::create_directories(run_config.path);
+
+    auto network_config = network_configs[entry.network_configuration];
+    tasks.emplace_back([&, network_config, run_config, config]() {
+      auto simulation = Simulation(network_config, run_config, input_files);
+      auto result = simulation.run();
+      result_writer.record(config.path, config.stat_row, result);
+      std::cout << "[Analytical, Sweep] Finished " << ++finished_runs_count
+                << "/" << runs_count << ": " << config.run_name << std::endl;
+    });
+  }
+
+  auto pool = WorkStealingPool(threads_count);
+  pool.run(std::move(tasks));
+  auto estimates_ok = result_writer.flush();
+
+  auto elapsed_time = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start_time)
+                          .count();
+  std::cout << "[Analytical, Sweep] " << runs_count << " runs on "
+            << threads_count << " threads (" << network_configs.size()
+            << " network configurations, " << pool.get_steals_count()
+            << " steals) finished in " << elapsed_time << " s" << std::endl;
+  return estimates_ok;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SWEEP_HH__
+#define __SWEEP_HH__
+
+#include <vector>
+#include "SweepManifest.hh"
+
+namespace Analytical {
+/**
+ * Runs every configuration of a sweep manifest in this process
+ * (--sweep-manifest), instead of launching AnalyticalAstra once per
+ * configuration.
+ *
+ * - Each network configuration file, and each system-layer input file
+ *   (see AstraSim::InputFiles), is parsed once and shared read-only by all
+ *   runs using it, until the sweep ends.
+ * - Runs are independent Simulations, executed on a WorkStealingPool.
+ * - backend_end_to_end.csv / backend_dim_info.csv of each stat path are
+ *   written once through a SweepResultWriter, in the layout the experiment
+ *   scripts produce.
+ * - The system-layer CSVs of a run (EndToEnd.csv, detailed.csv, ...) go to
+ *   <path>/<run-name>/, so concurrent runs never share a file.
+ */
+class Sweep {
+ public:
+  /**
+   * @param entries runs to execute
+   * @param threads_count number of runs executed concurrently
+   */
+  Sweep(std::vector<SweepEntry> entries, int threads_count) noexcept;
+
+  /**
+   * Run every entry, then write the result files.
+   * A run whose estimate fails or mismatches does not stop the others; it is
+   * recorded in backend_estimate.csv of its path.
+   * @return whether every requested estimate was computed and, when
+   * validated, within Simulation::estimate_tolerance
+   */
+  bool run() noexcept;
+
+ private:
+  std::vector<SweepEntry> entries;
+  int threads_count;
+};
+} // namespace Analytical
+
+#endif
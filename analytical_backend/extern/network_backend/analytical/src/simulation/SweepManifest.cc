@@ -0,0 +1,277 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SweepManifest.hh"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include "../helper/json.hh"
+
+using namespace Analytical;
+
+namespace {
+std::string trim(const std::string& text) noexcept {
+  auto begin = text.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  auto end = text.find_last_not_of(" \t\r\n");
+  return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> split_csv_line(const std::string& line) noexcept {
+  auto cells = std::vector<std::string>();
+  auto stream = std::stringstream(line);
+  auto cell = std::string();
+  while (std::getline(stream, cell, ',')) {
+    cells.emplace_back(trim(cell));
+  }
+  if (!line.empty() && line.back() == ',') {
+    cells.emplace_back("");
+  }
+  return cells;
+}
+
+std::string resolve_path(
+    const std::string& path,
+    const std::string& base_directory) noexcept {
+  if (path.empty() || std::filesystem::path(path).is_absolute()) {
+    return path;
+  }
+  return (std::filesystem::path(base_directory) / path).string();
+}
+
+bool parse_bool(const std::string& key, const std::string& value) noexcept {
+  if (value == "true" || value == "1") {
+    return true;
+  }
+  if (value == "false" || value == "0") {
+    return false;
+  }
+  std::cout << "[Analytical, SweepManifest] Invalid value of " << key << ": "
+            << value << std::endl;
+  exit(-1);
+}
+} // namespace
+
+std::vector<SweepEntry> SweepManifest::parse(
+    const std::string& manifest_path) noexcept {
+  auto extension = std::filesystem::path(manifest_path).extension().string();
+  auto rows = std::vector<Row>();
+  if (extension == ".json") {
+    rows = read_json(manifest_path);
+  } else if (extension == ".csv") {
+    rows = read_csv(manifest_path);
+  } else {
+    std::cout << "[Analytical, SweepManifest] Manifest must be .json or .csv: "
+              << manifest_path << std::endl;
+    exit(-1);
+  }
+
+  auto base_directory =
+      std::filesystem::path(manifest_path).parent_path().string();
+  auto entries = std::vector<SweepEntry>();
+  for (const auto& row : rows) {
+    entries.emplace_back(build_entry(row, base_directory));
+  }
+  assign_stat_rows(entries);
+  return entries;
+}
+
+std::vector<SweepManifest::Row> SweepManifest::read_json(
+    const std::string& manifest_path) noexcept {
+  auto manifest_file = std::ifstream(manifest_path);
+  if (!manifest_file.is_open()) {
+    std::cout << "[Analytical, SweepManifest] Cannot open manifest: "
+              << manifest_path << std::endl;
+    exit(-1);
+  }
+
+  auto manifest = nlohmann::json();
+  try {
+    manifest_file >> manifest;
+  } catch (const nlohmann::json::parse_error& e) {
+    std::cout << "[Analytical, SweepManifest] Invalid json manifest: "
+              << e.what() << std::endl;
+    exit(-1);
+  }
+
+  // json scalars are kept as text, so both formats share build_entry
+  auto to_row = [](const nlohmann::json& object) -> Row {
+    auto row = Row();
+    for (const auto& item : object.items()) {
+      row[item.key()] = item.value().is_string()
+          ? item.value().get<std::string>()
+          : item.value().dump();
+    }
+    return row;
+  };
+
+  auto defaults = Row();
+  auto runs = manifest;
+  if (manifest.is_object()) {
+    if (manifest.count("defaults") > 0) {
+      defaults = to_row(manifest["defaults"]);
+    }
+    runs = manifest["runs"];
+  }
+  if (!runs.is_array()) {
+    std::cout << "[Analytical, SweepManifest] Manifest has no list of runs: "
+              << manifest_path << std::endl;
+    exit(-1);
+  }
+
+  auto rows = std::vector<Row>();
+  for (const auto& run : runs) {
+    auto row = defaults;
+    for (const auto& [key, value] : to_row(run)) {
+      row[key] = value;
+    }
+    rows.emplace_back(std::move(row));
+  }
+  return rows;
+}
+
+std::vector<SweepManifest::Row> SweepManifest::read_csv(
+    const std::string& manifest_path) noexcept {
+  auto manifest_file = std::ifstream(manifest_path);
+  if (!manifest_file.is_open()) {
+    std::cout << "[Analytical, SweepManifest] Cannot open manifest: "
+              << manifest_path << std::endl;
+    exit(-1);
+  }
+
+  auto rows = std::vector<Row>();
+  auto header = std::vector<std::string>();
+  auto line = std::string();
+  while (std::getline(manifest_file, line)) {
+    line = trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    auto cells = split_csv_line(line);
+    if (header.empty()) {
+      header = cells;
+      continue;
+    }
+    if (cells.size() > header.size()) {
+      std::cout << "[Analytical, SweepManifest] Too many cells in row: "
+                << line << std::endl;
+      exit(-1);
+    }
+    auto row = Row();
+    for (size_t i = 0; i < cells.size(); i++) {
+      if (!cells[i].empty()) {
+        row[header[i]] = cells[i];
+      }
+    }
+    rows.emplace_back(std::move(row));
+  }
+  return rows;
+}
+
+SweepEntry SweepManifest::build_entry(
+    const Row& row,
+    const std::string& base_directory) noexcept {
+  auto entry = SweepEntry();
+  auto& config = entry.simulation_config;
+
+  for (const auto& [key, value] : row) {
+    if (key == "network-configuration") {
+      entry.network_configuration = resolve_path(value, base_directory);
+    } else if (key == "system-configuration") {
+      config.system_configuration = resolve_path(value, base_directory);
+    } else if (key == "workload-configuration") {
+      config.workload_configuration = resolve_path(value, base_directory);
+    } else if (key == "path") {
+      config.path = resolve_path(value, base_directory);
+    } else if (key == "run-name") {
+      config.run_name = value;
+    } else if (key == "num-passes") {
+      config.num_passes = std::stoi(value);
+    } else if (key == "num-queues-per-dim") {
+      config.num_queues_per_dim = std::stoi(value);
+    } else if (key == "comm-scale") {
+      config.comm_scale = std::stof(value);
+    } else if (key == "compute-scale") {
+      config.compute_scale = std::stof(value);
+    } else if (key == "injection-scale") {
+      config.injection_scale = std::stof(value);
+    } else if (key == "rendezvous-protocol") {
+      config.rendezvous_protocol = parse_bool(key, value);
+    } else if (key == "symmetry-reduction") {
+      config.symmetry_reduction = parse_bool(key, value);
+    } else if (key == "link-contention") {
+      config.link_contention = parse_bool(key, value);
+    } else if (key == "clock-check") {
+      config.clock_check = parse_bool(key, value);
+    } else if (key == "event-queue-engine") {
+      if (value == "heap") {
+        config.event_queue_engine_type = EventQueue::EngineType::Heap;
+      } else if (value == "list") {
+        config.event_queue_engine_type = EventQueue::EngineType::List;
+      } else {
+        std::cout << "[Analytical, SweepManifest] Event queue engine not "
+                  << "defined: " << value << std::endl;
+        exit(-1);
+      }
+    } else if (key == "estimate") {
+      if (value == "off") {
+        config.estimate_mode = EstimateMode::Off;
+      } else if (value == "only") {
+        config.estimate_mode = EstimateMode::Only;
+      } else if (value == "validate") {
+        config.estimate_mode = EstimateMode::Validate;
+      } else {
+        std::cout << "[Analytical, SweepManifest] Estimate mode not defined: "
+                  << value << std::endl;
+        exit(-1);
+      }
+    } else {
+      std::cout << "[Analytical, SweepManifest] Unknown key: " << key
+                << std::endl;
+      exit(-1);
+    }
+  }
+
+  for (const auto* key :
+       {"network-configuration",
+        "system-configuration",
+        "workload-configuration",
+        "path",
+        "run-name"}) {
+    if (row.count(key) == 0) {
+      std::cout << "[Analytical, SweepManifest] Run without " << key
+                << std::endl;
+      exit(-1);
+    }
+  }
+
+  // CSVWriter appends file names to the path as-is
+  if (config.path.back() != '/') {
+    config.path += '/';
+  }
+  return entry;
+}
+
+void SweepManifest::assign_stat_rows(std::vector<SweepEntry>& entries) noexcept {
+  auto rows_per_path = std::map<std::string, int>();
+  auto run_names_per_path = std::map<std::string, std::set<std::string>>();
+  for (auto& entry : entries) {
+    auto& config = entry.simulation_config;
+    if (!run_names_per_path[config.path].insert(config.run_name).second) {
+      std::cout << "[Analytical, SweepManifest] Duplicated run name "
+                << config.run_name << " in " << config.path << std::endl;
+      exit(-1);
+    }
+    config.stat_row = rows_per_path[config.path]++;
+  }
+  for (auto& entry : entries) {
+    auto& config = entry.simulation_config;
+    config.total_stat_rows = rows_per_path[config.path];
+  }
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SWEEPMANIFEST_HH__
+#define __SWEEPMANIFEST_HH__
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Simulation.hh"
+
+namespace Analytical {
+/**
+ * One configuration of a sweep.
+ */
+struct SweepEntry {
+ public:
+  std::string network_configuration;
+
+  /**
+   * path, run_name, stat_row and total_stat_rows are as the experiment
+   * scripts would pass them: runs sharing a path get consecutive stat rows
+   * in manifest order.
+   */
+  SimulationConfig simulation_config;
+};
+
+/**
+ * List of configurations to run in one process (--sweep-manifest).
+ *
+ * A .json manifest is either a list of runs or an object with a "runs" list
+ * and optional "defaults" applied to every run:
+ *   {"defaults": {"path": "results/MATE/"},
+ *    "runs": [{"run-name": "...", "network-configuration": "...",
+ *              "system-configuration": "...", "workload-configuration": "..."}]}
+ * A .csv manifest has a header row of keys and one run per row
+ * (empty cells fall back to the defaults; lines starting with # are skipped).
+ *
+ * Keys are the command line option names of a single run. Relative file
+ * paths are resolved against the manifest's directory.
+ */
+class SweepManifest {
+ public:
+  /**
+   * Parse a sweep manifest. Exits on malformed manifests.
+   * @param manifest_path path to the .json or .csv manifest
+   * @return runs in manifest order
+   */
+  static std::vector<SweepEntry> parse(
+      const std::string& manifest_path) noexcept;
+
+ private:
+  using Row = std::map<std::string, std::string>;
+
+  static std::vector<Row> read_json(const std::string& manifest_path) noexcept;
+
+  static std::vector<Row> read_csv(const std::string& manifest_path) noexcept;
+
+  /**
+   * Build one entry from its key/value row.
+   * @param row keys and values of this run (defaults already merged)
+   * @param base_directory directory relative paths are resolved against
+   * @return parsed entry (stat rows not assigned yet)
+   */
+  static SweepEntry build_entry(
+      const Row& row,
+      const std::string& base_directory) noexcept;
+
+  /**
+   * Give runs sharing a stat path consecutive stat rows.
+   * Exits if two runs of a path have the same run name.
+   */
+  static void assign_stat_rows(std::vector<SweepEntry>& entries) noexcept;
+};
+} // namespace Analytical
+
+#endif
@@ -0,0 +1,178 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SweepResultWriter.hh"
+#include <fstream>
+#include <iostream>
+#include "astra-sim/system/ObjectPool.hh"
+
+using namespace Analytical;
+
+void SweepResultWriter::add_path(
+    const std::string& path,
+    int total_stat_rows) noexcept {
+  auto& tables = tables_per_path[path];
+
+  tables.end_to_end =
+      Table(total_stat_rows + 1, std::vector<std::string>(13));
+  auto& header = tables.end_to_end[0];
+  header[0] = "RunName";
+  header[1] = "CommsTime";
+  header[2] = "ComputeTime";
+  header[3] = "ExposedCommsTime";
+  header[4] = "Cost";
+  header[5] = "TotalPayloadSize";
+  for (auto dim = 0; dim < 7; dim++) {
+    header[6 + dim] = "PayloadSize_Dim" + std::to_string(dim);
+  }
+
+  // fixme: assuming max_dimension is 10 (as the backend does)
+  tables.dimensional_info =
+      Table((total_stat_rows * 10) + 1, std::vector<std::string>(3));
+  tables.dimensional_info[0] = {
+      "RunName", "DimensionIndex", "AverageChunkLatency"};
+
+  tables.npu_finish_time =
+      Table(total_stat_rows + 1, std::vector<std::string>(7));
+  tables.npu_finish_time[0] = {
+      "RunName",
+      "MinFinishTime",
+      "MedianFinishTime",
+      "TailFinishTime",
+      "MaxFinishTime",
+      "FinishTimeSkew",
+      "SlowestNpu"};
+
+  auto types_count = (int)AstraSim::ObjectPools::Type::TypesCount;
+  tables.pool_stats = Table(
+      total_stat_rows + 1, std::vector<std::string>(1 + 2 * types_count));
+  tables.pool_stats[0][0] = "RunName";
+  for (auto type = 0; type < types_count; type++) {
+    auto name = std::string(AstraSim::ObjectPools::get_type_name(
+        (AstraSim::ObjectPools::Type)type));
+    tables.pool_stats[0][1 + 2 * type] = name + "Allocations";
+    tables.pool_stats[0][2 + 2 * type] = name + "PeakInUse";
+  }
+
+  tables.estimate = Table(total_stat_rows + 1, std::vector<std::string>(4));
+  tables.estimate[0] = {
+      "RunName", "EstimateMode", "EstimateStatus", "MaxEstimateError"};
+}
+
+void SweepResultWriter::record(
+    const std::string& path,
+    int stat_row,
+    const SimulationResult& result) noexcept {
+  auto lock = std::lock_guard<std::mutex>(mutex);
+  auto& tables = tables_per_path.at(path);
+
+  if (result.estimate_mode != EstimateMode::Off) {
+    auto validate = result.estimate_mode == EstimateMode::Validate;
+    auto status = std::string("estimated");
+    auto max_error = std::string();
+    if (!result.estimate_error.empty()) {
+      status = "cannot estimate: " + result.estimate_error;
+    } else if (validate && !result.finished) {
+      status = "not simulated";
+    } else if (validate) {
+      status = result.estimate_within_tolerance ? "within tolerance"
+                                                : "exceeds tolerance";
+      max_error = std::to_string(result.estimate_max_error);
+    }
+    tables.estimate[stat_row + 1] = {
+        result.run_name, validate ? "validate" : "only", status, max_error};
+    tables.has_estimates = true;
+    estimates_ok &= result.estimate_error.empty() &&
+        result.estimate_within_tolerance && (!validate || result.finished);
+  }
+
+  if (!result.finished) {
+    if (result.estimate_mode != EstimateMode::Only) {
+      std::cout << "[Analytical, SweepResultWriter] Run " << stat_row
+                << " of " << path << " did not report, row left empty"
+                << std::endl;
+    }
+    return;
+  }
+
+  auto& row = tables.end_to_end[stat_row + 1];
+  row[0] = result.run_name;
+  row[1] = std::to_string(result.workload_finished_time);
+  row[2] = std::to_string(result.total_compute);
+  row[3] = std::to_string(result.total_exposed_comm);
+  row[4] = std::to_string(result.total_cost);
+  row[5] = std::to_string(result.total_payload_size);
+  auto dims_count = (int)result.payload_size_per_dim.size();
+  for (auto dim = 0; dim < dims_count; dim++) {
+    row[6 + dim] = std::to_string(result.payload_size_per_dim[dim]);
+  }
+  for (auto dim = dims_count; dim < 7; dim++) {
+    row[6 + dim] = "-1";
+  }
+
+  auto base_index = (stat_row * 10) + 1;
+  for (size_t i = 0; i < result.avg_chunk_latency_per_dim.size(); i++) {
+    tables.dimensional_info[base_index + i] = {
+        result.run_name,
+        std::to_string(i),
+        std::to_string(result.avg_chunk_latency_per_dim[i])};
+  }
+
+  tables.npu_finish_time[stat_row + 1] = {
+      result.run_name,
+      std::to_string(result.min_finished_time),
+      std::to_string(result.median_finished_time),
+      std::to_string(result.tail_finished_time),
+      std::to_string(result.max_finished_time),
+      std::to_string(result.max_finished_time - result.min_finished_time),
+      std::to_string(result.slowest_npu)};
+
+  auto& pool_stats_row = tables.pool_stats[stat_row + 1];
+  pool_stats_row[0] = result.run_name;
+  auto types_count = (int)result.pool_allocations_count.size();
+  for (auto type = 0; type < types_count; type++) {
+    pool_stats_row[1 + 2 * type] =
+        std::to_string(result.pool_allocations_count[type]);
+    pool_stats_row[2 + 2 * type] =
+        std::to_string(result.pool_peak_in_use[type]);
+  }
+}
+
+bool SweepResultWriter::flush() noexcept {
+  auto lock = std::lock_guard<std::mutex>(mutex);
+  for (const auto& [path, tables] : tables_per_path) {
+    write_table(path + "backend_end_to_end.csv", tables.end_to_end);
+    write_table(path + "backend_dim_info.csv", tables.dimensional_info);
+    write_table(path + "backend_npu_finish_time.csv", tables.npu_finish_time);
+    write_table(path + "backend_pool_stats.csv", tables.pool_stats);
+    if (tables.has_estimates) {
+      write_table(path + "backend_estimate.csv", tables.estimate);
+    }
+  }
+  return estimates_ok;
+}
+
+void SweepResultWriter::write_table(
+    const std::string& file_path,
+    const Table& table) noexcept {
+  auto file = std::ofstream(file_path);
+  if (!file.is_open()) {
+    std::cerr << "Unable to create file: " << file_path << std::endl;
+    std::cerr
+        << "This error is fatal. Please make sure the CSV write path exists."
+        << std::endl;
+    exit(1);
+  }
+
+  for (const auto& row : table) {
+    for (size_t column = 0; column < row.size(); column++) {
+      if (column > 0) {
+        file << ',';
+      }
+      file << row[column];
+    }
+    file << '\n';
+  }
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SWEEPRESULTWRITER_HH__
+#define __SWEEPRESULTWRITER_HH__
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Simulation.hh"
+
+namespace Analytical {
+/**
+ * Single buffered writer of the backend result CSVs of a sweep.
+ *
+ * Results are kept in memory, one backend_end_to_end.csv,
+ * backend_dim_info.csv, backend_npu_finish_time.csv, and
+ * backend_pool_stats.csv table per stat path, and every file is written
+ * once by flush(). The tables have the same layout as the ones the analytical
+ * backend writes cell by cell when each run is launched on its own.
+ */
+class SweepResultWriter {
+ public:
+  /**
+   * Allocate the tables of a stat path (call before any record()).
+   * @param path stat path
+   * @param total_stat_rows number of runs writing into path
+   */
+  void add_path(const std::string& path, int total_stat_rows) noexcept;
+
+  /**
+   * Fill the row of one run. Safe to call from concurrent runs.
+   * A run with an estimate mode also fills its row of backend_estimate.csv:
+   * whether the estimate was computed (or why not) and, for
+   * EstimateMode::Validate, whether it matched the simulation.
+   * @param path stat path of the run
+   * @param stat_row row of the run within path
+   * @param result result of the run
+   */
+  void record(
+      const std::string& path,
+      int stat_row,
+      const SimulationResult& result) noexcept;
+
+  /**
+   * Write every table into its file (backend_estimate.csv only for paths
+   * with estimates).
+   * @return whether every estimate was computed and, when validated, within
+   * Simulation::estimate_tolerance
+   */
+  bool flush() noexcept;
+
+ private:
+  using Table = std::vector<std::vector<std::string>>;
+
+  struct PathTables {
+    Table end_to_end;
+    Table dimensional_info;
+    Table npu_finish_time;
+    Table pool_stats;
+    Table estimate;
+    bool has_estimates = false; // whether a run of the path used --estimate
+  };
+
+  static void write_table(
+      const std::string& file_path,
+      const Table& table) noexcept;
+
+  std::mutex mutex;
+  std::map<std::string, PathTables> tables_per_path;
+  bool estimates_ok = true;
+};
+} // namespace Analytical
+
+#endif
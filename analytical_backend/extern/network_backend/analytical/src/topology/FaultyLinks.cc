@@ -0,0 +1,151 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "FaultyLinks.hh"
+#include <iostream>
+
+using namespace Analytical;
+
+FaultyLinks::FaultyLinks(
+    std::vector<int> units_counts,
+    const std::vector<TopologyList>& topologies_per_dim,
+    const std::vector<std::vector<int>>& faulty_links) noexcept
+    : units_counts(std::move(units_counts)) {
+  auto dimensions_count = (int)this->units_counts.size();
+  npus_count = 1;
+  for (auto dim = 0; dim < dimensions_count; dim++) {
+    strides.emplace_back(npus_count);
+    npus_count *= this->units_counts[dim];
+  }
+  failed_positions.resize(dimensions_count);
+
+  auto invalid_link = [](const std::vector<int>& link, const char* reason) {
+    std::cout << "[FaultyLinks] Invalid faulty link [";
+    for (size_t i = 0; i < link.size(); i++) {
+      std::cout << ((i > 0) ? ", " : "") << link[i];
+    }
+    std::cout << "]: " << reason << std::endl;
+    exit(-1);
+  };
+
+  for (const auto& link : faulty_links) {
+    if (link.size() != 2) {
+      invalid_link(link, "not an NPU id pair");
+    }
+    auto src = link[0];
+    auto dest = link[1];
+    if (src < 0 || src >= npus_count || dest < 0 || dest >= npus_count) {
+      invalid_link(link, "NPU id out of bounds");
+    }
+
+    // the two ends must only differ along one dimension
+    auto src_address = npu_id_to_address(src);
+    auto dest_address = npu_id_to_address(dest);
+    auto dim = -1;
+    for (auto i = 0; i < dimensions_count; i++) {
+      if (src_address[i] != dest_address[i]) {
+        if (dim != -1) {
+          invalid_link(link, "ends differ in several dimensions");
+        }
+        dim = i;
+      }
+    }
+    if (dim == -1) {
+      invalid_link(link, "both ends are the same NPU");
+    }
+    if (topologies_per_dim[dim] != TopologyList::Ring) {
+      invalid_link(link, "not on a Ring dimension");
+    }
+
+    // ... and be ring neighbors
+    auto units_count = this->units_counts[dim];
+    if (units_count == 2) {
+      invalid_link(link, "failure in a 2-node ring");
+    }
+    auto position = -1;
+    if ((src_address[dim] + 1) % units_count == dest_address[dim]) {
+      position = src_address[dim];
+    } else if ((dest_address[dim] + 1) % units_count == src_address[dim]) {
+      position = dest_address[dim];
+    } else {
+      invalid_link(link, "ends are not ring neighbors");
+    }
+
+    auto ring_id = get_ring_id(dim, src);
+    auto ring = failed_positions[dim].find(ring_id);
+    if (ring == failed_positions[dim].end()) {
+      failed_positions[dim][ring_id] = position;
+    } else if (ring->second != position) {
+      invalid_link(link, "second failed link in the same ring");
+    }
+  }
+}
+
+int FaultyLinks::get_failed_position(int dimension, NpuId npu_id)
+    const noexcept {
+  const auto& positions = failed_positions[dimension];
+  auto ring = positions.find(get_ring_id(dimension, npu_id));
+  return (ring == positions.end()) ? -1 : ring->second;
+}
+
+std::vector<int> FaultyLinks::get_failures_per_dimension(NpuId npu_id)
+    const noexcept {
+  auto dimensions_count = (int)units_counts.size();
+  auto failures_per_dimension = std::vector<int>();
+  for (auto dim = 0; dim < dimensions_count; dim++) {
+    failures_per_dimension.emplace_back(
+        (get_failed_position(dim, npu_id) == -1) ? 0 : 1);
+  }
+  return failures_per_dimension;
+}
+
+bool FaultyLinks::has_failures(int dimension) const noexcept {
+  return !failed_positions[dimension].empty();
+}
+
+int FaultyLinks::get_failures_count() const noexcept {
+  auto failures_count = 0;
+  for (const auto& positions : failed_positions) {
+    failures_count += positions.size();
+  }
+  return failures_count;
+}
+
+bool FaultyLinks::is_translation_invariant(int dimension, int shift)
+    const noexcept {
+  auto units_count = units_counts[dimension];
+  auto dimensions_count = (int)units_counts.size();
+  for (auto dim = 0; dim < dimensions_count; dim++) {
+    for (const auto& ring : failed_positions[dim]) {
+      // translate the first NPU of the ring; a ring of dimension itself
+      // maps onto itself, with its failed link moved along
+      auto index = (ring.first / strides[dimension]) % units_count;
+      auto translated_npu = ring.first +
+          ((index + shift) % units_count - index) * strides[dimension];
+      auto translated_position = (dim == dimension)
+          ? (ring.second + shift) % units_count
+          : ring.second;
+      if (get_failed_position(dim, translated_npu) != translated_position) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+FaultyLinks::NpuAddress FaultyLinks::npu_id_to_address(
+    NpuId npu_id) const noexcept {
+  auto address = NpuAddress();
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    address.emplace_back((npu_id / strides[dim]) % units_counts[dim]);
+  }
+  return address;
+}
+
+FaultyLinks::NpuId FaultyLinks::get_ring_id(int dimension, NpuId npu_id)
+    const noexcept {
+  auto index = (npu_id / strides[dimension]) % units_counts[dimension];
+  return npu_id - index * strides[dimension];
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __FAULTYLINKS_HH__
+#define __FAULTYLINKS_HH__
+
+#include <unordered_map>
+#include <vector>
+#include "HierarchicalTopologyConfig.hh"
+#include "TopologyConfig.hh"
+
+namespace Analytical {
+/**
+ * Explicitly placed link failures of a hierarchical torus.
+ *
+ * Failures are given as NPU id pairs, as Garnet's faulty_links_string
+ * (e.g., [[2, 26], [3, 27]]). Each pair must be the two ends of a link of a
+ * Ring dimension; the physical link is unusable in both directions, and
+ * [a, b] and [b, a] are the same failure.
+ *
+ * Each ring (the NPUs that only differ along one dimension) may have at
+ * most one failed link, so FoldedRing/MATE can run on it as a line. Several
+ * rings of the same dimension may fail independently.
+ */
+class FaultyLinks {
+ public:
+  using NpuId = TopologyConfig::NpuId;
+  using NpuAddress = TopologyConfig::NpuAddress;
+  using TopologyList = HierarchicalTopologyConfig::TopologyList;
+
+  /**
+   * Exits if a pair is not a Ring link or a ring gets a second failure.
+   * @param units_counts NPUs count of each dimension
+   * @param topologies_per_dim topology of each dimension
+   * @param faulty_links failed links, as (src, dest) NPU id pairs
+   */
+  FaultyLinks(
+      std::vector<int> units_counts,
+      const std::vector<TopologyList>& topologies_per_dim,
+      const std::vector<std::vector<int>>& faulty_links) noexcept;
+
+  /**
+   * @param dimension dimension of the ring
+   * @param npu_id any NPU of the ring
+   * @return position p of the failed link between the NPUs at p and
+   * (p + 1) % units_count along dimension, -1 if the ring is intact
+   */
+  int get_failed_position(int dimension, NpuId npu_id) const noexcept;
+
+  /**
+   * @return failed links of the ring of npu_id along each dimension
+   */
+  std::vector<int> get_failures_per_dimension(NpuId npu_id) const noexcept;
+
+  /**
+   * @return whether a ring of dimension has a failed link
+   */
+  bool has_failures(int dimension) const noexcept;
+
+  /**
+   * @return number of failed links
+   */
+  int get_failures_count() const noexcept;
+
+  /**
+   * @param dimension dimension to translate along
+   * @param shift translation distance, in NPUs
+   * @return whether the translation maps the failed links onto each other
+   */
+  bool is_translation_invariant(int dimension, int shift) const noexcept;
+
+ private:
+  NpuAddress npu_id_to_address(NpuId npu_id) const noexcept;
+
+  /**
+   * @return id of the ring of npu_id along dimension (its first NPU)
+   */
+  NpuId get_ring_id(int dimension, NpuId npu_id) const noexcept;
+
+  std::vector<int> units_counts;
+  std::vector<int> strides;
+  int npus_count;
+
+  // failed position of each failed ring, per dimension
+  std::vector<std::unordered_map<NpuId, int>> failed_positions;
+};
+} // namespace Analytical
+
+#endif
@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "HierarchicalTopology.hh"
+#include <algorithm>
 #include <iostream>
 #include <cassert> 
 
@@ -244,7 +245,8 @@ std::pair<double, int> HierarchicalTopology::send(
     int stream_count_ID,
     int link_failure_scheduling_flag,
     int chunk_stage,
-    int failure_type) noexcept { 
+    int failure_type,
+    Latency send_time) noexcept { 
   
   checkNpuIdBound(src);
   checkNpuIdBound(dest);
@@ -253,100 +255,225 @@ std::pair<double, int> HierarchicalTopology::send(
     return std::make_pair(0, -1);
   }
 
-  // FIXME: assuming only one dimension, from higher, is used at a time
   auto src_address = npuIdToAddress(src);
   auto dest_address = npuIdToAddress(dest);
+  auto route_dims = getRouteDimensions(src, dest);
 
-  // find mismatching dim
-  auto dim = hierarchy_config.getDimensionsCount() - 1;
-  while (dim >= 0) {
+  // MATE acceleration stage: detour of MATE_hops hops through the other
+  // dimensions (MATE_hops = 3)
+  auto mate_stage =
+      (link_failure_scheduling_flag == 1 || link_failure_scheduling_flag == 2) &&
+      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)));
+  // MATE (not enhanced) stage on the failed ring itself
+  auto mate_ring_stage = (link_failure_scheduling_flag == 1) &&
+      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
+       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4)));
+  const int MATE_hops = 3;
+
+  // walk the dimensions in order: propagation, NIC and router latencies add
+  // up, and the slowest dimension sets the serialization latency
+  auto communication_latency = 0;
+  auto serialization_latency = 0.0;
+  auto hbm_latency = 0.0;
+  auto links = std::vector<int>();
+  auto current_address = src_address;
+  auto current_npu = src;
+  for (auto dim : route_dims) {
+    auto topology = hierarchy_config.getTopologyForDim(dim);
+    auto failed_position = getFailedPosition(dim, current_npu);
+    auto ring_failed = (failed_position != -1);
+    int acceleration_element = 1;
+    if ((mate_stage || mate_ring_stage) && ring_failed) {
+      acceleration_element = 2;
+    }
+
+    // a ring with a failed link is used as a line (FoldedRing)
+    auto folded_route = ring_failed && !mate_ring_stage;
+
+    // for following packets, propagation delay is ignored
+    if (stream_count_ID == 0) {
+      auto hops_count = 0;
+      if (topology == TopologyList::Ring) {
+        // currently our fault tolerance algorithm only supports Hierarchical_Ring Topologies
+        auto distanceA = std::abs(current_address[dim] - dest_address[dim]);
+        auto distanceB = configs[dim].getNpusCount() - distanceA;
+        hops_count = (distanceA < distanceB)
+            ? distanceA
+            : distanceB; // shorter one becomes the hop count
+
+        if (folded_route) {
+          // the hops will be modified as the length of ring
+          hops_count = configs[dim].getNpusCount() - 1;
+        }
+        if (mate_stage) {
+          hops_count = MATE_hops;
+        }
+      } else if (topology == TopologyList::FullyConnected) {
+        hops_count = 1;
+      } else if (topology == TopologyList::Switch) {
+        hops_count = 2;
+      }
+      communication_latency += linkLatency(dim, hops_count);
+    }
+
+    auto dim_serialization_latency =
+        serializationLatency(dim, payload_size, acceleration_element);
+    if (ring_failed && faulty_links != nullptr) {
+      // half of the ring bandwidth, as link-failure does for a whole
+      // dimension
+      dim_serialization_latency *= 2;
+    }
+    serialization_latency =
+        std::max(serialization_latency, dim_serialization_latency);
+    hbm_latency = std::max(hbm_latency, hbmLatency(dim, payload_size));
+
+    if (link_contention) {
+      // MATE detours over other dimensions are charged to this dimension's
+      // route
+      auto dim_links = getRoute(
+          dim,
+          current_npu,
+          current_address,
+          dest_address,
+          folded_route ? failed_position : -1);
+      links.insert(links.end(), dim_links.begin(), dim_links.end());
+    }
+    current_address[dim] = dest_address[dim];
+    current_npu = npuAddressToId(current_address);
+  }
+
+  communication_latency += serialization_latency;
+  for (auto dim : route_dims) {
+    communication_latency += 2 * nicLatency(dim);
+    if (hierarchy_config.getTopologyForDim(dim) == TopologyList::Switch) {
+      communication_latency += routerLatency(dim);
+    }
+  }
+
+  if (link_contention) {
+    communication_latency +=
+        reserveRoute(links, send_time, serialization_latency);
+  }
+
+  return std::make_pair(
+      criticalLatency(communication_latency, hbm_latency), route_dims.back());
+}
+
+std::vector<int> HierarchicalTopology::getRouteDimensions(
+    NpuId src,
+    NpuId dest) const noexcept {
+  auto src_address = npuIdToAddress(src);
+  auto dest_address = npuIdToAddress(dest);
+
+  // dimension-ordered routing, from the lowest dimension
+  auto route_dims = std::vector<int>();
+  for (auto dim = 0; dim < hierarchy_config.getDimensionsCount(); dim++) {
     if (src_address[dim] != dest_address[dim]) {
-      break;
+      route_dims.emplace_back(dim);
     }
-    dim--;
   }
+  return route_dims;
+}
 
-  // use that dimension
-  auto communication_latency = 0;
-  auto topology = hierarchy_config.getTopologyForDim(dim);
-  int acceleration_element = 1;
-  int MATE_hops; 
-  if ((link_failure_scheduling_flag == 1 || link_failure_scheduling_flag == 2) &&
-      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4))) &&
-      (link_failure_vector[dim] != 0)) {
-    acceleration_element = 2;
-    MATE_hops = 3;
+void HierarchicalTopology::setFaultyLinks(
+    std::shared_ptr<const FaultyLinks> faulty_links) noexcept {
+  this->faulty_links = std::move(faulty_links);
+}
+
+int HierarchicalTopology::getFailedPosition(int dimension, NpuId npu_id)
+    const noexcept {
+  if (faulty_links != nullptr && faulty_links->has_failures(dimension)) {
+    return faulty_links->get_failed_position(dimension, npu_id);
   }
-  if ((link_failure_scheduling_flag == 1 || link_failure_scheduling_flag == 2) &&
-      ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4))) &&
-      (link_failure_vector[dim] == 0)) {
-    MATE_hops = 3;
+  // link-failure: every ring of the dimension, between its last and first
+  // NPU
+  if (link_failure_vector[dimension] != 0) {
+    return configs[dimension].getNpusCount() - 1;
   }
-  if ((link_failure_scheduling_flag == 1) &&
-      ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-       (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))) &&
-      (link_failure_vector[dim] != 0)) {
-    acceleration_element = 2;
+  return -1;
+}
+
+void HierarchicalTopology::enableLinkContention() noexcept {
+  link_contention = true;
+
+  auto links_count = 0;
+  auto stride = 1;
+  for (auto dim = 0; dim < hierarchy_config.getDimensionsCount(); dim++) {
+    auto topology = hierarchy_config.getTopologyForDim(dim);
+    auto topology_size = configs[dim].getNpusCount();
+
+    // Ring: to the next and to the previous NPU
+    // FullyConnected: to every NPU of the dimension (index by its address)
+    // Switch: uplink and downlink
+    auto links = (topology == TopologyList::FullyConnected) ? topology_size : 2;
+
+    link_offsets.emplace_back(links_count);
+    links_per_npu.emplace_back(links);
+    npu_strides.emplace_back(stride);
+    links_count += npus_count * links;
+    stride *= topology_size;
   }
 
-  if (stream_count_ID == 0) {
-    // here we calculate propagation delay for every chunk
-    if (topology == TopologyList::Ring) {
-      // currently our fault tolerance algorithm only supports Hierarchical_Ring Topologies
-      auto distanceA = std::abs(src_address[dim] - dest_address[dim]);
-      auto distanceB = configs[dim].getNpusCount() - distanceA;
-      auto hops_count = (distanceA < distanceB)
-          ? distanceA
-          : distanceB; // shorter one becomes the hop count
-
-      if ((link_failure_vector[dim] != 0) && !((link_failure_scheduling_flag == 1) &&
-           ((chunk_stage % 2 == 0 && failure_type != 1 && failure_type != 4) ||
-            (chunk_stage % 3 == 0 && (failure_type == 1 || failure_type == 4))))) {
-        // the hops will be modified as the length of ring
-        hops_count = configs[dim].getNpusCount() - 1;  
-      }
-      if ((link_failure_scheduling_flag == 1 || link_failure_scheduling_flag == 2) &&
-          ((chunk_stage % 2 == 1 && failure_type != 1 && failure_type != 4) ||
-           (chunk_stage % 3 != 0 && (failure_type == 1 || failure_type == 4)))) {
-        hops_count = MATE_hops;
-      }
-      communication_latency = linkLatency(dim, hops_count);
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-    } else if (topology == TopologyList::FullyConnected) {
-      const auto hops_count = 1;
-      communication_latency = linkLatency(dim, hops_count);
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-    } else if (topology == TopologyList::Switch) {
-      const auto hops_count = 2;
-      communication_latency = linkLatency(dim, hops_count);
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-      communication_latency += routerLatency(dim);
+  link_free_times.assign(links_count, 0);
+}
+
+std::vector<int> HierarchicalTopology::getRoute(
+    int dimension,
+    NpuId src,
+    const NpuAddress& src_address,
+    const NpuAddress& dest_address,
+    int failed_position) const noexcept {
+  auto route = std::vector<int>();
+  auto topology = hierarchy_config.getTopologyForDim(dimension);
+  auto topology_size = configs[dimension].getNpusCount();
+  auto offset = link_offsets[dimension];
+  auto links = links_per_npu[dimension];
+  auto stride = npu_strides[dimension];
+  auto src_index = src_address[dimension];
+  auto dest_index = dest_address[dimension];
+
+  if (topology == TopologyList::Ring) {
+    auto forward_hops = (dest_index - src_index + topology_size) % topology_size;
+    auto backward_hops = topology_size - forward_hops;
+    auto forward = forward_hops <= backward_hops;
+    if (failed_position != -1) {
+      // go forward only if that does not cross the failed link
+      auto failed_distance =
+          (failed_position - src_index + topology_size) % topology_size;
+      forward = failed_distance >= forward_hops;
     }
-  } else {
-    // for following packets, propagation delay is ignored
-    if (topology == TopologyList::Ring) {
-      // currently our fault tolerance algorithm only supports Hierarchical_Ring Topologies 
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-    } else if (topology == TopologyList::FullyConnected) {
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-    } else if (topology == TopologyList::Switch) {
-      communication_latency += serializationLatency(dim, payload_size, acceleration_element);
-      communication_latency += 2 * nicLatency(dim);
-      communication_latency += routerLatency(dim);
+    auto hops_count = forward ? forward_hops : backward_hops;
+    auto step = forward ? 1 : -1;
+
+    auto index = src_index;
+    for (auto hop = 0; hop < hops_count; hop++) {
+      auto npu = src + (index - src_index) * stride;
+      route.emplace_back(offset + npu * links + (forward ? 0 : 1));
+      index = (index + step + topology_size) % topology_size;
     }
+  } else if (topology == TopologyList::FullyConnected) {
+    route.emplace_back(offset + src * links + dest_index);
+  } else if (topology == TopologyList::Switch) {
+    auto dest = src + (dest_index - src_index) * stride;
+    route.emplace_back(offset + src * links); // uplink
+    route.emplace_back(offset + dest * links + 1); // downlink
   }
+  return route;
+}
 
-  auto hbm_latency = hbmLatency(dim, payload_size);
-
-  return std::make_pair(
-      criticalLatency(communication_latency, hbm_latency), dim);
+HierarchicalTopology::Latency HierarchicalTopology::reserveRoute(
+    const std::vector<int>& route,
+    Latency send_time,
+    Latency occupancy) noexcept {
+  auto start_time = send_time;
+  for (auto link : route) {
+    start_time = std::max(start_time, link_free_times[link]);
+  }
+  for (auto link : route) {
+    link_free_times[link] = start_time + occupancy;
+  }
+  return start_time - send_time;
 }
 
 HierarchicalTopology::NpuAddress HierarchicalTopology::npuIdToAddress(
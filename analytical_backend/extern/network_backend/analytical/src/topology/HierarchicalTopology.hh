@@ -6,6 +6,9 @@ LICENSE file in the root directory of this source tree.
 #ifndef __HIERARCHICALTOPOLOGY_HH__
 #define __HIERARCHICALTOPOLOGY_HH__
 
+#include <memory>
+#include <vector>
+#include "FaultyLinks.hh"
 #include "HierarchicalTopologyConfig.hh"
 #include "Topology.hh"
 #include "TopologyConfig.hh"
@@ -34,14 +37,69 @@ class HierarchicalTopology : public Topology {
       int stream_count_ID,
       int link_failure_scheduling_flag,
       int chunk_stage,
-      int failure_type) noexcept override; // baseline: 0, mate: 1, mate_enhanced: 2
-      
+      int failure_type,
+      Latency send_time) noexcept override; // baseline: 0, mate: 1, mate_enhanced: 2
+
+  /**
+   * Model bandwidth contention: every directed link keeps the time it is
+   * free again, and a message waits until all links of its route are free,
+   * then occupies them for its serialization latency.
+   * send() then needs the send times in non-decreasing order.
+   */
+  void enableLinkContention() noexcept;
+
+  /**
+   * Use explicitly placed link failures: a ring with a failed link runs as
+   * a line around it, at half bandwidth.
+   * Dimensions without any faulty link keep their link-failure setting.
+   */
+  void setFaultyLinks(std::shared_ptr<const FaultyLinks> faulty_links) noexcept;
+
+  std::vector<int> getRouteDimensions(NpuId src, NpuId dest) const
+      noexcept override;
+
  private:
   HierarchicalTopologyConfig hierarchy_config;
   std::vector<int> link_failure_vector; // record the link failure num per dim
 
+  std::shared_ptr<const FaultyLinks> faulty_links;
+
+  bool link_contention = false;
+  std::vector<Latency> link_free_times; // per directed link (ns)
+  std::vector<int> link_offsets; // index of the first link of each dim
+  std::vector<int> links_per_npu; // directed links per NPU of each dim
+  std::vector<int> npu_strides; // NPU id distance of neighbors in each dim
+
   Latency linkLatency(int dimension, int hops_count) const noexcept;
 
+  /**
+   * @return position of the failed link in the ring of npu_id along
+   * dimension (see FaultyLinks::get_failed_position), -1 if none
+   */
+  int getFailedPosition(int dimension, NpuId npu_id) const noexcept;
+
+  /**
+   * Directed links a message crosses on one dimension.
+   * @param failed_position ring route that does not use the link between
+   *                        the NPUs at this position and the next (-1: any)
+   * @return indices into link_free_times
+   */
+  std::vector<int> getRoute(
+      int dimension,
+      NpuId src,
+      const NpuAddress& src_address,
+      const NpuAddress& dest_address,
+      int failed_position) const noexcept;
+
+  /**
+   * Reserve the route for occupancy ns from the time all its links are free.
+   * @return time the message waits for its route (ns)
+   */
+  Latency reserveRoute(
+      const std::vector<int>& route,
+      Latency send_time,
+      Latency occupancy) noexcept;
+
   NpuAddress npuIdToAddress(NpuId npu_id) const noexcept override;
   NpuId npuAddressToId(NpuAddress npu_address) const noexcept override;
 };
@@ -0,0 +1,130 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "SymmetryReduction.hh"
+#include <cassert>
+#include <cstddef>
+
+using namespace Analytical;
+
+SymmetryReduction::SymmetryReduction(
+    std::vector<int> units_counts,
+    std::vector<int> strides) noexcept
+    : units_counts(std::move(units_counts)),
+      strides(std::move(strides)),
+      npus_count(1) {
+  assert(
+      this->units_counts.size() == this->strides.size() &&
+      "<SymmetryReduction::SymmetryReduction> one stride per dimension");
+
+  for (size_t dim = 0; dim < this->units_counts.size(); dim++) {
+    assert(
+        this->strides[dim] > 0 &&
+        this->units_counts[dim] % this->strides[dim] == 0 &&
+        "<SymmetryReduction::SymmetryReduction> stride must divide the dimension");
+    npus_count *= this->units_counts[dim];
+  }
+}
+
+std::vector<int> SymmetryReduction::strides_for_period(
+    const std::vector<int>& units_counts,
+    int period) noexcept {
+  // translating by s along dim changes the id by s * (NPUs below dim), or by
+  // (s - units_count) * (NPUs below dim) when it wraps around
+  auto strides = std::vector<int>();
+  auto npus_below = 1;
+  for (auto units_count : units_counts) {
+    auto stride = units_count;
+    for (auto s = 1; s < units_count; s++) {
+      if (units_count % s == 0 && ((long long)s * npus_below) % period == 0) {
+        stride = s;
+        break;
+      }
+    }
+    strides.emplace_back(stride);
+    npus_below *= units_count;
+  }
+  return strides;
+}
+
+std::vector<SymmetryReduction::NpuId> SymmetryReduction::get_representatives()
+    const noexcept {
+  auto representatives = std::vector<NpuId>();
+  for (auto npu_id = 0; npu_id < npus_count; npu_id++) {
+    if (is_representative(npu_id)) {
+      representatives.emplace_back(npu_id);
+    }
+  }
+  return representatives;
+}
+
+int SymmetryReduction::get_orbit_size() const noexcept {
+  auto orbit_size = 1;
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    orbit_size *= units_counts[dim] / strides[dim];
+  }
+  return orbit_size;
+}
+
+bool SymmetryReduction::is_representative(NpuId npu_id) const noexcept {
+  auto address = npu_id_to_address(npu_id);
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    if (address[dim] >= strides[dim]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SymmetryReduction::NpuId SymmetryReduction::get_representative(
+    NpuId npu_id) const noexcept {
+  auto address = npu_id_to_address(npu_id);
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    address[dim] %= strides[dim];
+  }
+  return npu_address_to_id(address);
+}
+
+std::pair<SymmetryReduction::NpuId, SymmetryReduction::NpuId>
+SymmetryReduction::mirror(NpuId src, NpuId dest) const noexcept {
+  auto src_address = npu_id_to_address(src);
+  auto dest_address = npu_id_to_address(dest);
+
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    auto units_count = units_counts[dim];
+
+    // translation (a multiple of the stride) taking dest to its
+    // representative
+    auto representative = dest_address[dim] % strides[dim];
+    auto shift = representative - dest_address[dim];
+
+    src_address[dim] = (src_address[dim] + shift + units_count) % units_count;
+    dest_address[dim] = representative;
+  }
+
+  return std::make_pair(
+      npu_address_to_id(src_address), npu_address_to_id(dest_address));
+}
+
+SymmetryReduction::NpuAddress SymmetryReduction::npu_id_to_address(
+    NpuId npu_id) const noexcept {
+  auto address = NpuAddress();
+  for (auto units_count : units_counts) {
+    address.emplace_back(npu_id % units_count);
+    npu_id /= units_count;
+  }
+  return address;
+}
+
+SymmetryReduction::NpuId SymmetryReduction::npu_address_to_id(
+    const NpuAddress& address) const noexcept {
+  auto npu_id = 0;
+  auto npus_below = 1;
+  for (size_t dim = 0; dim < units_counts.size(); dim++) {
+    npu_id += address[dim] * npus_below;
+    npus_below *= units_counts[dim];
+  }
+  return npu_id;
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SYMMETRYREDUCTION_HH__
+#define __SYMMETRYREDUCTION_HH__
+
+#include <utility>
+#include <vector>
+#include "TopologyConfig.hh"
+
+namespace Analytical {
+/**
+ * Translation symmetry of a hierarchical (torus-like) topology.
+ *
+ * The symmetry group is made of the translations by multiples of
+ * strides[dim] along each dimension. NPUs are split into orbits under these
+ * translations, and only one representative per orbit (the NPU whose
+ * address is below the stride in every dimension) is simulated.
+ *
+ * When the representative q sends a message to dest, every translated copy
+ * h(q) sends to h(dest) at the same time. The copy that arrives at a
+ * representative is the one translated by (representative(dest) - dest),
+ * which mirror() returns.
+ */
+class SymmetryReduction {
+ public:
+  using NpuId = TopologyConfig::NpuId;
+  using NpuAddress = TopologyConfig::NpuAddress;
+
+  /**
+   * @param units_counts NPUs count of each dimension
+   * @param strides translation stride of each dimension (divides the NPUs
+   * count of that dimension; 1 means the dimension is fully symmetric)
+   */
+  SymmetryReduction(
+      std::vector<int> units_counts,
+      std::vector<int> strides) noexcept;
+
+  /**
+   * Strides that keep (npu_id % period) invariant, i.e., the largest
+   * symmetry group of a configuration where NPUs behave by class
+   * (npu_id % period).
+   * @param units_counts NPUs count of each dimension
+   * @param period class period (1: every NPU behaves the same)
+   * @return stride of each dimension
+   */
+  static std::vector<int> strides_for_period(
+      const std::vector<int>& units_counts,
+      int period) noexcept;
+
+  /**
+   * @return ids of the orbit representatives, ascending
+   */
+  std::vector<NpuId> get_representatives() const noexcept;
+
+  /**
+   * @return number of NPUs in each orbit
+   */
+  int get_orbit_size() const noexcept;
+
+  bool is_representative(NpuId npu_id) const noexcept;
+
+  /**
+   * @return representative of the orbit of npu_id
+   */
+  NpuId get_representative(NpuId npu_id) const noexcept;
+
+  /**
+   * Mirror a message sent by a representative onto the representative that
+   * receives its translated copy.
+   * @param src sending representative
+   * @param dest destination of the message
+   * @return (translated source, receiving representative)
+   */
+  std::pair<NpuId, NpuId> mirror(NpuId src, NpuId dest) const noexcept;
+
+ private:
+  NpuAddress npu_id_to_address(NpuId npu_id) const noexcept;
+  NpuId npu_address_to_id(const NpuAddress& address) const noexcept;
+
+  std::vector<int> units_counts;
+  std::vector<int> strides;
+  int npus_count;
+};
+} // namespace Analytical
+
+#endif
@@ -62,6 +62,15 @@ Topology::Bandwidth Topology::getNpuTotalBandwidthPerDim(
   return configs[dimension].getLinkBandwidth();
 }
 
+std::vector<int> Topology::getRouteDimensions(NpuId src, NpuId dest) const
+    noexcept {
+  // Baseline implementation: assume 1d topology
+  if (src == dest) {
+    return std::vector<int>();
+  }
+  return std::vector<int>(1, 0);
+}
+
 Topology::Latency Topology::hbmLatency(int dimension, PayloadSize payload_size)
     const noexcept {
   auto hbm_latency = configs[dimension].getHbmLatency(); // HBM baseline latency
@@ -35,10 +35,18 @@ class Topology {
       int stream_count_ID,
       int link_failure_scheduling_flag,
       int chunk_stage,
-      int failure_type) noexcept = 0; // currently we only change send function
+      int failure_type,
+      Latency send_time) noexcept = 0; // currently we only change send function
 
   virtual Bandwidth getNpuTotalBandwidthPerDim(int dimension) const noexcept;
 
+  /**
+   * Dimensions a message from src to dest traverses, in route order.
+   * @return traversed dimensions (empty if src == dest)
+   */
+  virtual std::vector<int> getRouteDimensions(NpuId src, NpuId dest) const
+      noexcept;
+
  protected:
   TopologyConfigs& configs; // TopologyConfigs for each dimension
   int npus_count; // NPUs count of the topology
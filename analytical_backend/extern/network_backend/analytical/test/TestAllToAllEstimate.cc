@@ -0,0 +1,45 @@
+#include <memory>
+#include <string>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+// 1MB All-to-All on the 4x4x4 TPUv4 torus with a link failure
+SimulationResult run_all_to_all(const std::string& system, EstimateMode mode) {
+  auto inputs = std::string(ANALYTICAL_TEST_INPUTS);
+  auto network_config = std::make_shared<NetworkConfig>(NetworkConfig::parse(
+      inputs + "/network/analytical/Google_comp/TPUv4_4x4x4_SingleFault.json"));
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration = inputs + "/system/" + system;
+  simulation_config.workload_configuration =
+      inputs + "/workload/AllToAll_Synthetic_1MB.txt";
+  simulation_config.path = ::testing::TempDir();
+  simulation_config.write_backend_csv = false;
+  simulation_config.estimate_mode = mode;
+  return Simulation(network_config, simulation_config).run();
+}
+} // namespace
+
+TEST(AllToAllEstimateTest, Validate) {
+  auto result = run_all_to_all("Google_comp/MATE.txt", EstimateMode::Validate);
+  ASSERT_TRUE(result.finished);
+  EXPECT_TRUE(result.estimate_error.empty());
+  EXPECT_TRUE(result.estimate_within_tolerance);
+  EXPECT_LE(result.estimate_max_error, Simulation::estimate_tolerance);
+}
+
+TEST(AllToAllEstimateTest, UnsupportedConfigurationIsReported) {
+  // pipelined ring All-to-All: the run returns the reason instead of exiting
+  auto system = "Synthetic_exp/Ring_No_Fault_Pipeline/3D.txt";
+  auto only = run_all_to_all(system, EstimateMode::Only);
+  EXPECT_FALSE(only.finished);
+  EXPECT_FALSE(only.estimate_error.empty());
+
+  auto validate = run_all_to_all(system, EstimateMode::Validate);
+  EXPECT_TRUE(validate.finished);
+  EXPECT_FALSE(validate.estimate_error.empty());
+  EXPECT_FALSE(validate.estimate_within_tolerance);
+}
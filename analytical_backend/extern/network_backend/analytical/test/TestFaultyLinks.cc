@@ -0,0 +1,163 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "../src/topology/FaultyLinks.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+using TopologyList = HierarchicalTopologyConfig::TopologyList;
+using DimensionType = HierarchicalTopologyConfig::DimensionType;
+
+// 4x4x4 torus: NPU id = x + 4y + 16z
+FaultyLinks torus_faulty_links(const std::vector<std::vector<int>>& links) {
+  return FaultyLinks(
+      {4, 4, 4},
+      std::vector<TopologyList>(3, TopologyList::Ring),
+      links);
+}
+
+// 8x4x4 torus (NPU id = x + 8y + 32z) with the given failed links
+std::shared_ptr<NetworkConfig> torus_8x4x4(
+    const std::vector<std::vector<int>>& faulty_links) {
+  auto config = std::make_shared<NetworkConfig>();
+  config->topology_name = "Hierarchical";
+  config->dimensions_count = 3;
+  config->units_counts = {8, 4, 4};
+  config->link_latencies = {100, 100, 100};
+  config->link_bandwidths = {56, 56, 56};
+  config->nic_latencies = {0, 0, 0};
+  config->router_latencies = {0, 0, 0};
+  config->hbm_latencies = {500, 500, 500};
+  config->hbm_bandwidths = {1200, 1200, 1200};
+  config->link_failures = {0, 0, 0};
+  config->hbm_scales = {0, 0, 0};
+  config->faulty_links = faulty_links;
+  config->topologies_per_dim =
+      std::vector<TopologyList>(3, TopologyList::Ring);
+  config->dimension_types = std::vector<DimensionType>(3, DimensionType::N);
+  config->links_count_per_dim = {2, 2, 2};
+  return config;
+}
+
+// 1MB All-to-All on an 8x4x4 torus with the given failed links
+SimulationResult run_all_to_all(
+    const std::vector<std::vector<int>>& faulty_links,
+    const std::string& system) {
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration =
+      std::string(ANALYTICAL_TEST_INPUTS) + "/system/Google_comp/" + system;
+  simulation_config.workload_configuration =
+      std::string(ANALYTICAL_TEST_INPUTS) +
+      "/workload/AllToAll_Synthetic_1MB.txt";
+  simulation_config.path = ::testing::TempDir();
+  simulation_config.write_backend_csv = false;
+  return Simulation(torus_8x4x4(faulty_links), simulation_config).run();
+}
+} // namespace
+
+TEST(FaultyLinksTest, FailedPositionPerRing) {
+  // x ring of y = 1, z = 2 (NPUs 36..39), link between x = 2 and x = 3
+  auto faulty_links = torus_faulty_links({{38, 39}});
+  EXPECT_EQ(faulty_links.get_failures_count(), 1);
+  EXPECT_EQ(faulty_links.get_failed_position(0, 36), 2);
+  EXPECT_EQ(faulty_links.get_failed_position(0, 39), 2);
+  // neighbouring x ring and the y ring through NPU 38 are intact
+  EXPECT_EQ(faulty_links.get_failed_position(0, 40), -1);
+  EXPECT_EQ(faulty_links.get_failed_position(1, 38), -1);
+  EXPECT_EQ(
+      faulty_links.get_failures_per_dimension(37), std::vector<int>({1, 0, 0}));
+  EXPECT_EQ(
+      faulty_links.get_failures_per_dimension(41), std::vector<int>({0, 0, 0}));
+  EXPECT_TRUE(faulty_links.has_failures(0));
+  EXPECT_FALSE(faulty_links.has_failures(1));
+}
+
+TEST(FaultyLinksTest, WraparoundLink) {
+  // z ring of NPU 5, link between z = 3 and z = 0
+  auto faulty_links = torus_faulty_links({{5, 53}});
+  EXPECT_EQ(faulty_links.get_failed_position(2, 21), 3);
+}
+
+TEST(FaultyLinksTest, SeveralRingsOfOneDimension) {
+  auto faulty_links = torus_faulty_links({{0, 1}, {6, 7}, {0, 4}});
+  EXPECT_EQ(faulty_links.get_failures_count(), 3);
+  EXPECT_EQ(faulty_links.get_failed_position(0, 0), 0);
+  EXPECT_EQ(faulty_links.get_failed_position(0, 4), 2);
+  EXPECT_EQ(faulty_links.get_failed_position(0, 8), -1);
+  EXPECT_EQ(
+      faulty_links.get_failures_per_dimension(0), std::vector<int>({1, 1, 0}));
+}
+
+TEST(FaultyLinksTest, BothDirectionsAreOneFailure) {
+  auto faulty_links = torus_faulty_links({{2, 3}, {3, 2}});
+  EXPECT_EQ(faulty_links.get_failures_count(), 1);
+}
+
+TEST(FaultyLinksTest, TranslationInvariance) {
+  // x rings of even y fail between x = 2 and x = 3
+  auto faulty_links = torus_faulty_links(
+      {{2, 3}, {10, 11}, {18, 19}, {26, 27}, {34, 35}, {42, 43}, {50, 51},
+       {58, 59}});
+  EXPECT_FALSE(faulty_links.is_translation_invariant(0, 1));
+  EXPECT_FALSE(faulty_links.is_translation_invariant(0, 2));
+  EXPECT_TRUE(faulty_links.is_translation_invariant(0, 4));
+  EXPECT_FALSE(faulty_links.is_translation_invariant(1, 1));
+  EXPECT_TRUE(faulty_links.is_translation_invariant(1, 2));
+  EXPECT_TRUE(faulty_links.is_translation_invariant(2, 1));
+}
+
+TEST(FaultyLinksDeathTest, RejectsInvalidLinks) {
+  auto rejected = ::testing::ExitedWithCode(255);
+  EXPECT_EXIT(torus_faulty_links({{0, 1, 2}}), rejected, "");
+  EXPECT_EXIT(torus_faulty_links({{0, 64}}), rejected, "");
+  EXPECT_EXIT(torus_faulty_links({{3, 3}}), rejected, "");
+  // ends differ in two dimensions
+  EXPECT_EXIT(torus_faulty_links({{0, 5}}), rejected, "");
+  // same ring, not neighbours
+  EXPECT_EXIT(torus_faulty_links({{0, 2}}), rejected, "");
+  // second failed link of the x ring of NPU 0
+  EXPECT_EXIT(torus_faulty_links({{0, 1}, {2, 3}}), rejected, "");
+  EXPECT_EXIT(
+      FaultyLinks(
+          {4, 4},
+          {TopologyList::Ring, TopologyList::Switch},
+          {{0, 4}}),
+      rejected,
+      "");
+  EXPECT_EXIT(
+      FaultyLinks({2, 4}, {TopologyList::Ring, TopologyList::Ring}, {{0, 1}}),
+      rejected,
+      "");
+}
+
+TEST(FaultyLinksSimulationTest, PlacementChangesResult) {
+  // MATE sizes its phases by the failed ring: an 8-node ring is slower
+  auto mate_x = run_all_to_all({{0, 1}}, "MATE.txt");
+  auto mate_y = run_all_to_all({{0, 8}}, "MATE.txt");
+  ASSERT_TRUE(mate_x.finished);
+  ASSERT_TRUE(mate_y.finished);
+  EXPECT_GT(mate_x.workload_finished_time, mate_y.workload_finished_time);
+
+  // FoldedRing on the failed ring bounds the collective (baseline)
+  auto baseline_x = run_all_to_all({{0, 1}}, "No_Fault.txt");
+  auto baseline_y = run_all_to_all({{0, 8}}, "No_Fault.txt");
+  EXPECT_NE(
+      baseline_x.workload_finished_time, baseline_y.workload_finished_time);
+
+  // ... but not which ring of the dimension failed
+  auto baseline_y_other_ring = run_all_to_all({{1, 9}}, "No_Fault.txt");
+  EXPECT_EQ(
+      baseline_y.workload_finished_time,
+      baseline_y_other_ring.workload_finished_time);
+}
+
+TEST(FaultyLinksSimulationDeathTest, MateRejectsMixedRingSizes) {
+  EXPECT_EXIT(
+      run_all_to_all({{0, 1}, {0, 8}}, "MATE.txt"),
+      ::testing::ExitedWithCode(255),
+      "");
+}
@@ -0,0 +1,93 @@
+#include <memory>
+#include <vector>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/topology/HierarchicalTopology.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+using TopologyList = HierarchicalTopologyConfig::TopologyList;
+using DimensionType = HierarchicalTopologyConfig::DimensionType;
+
+// 4x4 torus (NPU id = x + 4y)
+class LinkContentionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config.topology_name = "Hierarchical";
+    config.dimensions_count = 2;
+    config.units_counts = {4, 4};
+    config.link_latencies = {100, 100};
+    config.link_bandwidths = {50, 50};
+    config.nic_latencies = {0, 0};
+    config.router_latencies = {0, 0};
+    config.hbm_latencies = {0, 0};
+    config.hbm_bandwidths = {100000, 100000};
+    config.link_failures = {0, 0};
+    config.hbm_scales = {0, 0};
+    config.topologies_per_dim = {TopologyList::Ring, TopologyList::Ring};
+    config.dimension_types = {DimensionType::N, DimensionType::N};
+    config.links_count_per_dim = {2, 2};
+  }
+
+  std::unique_ptr<HierarchicalTopology> make_topology(bool link_contention) {
+    // the topology scales the bandwidths of its configs in place
+    topology_configs.push_back(
+        std::make_unique<Topology::TopologyConfigs>(
+            config.get_topology_configs()));
+    auto topology = std::make_unique<HierarchicalTopology>(
+        *topology_configs.back(), config.get_hierarchy_config());
+    if (link_contention) {
+      topology->enableLinkContention();
+    }
+    return topology;
+  }
+
+  // latency of a 1MB message (first chunk of its stream)
+  static double send(
+      HierarchicalTopology& topology,
+      int src,
+      int dest,
+      double send_time) {
+    return topology.send(src, dest, 1 << 20, 0, 0, 0, 0, 0, send_time).first;
+  }
+
+  NetworkConfig config;
+  // kept alive for the topologies: Topology holds a reference to them
+  std::vector<std::unique_ptr<Topology::TopologyConfigs>> topology_configs;
+};
+} // namespace
+
+TEST_F(LinkContentionTest, DisabledByDefault) {
+  auto topology = make_topology(false);
+  auto latency = send(*topology, 0, 1, 0);
+  EXPECT_EQ(send(*topology, 0, 1, 0), latency);
+  EXPECT_EQ(send(*topology, 0, 2, 0), send(*make_topology(false), 0, 2, 0));
+}
+
+TEST_F(LinkContentionTest, SharedLinkSerializesMessages) {
+  auto topology = make_topology(true);
+  auto first = send(*topology, 0, 1, 0);
+  EXPECT_EQ(first, send(*make_topology(false), 0, 1, 0));
+
+  // the second message over link 0 -> 1 waits for the first one's
+  // serialization, a two-hop message over it for both
+  auto occupancy = send(*topology, 0, 1, 0) - first;
+  EXPECT_GT(occupancy, 0);
+  auto two_hops = send(*make_topology(false), 0, 2, 0);
+  // (send() adds up latencies in whole ns)
+  EXPECT_NEAR(send(*topology, 0, 2, 0), two_hops + 2 * occupancy, 1);
+  // ...and the link after it (1 -> 2) is now busy as well
+  EXPECT_NEAR(send(*topology, 1, 2, 0), first + 3 * occupancy, 1);
+}
+
+TEST_F(LinkContentionTest, OtherLinksAreIndependent) {
+  auto topology = make_topology(true);
+  auto first = send(*topology, 0, 1, 0);
+  // opposite direction, another x ring, and the y ring of NPU 0
+  EXPECT_EQ(send(*topology, 1, 0, 0), first);
+  EXPECT_EQ(send(*topology, 4, 5, 0), first);
+  EXPECT_EQ(send(*topology, 0, 4, 0), first);
+  // once link 0 -> 1 is free again, nothing waits
+  EXPECT_EQ(send(*topology, 0, 1, first), first);
+}
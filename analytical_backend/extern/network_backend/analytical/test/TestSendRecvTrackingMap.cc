@@ -0,0 +1,216 @@
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <random>
+#include <tuple>
+#include "../src/api/SendRecvTrackingMap.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+// (tag, src, dest, count)
+using Key = std::tuple<int, int, int, uint64_t>;
+
+AstraSim::timespec_t at(double time) {
+  return {AstraSim::NS, time};
+}
+
+void recv_handler(void*) {}
+
+void* recv_arg(uint64_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Reference model: per-key FIFO of ids, positive for sends, negative for
+// recvs (a key only ever queues one operation type).
+class TrackingMapChecker {
+ public:
+  void send(const Key& key) {
+    auto id = ++last_id;
+    auto& queue = pending[key];
+    auto event = Event(nullptr, nullptr);
+    if (!queue.empty() && queue.front() < 0) {
+      ASSERT_TRUE(map.try_match_recv(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          event));
+      EXPECT_EQ(event.get_fun_arg(), recv_arg(-queue.front()));
+      queue.pop_front();
+    } else {
+      ASSERT_FALSE(map.try_match_recv(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          event));
+      map.insert_send(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          at(id));
+      queue.push_back(id);
+    }
+    erase_if_empty(key);
+  }
+
+  void recv(const Key& key) {
+    auto id = ++last_id;
+    auto& queue = pending[key];
+    auto send_finish_time = at(0);
+    if (!queue.empty() && queue.front() > 0) {
+      ASSERT_TRUE(map.try_match_send(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          send_finish_time));
+      EXPECT_EQ(send_finish_time.time_val, queue.front());
+      queue.pop_front();
+    } else {
+      ASSERT_FALSE(map.try_match_send(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          send_finish_time));
+      map.insert_recv(
+          std::get<0>(key),
+          std::get<1>(key),
+          std::get<2>(key),
+          std::get<3>(key),
+          recv_handler,
+          recv_arg(id));
+      queue.push_back(-id);
+    }
+    erase_if_empty(key);
+  }
+
+  size_t pending_keys_count() const {
+    return pending.size();
+  }
+
+  const std::map<Key, std::deque<int64_t>>& get_pending() const {
+    return pending;
+  }
+
+ private:
+  void erase_if_empty(const Key& key) {
+    if (pending[key].empty()) {
+      pending.erase(key);
+    }
+  }
+
+  SendRecvTrackingMap map;
+  std::map<Key, std::deque<int64_t>> pending;
+  int64_t last_id = 0;
+};
+} // namespace
+
+TEST(SendRecvTrackingMapTest, MatchesInFifoOrder) {
+  auto map = SendRecvTrackingMap();
+  map.insert_send(7, 1, 2, 1024, at(10));
+  map.insert_send(7, 1, 2, 1024, at(20));
+
+  auto send_finish_time = at(0);
+  auto event = Event(nullptr, nullptr);
+  EXPECT_FALSE(map.try_match_send(7, 2, 1, 1024, send_finish_time));
+  EXPECT_FALSE(map.try_match_send(7, 1, 2, 2048, send_finish_time));
+  EXPECT_FALSE(map.try_match_send(8, 1, 2, 1024, send_finish_time));
+  EXPECT_FALSE(map.try_match_recv(7, 1, 2, 1024, event));
+
+  ASSERT_TRUE(map.try_match_send(7, 1, 2, 1024, send_finish_time));
+  EXPECT_EQ(send_finish_time.time_val, 10);
+  ASSERT_TRUE(map.try_match_send(7, 1, 2, 1024, send_finish_time));
+  EXPECT_EQ(send_finish_time.time_val, 20);
+  EXPECT_FALSE(map.try_match_send(7, 1, 2, 1024, send_finish_time));
+
+  // the drained key accepts the opposite operation type
+  map.insert_recv(7, 1, 2, 1024, recv_handler, recv_arg(3));
+  ASSERT_TRUE(map.try_match_recv(7, 1, 2, 1024, event));
+  EXPECT_EQ(event.get_fun_arg(), recv_arg(3));
+}
+
+TEST(SendRecvTrackingMapTest, EraseAndReinsertAcrossWraparound) {
+  // Keep ~480 keys live in the initial 1024 slots (just under the 0.5 load
+  // factor that triggers a grow), so probe runs are long and regularly wrap
+  // past the last slot. Random erase (match) and reinsert then exercises
+  // backward-shift deletion over the wraparound.
+  auto checker = TrackingMapChecker();
+  auto generator = std::mt19937(2023);
+  auto key_distribution = std::uniform_int_distribution<int>(0, 4095);
+  auto make_key = [&]() {
+    auto value = key_distribution(generator);
+    return Key(value % 4, (value / 4) % 32, value / 128, 1024);
+  };
+
+  for (auto i = 0; i < 200000; i++) {
+    auto key = make_key();
+    auto live = checker.pending_keys_count();
+    // at the target load, drain a live key instead of adding one
+    auto operation_is_send = (generator() % 2) == 0;
+    if (live >= 480) {
+      // pick a live key and drain one operation from it
+      auto it = checker.get_pending().begin();
+      std::advance(it, generator() % live);
+      key = it->first;
+      operation_is_send = it->second.front() < 0;
+    }
+    if (operation_is_send) {
+      checker.send(key);
+    } else {
+      checker.recv(key);
+    }
+    if (::testing::Test::HasFatalFailure()) {
+      return;
+    }
+  }
+
+  // drain everything left, in key order
+  while (checker.pending_keys_count() > 0) {
+    auto key = checker.get_pending().begin()->first;
+    if (checker.get_pending().begin()->second.front() < 0) {
+      checker.send(key);
+    } else {
+      checker.recv(key);
+    }
+    if (::testing::Test::HasFatalFailure()) {
+      return;
+    }
+  }
+}
+
+TEST(SendRecvTrackingMapTest, SurvivesGrow) {
+  auto checker = TrackingMapChecker();
+  // 4096 distinct keys forces several grows with operations still pending
+  for (auto dest = 0; dest < 64; dest++) {
+    for (auto src = 0; src < 64; src++) {
+      checker.send(Key(0, src, dest, 64));
+      checker.send(Key(0, src, dest, 64));
+    }
+  }
+  EXPECT_EQ(checker.pending_keys_count(), 4096);
+  for (auto src = 63; src >= 0; src--) {
+    for (auto dest = 0; dest < 64; dest++) {
+      checker.recv(Key(0, src, dest, 64));
+      checker.recv(Key(0, src, dest, 64));
+    }
+  }
+  EXPECT_EQ(checker.pending_keys_count(), 0);
+}
+
+TEST(SendRecvTrackingMapDeathTest, RejectsNpuIdBeyond16Bits) {
+  auto map = SendRecvTrackingMap();
+  EXPECT_EXIT(
+      map.insert_send(0, 0x10000, 0, 1024, at(0)),
+      ::testing::ExitedWithCode(255),
+      "");
+  EXPECT_EXIT(
+      map.insert_recv(0, 0, -1, 1024, recv_handler, recv_arg(1)),
+      ::testing::ExitedWithCode(255),
+      "");
+}
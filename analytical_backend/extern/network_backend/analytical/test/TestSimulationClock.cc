@@ -0,0 +1,60 @@
+#include <memory>
+#include <string>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "astra-sim/system/SimulationClock.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+// 1MB All-to-All on the 4x4x4 TPUv4 torus with a link failure
+SimulationResult run_all_to_all(
+    const std::string& system,
+    EventQueue::EngineType engine_type,
+    bool clock_check) {
+  auto inputs = std::string(ANALYTICAL_TEST_INPUTS);
+  auto network_config = std::make_shared<NetworkConfig>(NetworkConfig::parse(
+      inputs + "/network/analytical/Google_comp/TPUv4_4x4x4_SingleFault.json"));
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration = inputs + "/system/" + system;
+  simulation_config.workload_configuration =
+      inputs + "/workload/AllToAll_Synthetic_1MB.txt";
+  simulation_config.path = ::testing::TempDir();
+  simulation_config.write_backend_csv = false;
+  simulation_config.event_queue_engine_type = engine_type;
+  simulation_config.clock_check = clock_check;
+  return Simulation(network_config, simulation_config).run();
+}
+} // namespace
+
+TEST(SimulationClockTest, DrivenBySetTime) {
+  auto clock = AstraSim::SimulationClock();
+  EXPECT_FALSE(clock.is_driven());
+  EXPECT_FALSE(clock.is_checked());
+  EXPECT_EQ(clock.get_tick(), 0);
+
+  clock.set_time({AstraSim::NS, 1500});
+  EXPECT_TRUE(clock.is_driven());
+  EXPECT_EQ(clock.get_tick(), 1500 / CLOCK_PERIOD);
+  clock.set_time({AstraSim::NS, 2750});
+  EXPECT_EQ(clock.get_tick(), 2750 / CLOCK_PERIOD);
+}
+
+TEST(SimulationClockTest, MatchesEventQueueTime) {
+  // a checked clock aborts the run if it ever differs from the event queue
+  // time, for both event queue engines; reading it instead of the backend
+  // does not change the result
+  for (auto engine_type :
+       {EventQueue::EngineType::Heap, EventQueue::EngineType::List}) {
+    for (auto system : {"Google_comp/MATE.txt", "Google_comp/Fault_2_1.txt"}) {
+      SCOPED_TRACE(system);
+      auto checked = run_all_to_all(system, engine_type, true);
+      auto driven = run_all_to_all(system, engine_type, false);
+      ASSERT_TRUE(checked.finished);
+      ASSERT_TRUE(driven.finished);
+      EXPECT_EQ(checked.workload_finished_time, driven.workload_finished_time);
+      EXPECT_EQ(checked.max_finished_time, driven.max_finished_time);
+    }
+  }
+}
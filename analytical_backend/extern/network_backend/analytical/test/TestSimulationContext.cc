@@ -0,0 +1,84 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/helper/WorkStealingPool.hh"
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "astra-sim/system/InputFiles.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+const std::vector<std::string> systems = {
+    "No_Fault.txt", "MATE.txt", "MATEe.txt", "Fault_2_1.txt"};
+
+// 1MB All-to-All on the 4x4x4 TPUv4 torus with a link failure, writing its
+// system-layer CSVs into a directory of its own
+SimulationConfig all_to_all_config(const std::string& system, int run) {
+  auto inputs = std::string(ANALYTICAL_TEST_INPUTS);
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration =
+      inputs + "/system/Google_comp/" + system;
+  simulation_config.workload_configuration =
+      inputs + "/workload/AllToAll_Synthetic_1MB.txt";
+  simulation_config.path =
+      ::testing::TempDir() + "context_" + std::to_string(run) + "/";
+  simulation_config.run_name = system;
+  simulation_config.write_backend_csv = false;
+  std::filesystem::create_directories(simulation_config.path);
+  return simulation_config;
+}
+
+std::shared_ptr<const NetworkConfig> tpu_v4_network() {
+  return std::make_shared<NetworkConfig>(NetworkConfig::parse(
+      std::string(ANALYTICAL_TEST_INPUTS) +
+      "/network/analytical/Google_comp/TPUv4_4x4x4_SingleFault.json"));
+}
+
+void expect_same_result(
+    const SimulationResult& result,
+    const SimulationResult& expected) {
+  ASSERT_TRUE(result.finished);
+  EXPECT_EQ(result.workload_finished_time, expected.workload_finished_time);
+  EXPECT_EQ(result.total_cost, expected.total_cost);
+  EXPECT_EQ(result.payload_size_per_dim, expected.payload_size_per_dim);
+  EXPECT_EQ(
+      result.avg_chunk_latency_per_dim, expected.avg_chunk_latency_per_dim);
+  EXPECT_EQ(result.min_finished_time, expected.min_finished_time);
+  EXPECT_EQ(result.max_finished_time, expected.max_finished_time);
+  EXPECT_EQ(result.slowest_npu, expected.slowest_npu);
+  EXPECT_EQ(result.pool_allocations_count, expected.pool_allocations_count);
+}
+} // namespace
+
+TEST(SimulationContextTest, ConcurrentRunsMatchSequentialRuns) {
+  // every run keeps its state in its own SimulationContext/NetworkContext:
+  // runs on parallel threads, sharing the network configuration and the
+  // parsed input files, give the results of runs made one after another
+  auto network_config = tpu_v4_network();
+  auto sequential = std::vector<SimulationResult>();
+  for (size_t i = 0; i < systems.size(); i++) {
+    sequential.push_back(
+        Simulation(network_config, all_to_all_config(systems[i], i)).run());
+    ASSERT_TRUE(sequential.back().finished) << systems[i];
+  }
+
+  auto input_files = std::make_shared<AstraSim::InputFiles>();
+  auto concurrent = std::vector<SimulationResult>(2 * systems.size());
+  auto tasks = std::vector<WorkStealingPool::Task>();
+  for (size_t i = 0; i < concurrent.size(); i++) {
+    auto config = all_to_all_config(
+        systems[i % systems.size()], systems.size() + i);
+    tasks.emplace_back([&, i, config]() {
+      concurrent[i] = Simulation(network_config, config, input_files).run();
+    });
+  }
+  WorkStealingPool(4).run(std::move(tasks));
+
+  for (size_t i = 0; i < concurrent.size(); i++) {
+    SCOPED_TRACE(systems[i % systems.size()]);
+    expect_same_result(concurrent[i], sequential[i % systems.size()]);
+  }
+}
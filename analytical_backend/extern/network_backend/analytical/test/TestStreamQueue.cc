@@ -0,0 +1,73 @@
+#include <fstream>
+#include <memory>
+#include <string>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+// Mixed collectives of different sizes in every layer, so the streams of a
+// dimension queue compete under the intra-dimension scheduling policy.
+const char* workload =
+    "DATA\n"
+    "4\n"
+    "l0 -1 5 ALLREDUCE 1048576 5 REDUCESCATTER 524288 5 ALLGATHER 2097152 5\n"
+    "l1 -1 5 ALLTOALL 524288 5 ALLREDUCE 262144 5 REDUCESCATTER 4194304 5\n"
+    "l2 -1 5 ALLGATHER 1048576 5 ALLTOALL 1048576 5 ALLREDUCE 8388608 5\n"
+    "l3 -1 5 REDUCESCATTER 2097152 5 ALLGATHER 65536 5 ALLTOALL 262144 5\n";
+
+// Workload above on the 2D torus, with 16 chunks per collective.
+double run_workload(
+    const std::string& intra_dimension_scheduling,
+    int active_chunks_per_dimension) {
+  auto name = intra_dimension_scheduling + "_" +
+      std::to_string(active_chunks_per_dimension);
+  auto workload_path = ::testing::TempDir() + "stream_queue_workload.txt";
+  std::ofstream(workload_path) << workload;
+  auto system_path = ::testing::TempDir() + "stream_queue_" + name + ".txt";
+  std::ofstream(system_path)
+      << "scheduling-policy: LIFO\n"
+      << "endpoint-delay: 1\n"
+      << "active-chunks-per-dimension: " << active_chunks_per_dimension
+      << "\n"
+      << "preferred-dataset-splits: 16\n"
+      << "boost-mode: 0\n"
+      << "all-reduce-implementation: ring_ring\n"
+      << "all-gather-implementation: ring_ring\n"
+      << "reduce-scatter-implementation: ring_ring\n"
+      << "all-to-all-implementation: halfring_halfring\n"
+      << "collective-optimization: localBWAware\n"
+      << "intra-dimension-scheduling: " << intra_dimension_scheduling << "\n"
+      << "inter-dimension-scheduling: ND_Torus_Ring_AlltoAll_AllReduce\n"
+      << "link-failure-per-dimension: 0_0\n";
+
+  auto network_config = std::make_shared<NetworkConfig>(NetworkConfig::parse(
+      std::string(ANALYTICAL_TEST_INPUTS) +
+      "/network/analytical/Synthetic_exp/No_Fault_2D.json"));
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration = system_path;
+  simulation_config.workload_configuration = workload_path;
+  simulation_config.path = ::testing::TempDir();
+  simulation_config.run_name = name;
+  simulation_config.write_backend_csv = false;
+  auto result = Simulation(network_config, simulation_config).run();
+  EXPECT_TRUE(result.finished) << name;
+  return result.workload_finished_time;
+}
+} // namespace
+
+TEST(StreamQueueTest, SchedulingPoliciesKeepTheirOrder) {
+  // End-to-end times of the list scan that StreamQueue's ordered index
+  // replaced: FIFO keeps arrival order, SCF and lessRemainingPhaseFirst
+  // insert by key (indexed), RG inserts at arbitrary positions (scan).
+  EXPECT_NEAR(run_workload("FIFO", 1), 814.623, 1e-3);
+  EXPECT_NEAR(run_workload("FIFO", 2), 405.251, 1e-3);
+  EXPECT_NEAR(run_workload("RG", 1), 784.143, 1e-3);
+  EXPECT_NEAR(run_workload("RG", 2), 409.542, 1e-3);
+  EXPECT_NEAR(run_workload("SCF", 1), 789.595, 1e-3);
+  EXPECT_NEAR(run_workload("SCF", 2), 390.757, 1e-3);
+  EXPECT_NEAR(run_workload("lessRemainingPhaseFirst", 1), 780.650, 1e-3);
+  EXPECT_NEAR(run_workload("lessRemainingPhaseFirst", 2), 390.042, 1e-3);
+}
@@ -0,0 +1,100 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/simulation/NetworkConfig.hh"
+#include "../src/simulation/Simulation.hh"
+#include "../src/topology/SymmetryReduction.hh"
+#include "gtest/gtest.h"
+
+using namespace Analytical;
+
+namespace {
+using TopologyList = HierarchicalTopologyConfig::TopologyList;
+using DimensionType = HierarchicalTopologyConfig::DimensionType;
+
+// 4x4x4 torus (NPU id = x + 4y + 16z) with the given failed links
+std::shared_ptr<NetworkConfig> torus_4x4x4(
+    const std::vector<std::vector<int>>& faulty_links) {
+  auto config = std::make_shared<NetworkConfig>();
+  config->topology_name = "Hierarchical";
+  config->dimensions_count = 3;
+  config->units_counts = {4, 4, 4};
+  config->link_latencies = {100, 100, 100};
+  config->link_bandwidths = {56, 56, 56};
+  config->nic_latencies = {0, 0, 0};
+  config->router_latencies = {0, 0, 0};
+  config->hbm_latencies = {500, 500, 500};
+  config->hbm_bandwidths = {1200, 1200, 1200};
+  config->link_failures = {0, 0, 0};
+  config->hbm_scales = {0, 0, 0};
+  config->faulty_links = faulty_links;
+  config->topologies_per_dim =
+      std::vector<TopologyList>(3, TopologyList::Ring);
+  config->dimension_types = std::vector<DimensionType>(3, DimensionType::N);
+  config->links_count_per_dim = {2, 2, 2};
+  return config;
+}
+
+// 1MB All-to-All under MATE
+SimulationResult run_all_to_all(
+    const std::vector<std::vector<int>>& faulty_links,
+    bool symmetry_reduction) {
+  auto simulation_config = SimulationConfig();
+  simulation_config.system_configuration =
+      std::string(ANALYTICAL_TEST_INPUTS) + "/system/Google_comp/MATE.txt";
+  simulation_config.workload_configuration =
+      std::string(ANALYTICAL_TEST_INPUTS) +
+      "/workload/AllToAll_Synthetic_1MB.txt";
+  simulation_config.path = ::testing::TempDir();
+  simulation_config.write_backend_csv = false;
+  simulation_config.symmetry_reduction = symmetry_reduction;
+  return Simulation(torus_4x4x4(faulty_links), simulation_config).run();
+}
+} // namespace
+
+TEST(SymmetryReductionTest, Orbits) {
+  auto symmetry_reduction = SymmetryReduction({4, 4, 4}, {4, 2, 1});
+  EXPECT_EQ(symmetry_reduction.get_orbit_size(), 8);
+  EXPECT_EQ(
+      symmetry_reduction.get_representatives(),
+      std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+  // (1, 3, 2) -> (1, 1, 0)
+  EXPECT_EQ(symmetry_reduction.get_representative(45), 5);
+  EXPECT_TRUE(symmetry_reduction.is_representative(6));
+  EXPECT_FALSE(symmetry_reduction.is_representative(8));
+}
+
+TEST(SymmetryReductionTest, Mirror) {
+  auto symmetry_reduction = SymmetryReduction({4, 4, 4}, {4, 2, 1});
+  // 1 -> (2, 3, 1) arrives at (2, 1, 0) from (1, -2, -1) = (1, 2, 3)
+  auto mirrored = symmetry_reduction.mirror(1, 30);
+  EXPECT_EQ(mirrored.first, 57);
+  EXPECT_EQ(mirrored.second, 6);
+}
+
+TEST(SymmetryReductionTest, StridesForPeriod) {
+  EXPECT_EQ(
+      SymmetryReduction::strides_for_period({4, 4, 4}, 1),
+      std::vector<int>({1, 1, 1}));
+  EXPECT_EQ(
+      SymmetryReduction::strides_for_period({4, 4, 4}, 8),
+      std::vector<int>({4, 2, 1}));
+}
+
+TEST(SymmetryReductionSimulationTest, FaultyLinkOrbitClasses) {
+  // x rings of even y fail between x = 2 and x = 3: 8 orbit classes
+  auto faulty_links = std::vector<std::vector<int>>(
+      {{2, 3}, {10, 11}, {18, 19}, {26, 27}, {34, 35}, {42, 43}, {50, 51},
+       {58, 59}});
+  auto full = run_all_to_all(faulty_links, false);
+  auto reduced = run_all_to_all(faulty_links, true);
+  ASSERT_TRUE(full.finished);
+  ASSERT_TRUE(reduced.finished);
+  EXPECT_EQ(reduced.workload_finished_time, full.workload_finished_time);
+  EXPECT_EQ(reduced.total_payload_size, full.total_payload_size);
+  EXPECT_EQ(reduced.avg_chunk_latency_per_dim, full.avg_chunk_latency_per_dim);
+  EXPECT_EQ(reduced.min_finished_time, full.min_finished_time);
+  EXPECT_EQ(reduced.median_finished_time, full.median_finished_time);
+  EXPECT_EQ(reduced.max_finished_time, full.max_finished_time);
+  EXPECT_EQ(reduced.slowest_npu, full.slowest_npu);
+}
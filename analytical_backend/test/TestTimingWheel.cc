@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+#include "astra-sim/system/TimingWheel.hh"
+#include "gtest/gtest.h"
+
+namespace {
+// events are told apart by their data pointer
+AstraSim::CallData* event_data(uint64_t id) {
+  return reinterpret_cast<AstraSim::CallData*>(static_cast<uintptr_t>(id));
+}
+
+uint64_t event_id(AstraSim::CallData* data) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data));
+}
+
+// Advance the wheel to tick and take all its events, in order.
+std::vector<uint64_t> run_tick(
+    AstraSim::TimingWheel& wheel,
+    AstraSim::Tick tick) {
+  wheel.advance(tick);
+  std::vector<uint64_t> ids;
+  AstraSim::Callable* callable;
+  AstraSim::EventType event;
+  AstraSim::CallData* data;
+  while (wheel.pop(callable, event, data)) {
+    ids.push_back(event_id(data));
+  }
+  return ids;
+}
+} // namespace
+
+TEST(TimingWheelTest, OverflowCascadesIntoLevels) {
+  // 4 levels of 64 slots cover ticks up to 2^24 away; later ones overflow
+  const AstraSim::Tick level_span = 1ULL << 24;
+  auto wheel = AstraSim::TimingWheel();
+  auto insert = [&wheel](AstraSim::Tick tick, uint64_t id) {
+    return wheel.insert(
+        tick, nullptr, AstraSim::EventType::General, event_data(id));
+  };
+
+  EXPECT_TRUE(insert(5, 1));
+  EXPECT_TRUE(insert(level_span + 3, 2));
+  EXPECT_FALSE(insert(level_span + 3, 3));
+  EXPECT_TRUE(insert(3 * level_span + 100, 4));
+  EXPECT_TRUE(insert(1ULL << 40, 5));
+  EXPECT_TRUE(insert(level_span - 1, 6));
+  EXPECT_FALSE(wheel.empty());
+
+  EXPECT_EQ(run_tick(wheel, 5), std::vector<uint64_t>({1}));
+  EXPECT_EQ(run_tick(wheel, level_span - 1), std::vector<uint64_t>({6}));
+  EXPECT_EQ(run_tick(wheel, level_span + 3), std::vector<uint64_t>({2, 3}));
+
+  // an overflowed tick keeps taking events once it is within the levels
+  EXPECT_FALSE(insert(3 * level_span + 100, 7));
+  EXPECT_TRUE(insert(3 * level_span + 99, 8));
+  EXPECT_EQ(run_tick(wheel, 3 * level_span + 99), std::vector<uint64_t>({8}));
+  EXPECT_EQ(
+      run_tick(wheel, 3 * level_span + 100), std::vector<uint64_t>({4, 7}));
+  EXPECT_FALSE(wheel.empty());
+  EXPECT_EQ(run_tick(wheel, 1ULL << 40), std::vector<uint64_t>({5}));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, MatchesOrderedMap) {
+  // random delays across every level and the overflow map, including events
+  // added to the running tick, against an ordered map of FIFOs
+  auto wheel = AstraSim::TimingWheel();
+  std::map<AstraSim::Tick, std::deque<uint64_t>> expected;
+  auto generator = std::mt19937_64(2023);
+  uint64_t last_id = 0;
+  AstraSim::Tick now = 0;
+  auto running = false;
+  auto schedule = [&](AstraSim::Tick tick) {
+    auto id = ++last_id;
+    auto added = wheel.insert(
+        tick, nullptr, AstraSim::EventType::General, event_data(id));
+    auto& queue = expected[tick];
+    // the running tick keeps its bucket until its events are all taken
+    EXPECT_EQ(added, queue.empty() && !(running && tick == now));
+    queue.push_back(id);
+  };
+  auto random_delay = [&generator]() -> AstraSim::Tick {
+    // below 2^32, weighted toward short delays
+    auto bits = generator() % 33;
+    return generator() & ((1ULL << bits) - 1);
+  };
+
+  for (auto i = 0; i < 1000; i++) {
+    schedule(random_delay());
+  }
+  auto ticks_run = 0;
+  while (!expected.empty()) {
+    now = expected.begin()->first;
+    wheel.advance(now);
+    running = true;
+    AstraSim::Callable* callable;
+    AstraSim::EventType event;
+    AstraSim::CallData* data;
+    while (wheel.pop(callable, event, data)) {
+      auto& queue = expected.begin()->second;
+      ASSERT_FALSE(queue.empty());
+      ASSERT_EQ(event_id(data), queue.front());
+      queue.pop_front();
+      // each event schedules up to two more, sometimes at the running tick
+      if (last_id < 20000) {
+        schedule(now + random_delay());
+        if (generator() % 4 == 0) {
+          schedule(now + random_delay());
+        }
+      }
+    }
+    running = false;
+    ASSERT_TRUE(expected.begin()->second.empty());
+    expected.erase(expected.begin());
+    ticks_run++;
+  }
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_GT(ticks_run, 1000);
+}
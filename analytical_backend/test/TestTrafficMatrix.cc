@@ -0,0 +1,140 @@
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "astra-sim/system/InputFiles.hh"
+#include "astra-sim/system/TrafficMatrix.hh"
+#include "gtest/gtest.h"
+
+namespace {
+// (src, dst) -> bytes, for layer 0
+using Entries = std::map<std::pair<int, int>, uint64_t>;
+
+std::shared_ptr<const AstraSim::TrafficMatrix> load_matrix(
+    AstraSim::InputFiles& input_files,
+    const std::string& name,
+    int npus_count,
+    const Entries& entries) {
+  auto path = ::testing::TempDir() + name;
+  std::ofstream file(path);
+  file << "npus: " << npus_count << "\n";
+  file << "layer: 0\n";
+  for (const auto& entry : entries) {
+    file << entry.first.first << " " << entry.first.second << " "
+         << entry.second << "\n";
+  }
+  file.close();
+  return AstraSim::TrafficMatrix::load(input_files, path);
+}
+
+// Bytes of uniform traffic in one of messages_count messages of a stage on
+// rings of 3 NPUs, where every route is a single hop: each NPU sends its
+// 2 peers mean_send_size / 3 bytes each.
+double uniform_message_bytes(uint64_t mean_send_size, int messages_count) {
+  return (double)mean_send_size / 3 * 2 / messages_count;
+}
+
+double sum(const std::vector<double>& values) {
+  auto total = 0.0;
+  for (auto value : values) {
+    total += value;
+  }
+  return total;
+}
+} // namespace
+
+TEST(TrafficMatrixTest, UniformMatrixHasUnitScales) {
+  // like the uniform All-to-All, every NPU also keeps a share for itself
+  auto input_files = AstraSim::InputFiles();
+  Entries entries;
+  for (auto src = 0; src < 8; src++) {
+    for (auto dst = 0; dst < 8; dst++) {
+      entries[{src, dst}] = 700;
+    }
+  }
+  auto matrix = load_matrix(input_files, "uniform_a2av.txt", 8, entries);
+  EXPECT_EQ(matrix->get_npus_count(), 8);
+  EXPECT_EQ(matrix->get_mean_send_size(0), 8 * 700);
+
+  for (auto failed : {false, true}) {
+    const auto& scales =
+        matrix->get_stage_message_scales(0, {8}, {false}, 0, failed, 7);
+    ASSERT_EQ(scales.size(), 8);
+    for (const auto& npu_scales : scales) {
+      ASSERT_EQ(npu_scales.size(), 7);
+      for (auto scale : npu_scales) {
+        EXPECT_NEAR(scale, 1, 1e-9);
+      }
+    }
+  }
+}
+
+TEST(TrafficMatrixTest, FirstStageScalesAddUpToRowSums) {
+  // one ring of 3: an NPU's outgoing links carry exactly what it sends
+  auto input_files = AstraSim::InputFiles();
+  Entries entries = {
+      {{0, 1}, 1000},
+      {{0, 2}, 3000},
+      {{1, 0}, 200},
+      {{2, 0}, 6000},
+      {{2, 1}, 10}};
+  auto matrix = load_matrix(input_files, "rows_a2av.txt", 3, entries);
+  uint64_t total = 0;
+  std::vector<uint64_t> row_sums(3, 0);
+  for (const auto& entry : entries) {
+    row_sums[entry.first.first] += entry.second;
+    total += entry.second;
+  }
+  EXPECT_EQ(matrix->get_mean_send_size(0), total / 3);
+
+  const auto messages_count = 4;
+  const auto& scales = matrix->get_stage_message_scales(
+      0, {3}, {false}, 0, false, messages_count);
+  auto message_bytes =
+      uniform_message_bytes(matrix->get_mean_send_size(0), messages_count);
+  for (auto npu = 0; npu < 3; npu++) {
+    EXPECT_NEAR(sum(scales[npu]) * message_bytes, row_sums[npu], 1e-6)
+        << "NPU " << npu;
+  }
+}
+
+TEST(TrafficMatrixTest, LastStageScalesAddUpToColumnSums) {
+  // 3x3 torus (NPU id = x + 3y), stage on y after x is done: the data of
+  // (src, dst) leaves from (dst.x, src.y), so the ring with x = c carries
+  // the column sums of the destinations with x = c (pairs with the same y
+  // are already delivered)
+  auto input_files = AstraSim::InputFiles();
+  Entries entries;
+  for (auto src = 0; src < 9; src++) {
+    for (auto dst = 0; dst < 9; dst++) {
+      if (src != dst) {
+        entries[{src, dst}] = 100 * (src + 1) + 7 * dst * dst;
+      }
+    }
+  }
+  auto matrix = load_matrix(input_files, "columns_a2av.txt", 9, entries);
+  std::vector<double> ring_column_sums(3, 0);
+  for (const auto& entry : entries) {
+    auto src = entry.first.first;
+    auto dst = entry.first.second;
+    if (src / 3 != dst / 3) {
+      ring_column_sums[dst % 3] += entry.second;
+    }
+  }
+
+  const auto messages_count = 5;
+  const auto& scales = matrix->get_stage_message_scales(
+      0, {3, 3}, {true, false}, 1, false, messages_count);
+  auto message_bytes =
+      uniform_message_bytes(matrix->get_mean_send_size(0), messages_count);
+  for (auto x = 0; x < 3; x++) {
+    auto ring_total = 0.0;
+    for (auto y = 0; y < 3; y++) {
+      ring_total += sum(scales[x + 3 * y]) * message_bytes;
+    }
+    EXPECT_NEAR(ring_total, ring_column_sums[x], 1e-6) << "ring x = " << x;
+  }
+}
@@ -0,0 +1,104 @@
+#!/bin/bash
+# Accuracy vs. speed of the Garnet fast mode (fast-mode-window) against the
+# full flit-level simulation of the same network, system and workload.
+#
+# Usage: Run_Fast_Mode_Report.sh NETWORK SYSTEM WORKLOAD [WINDOW ...]
+#   NETWORK  network file without .txt (as in the other run scripts)
+#   WINDOW   fast mode windows to compare (default: 8 32 128)
+#
+# Not run yet: the fast mode was written without a gem5 build at hand, so
+# neither this script nor the accuracy of the mode has been checked, and no
+# report is committed. Run it before relying on fast-mode-window results.
+start_time=$(date +%s)
+SCRIPT_DIR=$(dirname "$(realpath "${BASH_SOURCE[0]}")")
+
+if [[ $# -lt 3 ]]; then
+    echo "Usage: $0 NETWORK SYSTEM WORKLOAD [WINDOW ...]"
+    exit 1
+fi
+
+# === Executables and paths ===
+BINARY=${SCRIPT_DIR}/../../build/astra_garnet/build/gem5.opt
+CONFIG=${SCRIPT_DIR}/../../extern/network_backend/garnet/gem5_astra/configs/example/garnet_synth_traffic.py
+NETWORK=$(realpath "$1")
+SYSTEM=$(realpath "$2")
+WORKLOAD=$(realpath "$3")
+shift 3
+WINDOWS=("$@")
+if [[ ${#WINDOWS[@]} -eq 0 ]]; then
+    WINDOWS=(8 32 128)
+fi
+BASE_STATS_DIR=${SCRIPT_DIR}/../../examples/results/Fast_Mode_Report
+SYNTHETIC="--synthetic=training"
+REPORT="${BASE_STATS_DIR}/report.txt"
+
+# === Run one experiment: window 0 is the full simulation ===
+run_window() {
+    local window=$1
+    local stats_dir="${BASE_STATS_DIR}/window_${window}"
+    mkdir -p "${stats_dir}"
+    # same network file with the fast mode window (first, since the file
+    # is read as a sequence of key value pairs)
+    echo "fast-mode-window: ${window}" > "${stats_dir}/network.txt"
+    cat "${NETWORK}.txt" >> "${stats_dir}/network.txt"
+
+    local run_start=$(date +%s.%N)
+    M5_OUT_DIR="${stats_dir}" "${BINARY}" "${CONFIG}" ${SYNTHETIC} \
+        --network-configuration="${stats_dir}/network" \
+        --system-configuration="${SYSTEM}" \
+        --workload-configuration="${WORKLOAD}" \
+        --path="${stats_dir}/" \
+        --run-name="fast_mode_${window}" \
+        --num-passes=1 \
+        --total-stat-rows=1 \
+        --stat-row=0 > "${stats_dir}/run.log" 2>&1
+    local run_end=$(date +%s.%N)
+    echo "${run_start} ${run_end}" > "${stats_dir}/wall_time"
+}
+
+mkdir -p "${BASE_STATS_DIR}"
+for window in 0 "${WINDOWS[@]}"; do
+    echo "Running fast-mode-window ${window}"
+    run_window "${window}"
+done
+
+# === Report: simulated finish time and wall time against window 0 ===
+finish_time() {
+    grep "all passes finished at time" "$1/run.log" | tail -1 | awk '{print $NF}'
+}
+wall_time() {
+    awk '{printf "%.1f", $2 - $1}' "$1/wall_time"
+}
+fast_packets() {
+    local packets=$(grep "fast_mode_packets" "$1/stats.txt" 2>/dev/null | awk '{print $2}' | tail -1)
+    echo "${packets:-0}"
+}
+
+full_dir="${BASE_STATS_DIR}/window_0"
+full_finish=$(finish_time "${full_dir}")
+full_wall=$(wall_time "${full_dir}")
+{
+    echo "network:  ${NETWORK}"
+    echo "system:   ${SYSTEM}"
+    echo "workload: ${WORKLOAD}"
+    printf "%-8s %-16s %-10s %-10s %-8s %-14s\n" \
+        "window" "finish_time" "error(%)" "wall(s)" "speedup" "fast_packets"
+    for window in 0 "${WINDOWS[@]}"; do
+        dir="${BASE_STATS_DIR}/window_${window}"
+        finish=$(finish_time "${dir}")
+        wall=$(wall_time "${dir}")
+        if [[ -z "${finish}" || -z "${full_finish}" ]]; then
+            printf "%-8s %-16s (run failed, see %s)\n" "${window}" "-" "${dir}/run.log"
+            continue
+        fi
+        awk -v w="${window}" -v f="${finish}" -v ff="${full_finish}" \
+            -v t="${wall}" -v ft="${full_wall}" -v p="$(fast_packets "${dir}")" \
+            'BEGIN { printf "%-8s %-16s %-10.3f %-10s %-8.2f %-14s\n",
+                     w, f, (f - ff) * 100 / ff, t, (t > 0 ? ft / t : 0), p }'
+    done
+} | tee "${REPORT}"
+
+# === Final report ===
+end_time=$(date +%s)
+total_duration=$((end_time - start_time))
+echo "Report written to ${REPORT} (${total_duration} second(s))"
@@ -92,6 +92,10 @@ def parse_network_input_options(options,var, val):
     except Exception as e:
         print("Error parsing faulty-links '{}': {}".format(val, e))
         options.faulty_links_string = "[]"
+  elif var=="queue-class-vcs:":
+    options.queue_class_vcs = str(val)
+  elif var=="fast-mode-window:":
+    options.fast_mode_window = int(val)
 
 def define_options(parser):
     # By default, ruby uses the simple timing cpu
@@ -233,6 +237,15 @@ def define_options(parser):
                             Implementation: see garnet2.0/RoutingUnit.cc""")
     parser.add_option("--faulty-links", type="string", default="[]",
                   help="List of faulty links, e.g., [[2, 26], [3, 27]]") 
+    parser.add_option("--queue-class-vcs", type="string", default="",
+                  help="""VCs of the AstraSim queue classes (local,
+                        horizontal, vertical; clockwise then
+                        anticlockwise) in a vnet, e.g., 1,1,1,1,1,1.
+                        Empty: all queues share the VCs of their vnet""")
+    parser.add_option("--fast-mode-window", type="int", default=0,
+                  help="""packets of each message simulated flit by flit;
+                        the rest is accounted at the rate the window
+                        reached, at least 2. 0: simulate every packet""")
     parser.add_option("--algorithm", type="choice",
                       default="4phase",
                       choices=['3phase','4phase', '5phase'],
@@ -379,6 +392,8 @@ def init_network(options, network, InterfaceClass):
     network.perpendicular_rings=options.perpendicular_rings
     network.fourth_rings=options.fourth_rings
     network.faulty_links_string = options.faulty_links_string
+    network.queue_class_vcs = options.queue_class_vcs
+    network.fast_mode_window = options.fast_mode_window
     print("[DEBUG] faulty_links_string (repr): {}".format(repr(options.faulty_links_string)))
     print("[DEBUG] faulty_links_string (hex): {}".format(' '.join([hex(ord(c)) for c in options.faulty_links_string])))
 
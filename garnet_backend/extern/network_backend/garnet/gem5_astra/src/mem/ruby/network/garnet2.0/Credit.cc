@@ -33,6 +33,13 @@
 
 #include "mem/ruby/network/garnet2.0/Credit.hh"
 
+SlabAllocator &
+Credit::allocator()
+{
+    static SlabAllocator credit_allocator(sizeof(Credit));
+    return credit_allocator;
+}
+
 // Credit Signal for buffers inside VC
 // Carries m_vc (inherits from flit.hh)
 // and m_is_free_signal (whether VC is free or not)
@@ -59,6 +59,13 @@ class Credit : public flit
 
     ~Credit() {};
 
+    // One credit per flit and hop: same slab allocation as flits
+    static void *operator new(size_t size)
+    { return allocator().allocate(size); }
+    static void operator delete(void *block, size_t size)
+    { allocator().deallocate(block, size); }
+    static SlabAllocator &allocator();
+
     bool is_free_signal() { return m_is_free_signal; }
 
   private:
@@ -37,16 +37,19 @@
 #include <iostream>
 
 #include "base/cast.hh"
+#include "base/logging.hh"
 #include "base/stl_helpers.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
+#include "mem/ruby/network/garnet2.0/Credit.hh"
 #include "mem/ruby/network/garnet2.0/CreditLink.hh"
 #include "mem/ruby/network/garnet2.0/GarnetLink.hh"
 #include "mem/ruby/network/garnet2.0/NetworkInterface.hh"
 #include "mem/ruby/network/garnet2.0/NetworkLink.hh"
 #include "mem/ruby/network/garnet2.0/Router.hh"
+#include "mem/ruby/network/garnet2.0/RoutingUnit.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
 using namespace std;
@@ -69,6 +72,23 @@ GarnetNetwork::GarnetNetwork(const Params *p)
     m_routing_algorithm = p->routing_algorithm;
     m_faulty_links_string = p->faulty_links_string;
     m_faulty_links = parseFaultyLinks(m_faulty_links_string);
+    m_queue_class_vcs = parseQueueClassVCs(p->queue_class_vcs);
+    m_fast_mode_window = p->fast_mode_window;
+    fatal_if(m_fast_mode_window == 1,
+             "fast_mode_window: the window needs 2 packets to measure a "
+             "rate\n");
+    if (!m_queue_class_vcs.empty()) {
+        int class_vcs = 0;
+        for (int vcs : m_queue_class_vcs) {
+            fatal_if(vcs < 1, "queue_class_vcs: every class needs a VC\n");
+            class_vcs += vcs;
+        }
+        fatal_if(m_queue_class_vcs.size() != 6,
+                 "queue_class_vcs: expected the VCs of 6 queue classes\n");
+        fatal_if(class_vcs > (int)m_vcs_per_vnet,
+                 "queue_class_vcs: %d VCs but only %d per vnet\n",
+                 class_vcs, m_vcs_per_vnet);
+    }
 
     m_enable_fault_model = p->enable_fault_model;
     if (m_enable_fault_model)
@@ -303,6 +323,74 @@ GarnetNetwork::init()
     }
 }
 
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+    // routers (children of the network) are initialized by now
+    buildNextHopTables();
+}
+
+// Galois change: fill the DORMIN/SANDWICH/SANDWICHES next-hop table of
+// every router on the route of every (source, destination) pair, so head
+// flits only read them. Each route is walked from its source as a packet
+// would take it, so these are all the entries a packet can look up.
+// Entries of routers off a pair's route are never read and are not
+// computed: a table of every (router, source, destination) would take
+// routers^3 entries (2^30 for 1024 routers). getNextHop still computes a
+// missing entry, which only happens for a route the walk stopped on (no
+// known direction).
+void
+GarnetNetwork::buildNextHopTables()
+{
+    RoutingAlgorithm routing_algorithm =
+        (RoutingAlgorithm) m_routing_algorithm;
+    if (routing_algorithm != DORMIN_ && routing_algorithm != SANDWICH_ &&
+        routing_algorithm != SANDWICHES_) {
+        return;
+    }
+
+    int routers_count = local_rings * horizontal_rings * vertical_rings;
+    for (int src = 0; src < routers_count; src++) {
+        for (int dst = 0; dst < routers_count; dst++) {
+            RouteInfo route = RouteInfo();
+            route.src_router = src;
+            route.dest_router = dst;
+            int router = src;
+            // the packet enters its source router from the NI
+            int inport_direction = -1;
+            for (int hops = 0; router != dst && hops < routers_count;
+                 hops++) {
+                int direction = m_routers[router]->get_routing_unit()->
+                    nextHopDirection(route, inport_direction);
+                if (direction < 0) {
+                    // unknown, left to the head flits
+                    break;
+                }
+                // neighbour in the direction codes of nextHopDORMIN
+                int x = router % local_rings;
+                int y = (router % (local_rings * horizontal_rings)) /
+                    local_rings;
+                int z = router / (local_rings * horizontal_rings);
+                switch (direction) {
+                  case 0: x = (x - 1 + local_rings) % local_rings; break;
+                  case 1: x = (x + 1) % local_rings; break;
+                  case 2: y = (y - 1 + horizontal_rings) % horizontal_rings;
+                    break;
+                  case 3: y = (y + 1) % horizontal_rings; break;
+                  case 4: z = (z - 1 + vertical_rings) % vertical_rings;
+                    break;
+                  default: z = (z + 1) % vertical_rings; break;
+                }
+                router = x + y * local_rings +
+                    z * local_rings * horizontal_rings;
+                // a hop East arrives on the West inport, and so on
+                inport_direction = direction ^ 1;
+            }
+        }
+    }
+}
+
 GarnetNetwork::~GarnetNetwork()
 {
     deletePointers(m_routers);
@@ -614,6 +702,32 @@ GarnetNetwork::regStats()
         .name(name() + ".avg_vc_load")
         .flags(Stats::pdf | Stats::total | Stats::nozero | Stats::oneline)
         ;
+
+    // Pools: in steady state the allocations are served without new
+    // blocks or messages
+    m_flit_allocations
+        .name(name() + ".flit_allocations");
+    m_flit_pool_blocks
+        .name(name() + ".flit_pool_blocks");
+    m_flit_pool_peak_in_use
+        .name(name() + ".flit_pool_peak_in_use");
+    m_credit_allocations
+        .name(name() + ".credit_allocations");
+    m_credit_pool_blocks
+        .name(name() + ".credit_pool_blocks");
+    m_credit_pool_peak_in_use
+        .name(name() + ".credit_pool_peak_in_use");
+    m_packet_messages_cloned
+        .name(name() + ".packet_messages_cloned");
+    m_packet_messages_reused
+        .name(name() + ".packet_messages_reused");
+
+    // Fast mode: packets accounted at the measured rate instead of being
+    // simulated
+    m_fast_mode_messages
+        .name(name() + ".fast_mode_messages");
+    m_fast_mode_packets
+        .name(name() + ".fast_mode_packets");
 }
 
 void
@@ -646,6 +760,43 @@ GarnetNetwork::collateStats()
     for (int i = 0; i < m_routers.size(); i++) {
         m_routers[i]->collateStats();
     }
+
+    m_flit_allocations = flit::allocator().get_allocations();
+    m_flit_pool_blocks = flit::allocator().get_blocks();
+    m_flit_pool_peak_in_use = flit::allocator().get_peak_in_use();
+    m_credit_allocations = Credit::allocator().get_allocations();
+    m_credit_pool_blocks = Credit::allocator().get_blocks();
+    m_credit_pool_peak_in_use = Credit::allocator().get_peak_in_use();
+    uint64_t packets_cloned = 0;
+    uint64_t packets_reused = 0;
+    for (int i = 0; i < m_nis.size(); i++) {
+        packets_cloned += m_nis[i]->packets_cloned;
+        packets_reused += m_nis[i]->packets_reused;
+    }
+    m_packet_messages_cloned = packets_cloned;
+    m_packet_messages_reused = packets_reused;
+}
+
+void
+GarnetNetwork::recycle_packet(MsgPtr& msg_ptr)
+{
+    m_nis[msg_ptr->capi_src]->free_packets.push_back(msg_ptr);
+}
+
+void
+GarnetNetwork::fast_mode_measured(MsgPtr& msg_ptr, int dst, Tick span,
+                                  int packets)
+{
+    m_fast_mode_messages++;
+    m_fast_mode_packets += packets;
+    // the accounted packets keep the links of the path busy while they
+    // would have crossed them
+    uint64_t flits = (uint64_t)packets * msg_ptr->getFlits();
+    for (NetworkLink *link : msg_ptr->fast_links) {
+        link->reserve(curTick(), curTick() + span, flits);
+    }
+    m_nis[msg_ptr->capi_src]->release_fast_send(dst, msg_ptr->capi_type,
+                                                msg_ptr->capi_tag, span);
 }
 
 void
@@ -726,4 +877,18 @@ std::vector<std::vector<int>> parseFaultyLinks(const std::string& input) {
     std::cout << std::endl;
 
     return result;
-}
\ No newline at end of file
+}
+
+// e.g., "2,2,1,1,1,1": VCs of each queue class, see getQueueClassVCs()
+std::vector<int> parseQueueClassVCs(const std::string& input) {
+    std::vector<int> result;
+    std::stringstream ss(input);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+        result.push_back(std::stoi(item));
+    }
+    return result;
+}
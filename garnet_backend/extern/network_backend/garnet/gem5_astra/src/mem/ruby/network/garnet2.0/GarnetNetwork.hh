@@ -40,6 +40,7 @@
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
 #include "params/GarnetNetwork.hh"
 #include <sstream>
 #include <regex>
@@ -63,6 +64,7 @@ class GarnetNetwork : public Network
 
     ~GarnetNetwork();
     void init();
+    void startup();
 
     // Configuration (set externally)
 
@@ -76,7 +78,10 @@ class GarnetNetwork : public Network
     uint32_t getBuffersPerDataVC() { return m_buffers_per_data_vc; }
     uint32_t getBuffersPerCtrlVC() { return m_buffers_per_ctrl_vc; }
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
-    std::vector<std::vector<int>> getFaultyLinks() const { return m_faulty_links; }
+    const std::vector<std::vector<int>>& getFaultyLinks() const { return m_faulty_links; }
+    // VCs of each AstraSim queue class (local, horizontal, vertical queues,
+    // clockwise then anticlockwise) within a vnet; empty: classes share
+    const std::vector<int>& getQueueClassVCs() const { return m_queue_class_vcs; }
 
     bool isFaultModelEnabled() const { return m_enable_fault_model; }
     FaultModel* fault_model;
@@ -246,6 +251,17 @@ class GarnetNetwork : public Network
         m_total_hops += hops;
     }
 
+    // Hand the message of a delivered packet back to the NI that created it
+    void recycle_packet(MsgPtr& msg_ptr);
+
+    // Fast mode: packets of a message simulated flit by flit before the
+    // rest is accounted at the measured rate (0: off)
+    int get_fast_mode_window() const { return m_fast_mode_window; }
+    // The receiver of a fast mode message accounted its remaining packets
+    // (msg_ptr: the packet closing the window)
+    void fast_mode_measured(MsgPtr& msg_ptr, int dst, Tick span,
+                            int packets);
+
   protected:
     // Configuration
     int m_num_rows;
@@ -258,6 +274,8 @@ class GarnetNetwork : public Network
     bool m_enable_fault_model;
     std::string m_faulty_links_string;
     std::vector<std::vector<int>> m_faulty_links;
+    std::vector<int> m_queue_class_vcs;
+    int m_fast_mode_window;
 
     // Statistical variables
     Stats::Vector m_packets_received;
@@ -291,10 +309,28 @@ class GarnetNetwork : public Network
     Stats::Scalar  m_total_hops;
     Stats::Formula m_avg_hops;
 
+    // Pools
+    Stats::Scalar m_flit_allocations;
+    Stats::Scalar m_flit_pool_blocks;
+    Stats::Scalar m_flit_pool_peak_in_use;
+    Stats::Scalar m_credit_allocations;
+    Stats::Scalar m_credit_pool_blocks;
+    Stats::Scalar m_credit_pool_peak_in_use;
+    Stats::Scalar m_packet_messages_cloned;
+    Stats::Scalar m_packet_messages_reused;
+
+    // Fast mode
+    Stats::Scalar m_fast_mode_messages;
+    Stats::Scalar m_fast_mode_packets;
+
   private:
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    // Fill the next-hop tables of the routing units (DORMIN, SANDWICH and
+    // SANDWICHES routing)
+    void buildNextHopTables();
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
@@ -370,4 +406,5 @@ operator<<(std::ostream& out, const GarnetNetwork& obj)
     return out;
 }
 std::vector<std::vector<int>> parseFaultyLinks(const std::string& input);
+std::vector<int> parseQueueClassVCs(const std::string& input);
 #endif //__MEM_RUBY_NETWORK_GARNET2_0_GARNETNETWORK_HH__
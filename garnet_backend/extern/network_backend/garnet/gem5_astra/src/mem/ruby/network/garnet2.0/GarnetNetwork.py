@@ -46,6 +46,12 @@ class GarnetNetwork(RubyNetwork):
     routing_algorithm = Param.Int(0,
         "0: Weight-based Table, 1: XY, 2: Custom");
     faulty_links_string = Param.String("[]", "List of faulty links, e.g., [[2, 26],[3, 27]]")
+    queue_class_vcs = Param.String("", "VCs of the AstraSim queue classes "
+        "(local, horizontal, vertical; clockwise then anticlockwise) in a "
+        "vnet, e.g., 1,1,1,1,1,1; empty: all queues share the VCs")
+    fast_mode_window = Param.UInt32(0, "packets of each message simulated "
+        "flit by flit before the rest is accounted at the rate they "
+        "reached, at least 2 (0: simulate every packet)")
     enable_fault_model = Param.Bool(False, "enable network fault model");
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
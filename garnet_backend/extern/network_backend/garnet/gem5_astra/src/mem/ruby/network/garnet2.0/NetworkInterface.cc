@@ -33,6 +33,7 @@
 
 #include "mem/ruby/network/garnet2.0/NetworkInterface.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -165,14 +166,16 @@ NetworkInterface::init()
     }
     //mycode
     template_message_received=0;
+    packets_cloned=0;
+    packets_reused=0;
+    send_queue_next=0;
     
     for (int i = 0; i < m_virtual_networks; i++) {
         std::vector<std::pair<flit *,InputPort *>> tempTupleVector;
         waiting_packets[i]=tempTupleVector;
         waiting_packets_done[i]=0;
 
-        std::list<Recv_Req> empty_r;
-        recv_reqs[i]=empty_r;
+        recv_reqs[i]=Recv_Req_Index();
 
         std::list<Send_Req> empty_s;
         send_reqs[i]=empty_s;
@@ -332,6 +335,7 @@ NetworkInterface::wakeup()
             std::vector<int> queues_per_dim{local_queues, 
                                             horiz_queues,
                                             ver_queues};
+            init_queue_classes(queues_per_dim);
      		my_generator=new AstraSim::Sys(this,NULL,m_id,m_net_ptr->num_passes,
                                            physical_dims,queues_per_dim,m_net_ptr->sys_input,
                                            m_net_ptr->get_workload(),m_net_ptr->get_comm_scale(),
@@ -360,17 +364,43 @@ NetworkInterface::wakeup()
     if(template_message_received==1){
         //my_generator->iterate();
         if(enabled) {
-            for (auto &vn:send_reqs) {
-                int vnet = vn.first;//0; vnet < vnets_to_query; ++vnet
+            // one packet per wakeup, as with the single send FIFO; with a
+            // FIFO per queue, the queues take turns starting the search
+            auto next=send_reqs.lower_bound(send_queue_next);
+            for (int i = 0; i < send_reqs.size(); i++, next++) {
+                if (next==send_reqs.end()) {
+                    next=send_reqs.begin();
+                }
+                auto &vn=*next;
                 if (vn.second.size()>0) { 
                     Send_Req &sr=vn.second.front();
-                    int vc_num=calculateVC(vnet);
+                    if(sr.fast_waiting){
+                        // the queue stays busy while the rest of the message
+                        // would have been injected
+                        if(sr.fast_release!=0 && curTick()>=sr.fast_release){
+                            vn.second.pop_front();
+                        }
+                        continue;
+                    }
+                    int vc_num=calculateVC(sr.vnet,sr.vc_class);
                     if (vc_num!=-1) { //vnet 
-                        flitisizeMessage(vc_num,sr.packet_size,sr.type,sr.dst,sr.tag,true,vnet);
-                        sr.packets_to_send--;
-                        if(sr.packets_to_send==0){
+                        // fast mode: the last packet of the window also
+                        // stands for the packets that are not simulated
+                        int packets=1;
+                        if(sr.fast_packets>0 && sr.packets_to_send==sr.fast_packets+1){
+                            packets+=sr.fast_packets;
+                        }
+                        flitisizeMessage(vc_num,sr.packet_size,sr.type,sr.dst,sr.tag,true,sr.vnet,packets);
+                        sr.packets_to_send-=packets;
+                        if(packets>1){
+                            sr.fast_waiting=true;
+                            sr.fast_issue=curTick();
+                        }
+                        else if(sr.packets_to_send==0){
                             vn.second.pop_front();
                         }
+                        send_queue_next=vn.first+1;
+                        break;
                     }
                 }
             }
@@ -406,25 +436,55 @@ NetworkInterface::wakeup()
                 if (t_flit->get_type() == TAIL_ ||
                     t_flit->get_type() == HEAD_TAIL_) {
                     //cout<<"message received at node: "<<m_id<<" , at vnet: "<<vnet<<endl;
-                    //std::list<Recv_Req> &reqs=recv_reqs[vnet];
                     RouteInfo t_flit_route = t_flit->get_route();
-                    std::list<Recv_Req>::iterator it=recv_reqs[vnet].begin();
                     MsgPtr mptr=t_flit->get_msg_ptr();
-                    bool found= false;
-                    while(it!=recv_reqs[vnet].end()){
-                        assert((*it).packets_to_receive>0);
-                        if((*it).type==t_flit->get_msg_ptr().get()->capi_type &&
-                        (*it).src==t_flit->get_msg_ptr().get()->capi_src &&
-                        (*it).tag==t_flit->get_msg_ptr().get()->capi_tag){
-                            (*it).packets_to_receive--;
-                            if(((*it).packets_to_receive)==0){
-                                (*((*it).msg_handler))((*it).fun_arg);
-                                recv_reqs[vnet].erase(it);
+                    Recv_Req_Key key={mptr.get()->capi_type,
+                                      mptr.get()->capi_src,
+                                      mptr.get()->capi_tag};
+                    Recv_Req_Index &reqs=recv_reqs[vnet];
+                    Recv_Req_Index::iterator it=reqs.find(key);
+                    bool found=(it!=reqs.end());
+                    if(found){
+                        Recv_Req &r=it->second.front();
+                        assert(r.packets_to_receive>0);
+                        if(r.packets_received==0){
+                            r.first_arrival=curTick();
+                        }
+                        r.packets_received++;
+                        int packets=mptr.get()->capi_count;
+                        if(packets>1){
+                            // fast mode: the sender stopped after this window,
+                            // the rest arrives at the rate measured so far
+                            int analytic_packets=packets-1;
+                            double per_packet=mptr.get()->getFlits();
+                            if(r.packets_received>1){
+                                per_packet=(double)(curTick()-r.first_arrival)/(r.packets_received-1);
                             }
-                            found= true;
-                            break;
-                        } //count,type,src,tag;
-                        std::advance(it,1);
+                            Tick span=(Tick)ceil(per_packet*analytic_packets);
+                            r.fast_done=curTick()+span;
+                            m_net_ptr->fast_mode_measured(mptr,m_id,span,analytic_packets);
+                        }
+                        assert(r.packets_to_receive>=packets);
+                        r.packets_to_receive-=packets;
+                        if(r.packets_to_receive==0){
+                            // the handler may post new receives, so the
+                            // request leaves the index before it runs
+                            void (*msg_handler)(void *)=r.msg_handler;
+                            void *fun_arg=r.fun_arg;
+                            Tick fast_done=r.fast_done;
+                            it->second.pop_front();
+                            if(it->second.empty()){
+                                reqs.erase(it);
+                            }
+                            if(fast_done>curTick()){
+                                AstraSim::timespec_t delta;
+                                delta.time_val=(fast_done-curTick())*CLK_PERIOD;
+                                sim_schedule(delta,msg_handler,fun_arg);
+                            }
+                            else{
+                                (*msg_handler)(fun_arg);
+                            }
+                        }
                     }
                     // Add extra debug print for unfound scenario
                     if (!found) {
@@ -433,16 +493,24 @@ NetworkInterface::wakeup()
                         std::cout << "[Flit Info] Msg Type: " << t_flit->get_msg_ptr()->capi_type
                                 << ", Src: " << t_flit->get_msg_ptr()->capi_src
                                 << ", Tag: " << t_flit->get_msg_ptr()->capi_tag << std::endl;
-                        std::cout << "[Receive Requests in VNet " << vnet << "] Total: "
-                                << recv_reqs[vnet].size() << std::endl;
-
-                        // If necessary, iterate over and print all the received request information in recv_reqs[vnet]
-                        for (auto recv_it = recv_reqs[vnet].begin(); recv_it != recv_reqs[vnet].end(); ++recv_it) {
-                            std::cout << "[Registered Recv Req] Type: " << recv_it->type
-                                    << ", Src: " << recv_it->src
-                                    << ", Tag: " << recv_it->tag
-                                    << ", Packets to Receive: " << recv_it->packets_to_receive
-                                    << std::endl;
+
+                        // With --debug-flags=RubyNetwork, also print all the receive requests registered in the vnet
+                        if (DTRACE(RubyNetwork)) {
+                            size_t total = 0;
+                            for (auto &key_reqs : reqs) {
+                                total += key_reqs.second.size();
+                            }
+                            std::cout << "[Receive Requests in VNet " << vnet << "] Total: "
+                                    << total << std::endl;
+                            for (auto &key_reqs : reqs) {
+                                for (auto &recv_req : key_reqs.second) {
+                                    std::cout << "[Registered Recv Req] Type: " << recv_req.type
+                                            << ", Src: " << recv_req.src
+                                            << ", Tag: " << recv_req.tag
+                                            << ", Packets to Receive: " << recv_req.packets_to_receive
+                                            << std::endl;
+                                }
+                            }
                         }
                     }
                     assert(found==true);
@@ -454,6 +522,10 @@ NetworkInterface::wakeup()
                     incrementStats(t_flit);
                     //std::cout<<"delete tflit at time: "<<curTick()<<" for node: "<<m_id<<std::endl;
                     delete t_flit;
+                    // the tail was the last flit holding the message
+                    if(mptr.use_count()==1){
+                        m_net_ptr->recycle_packet(mptr);
+                    }
                     //mptr.reset();
                      /*else {
                     // No space available- Place tail flit in stall queue and
@@ -573,7 +645,7 @@ NetworkInterface::checkStallQueue()
 }
 
 bool
-NetworkInterface::flitisizeMessage(int vc,int packet_size,int type,int dst,int tag,bool is_end,int vnet)
+NetworkInterface::flitisizeMessage(int vc,int packet_size,int type,int dst,int tag,bool is_end,int vnet,int packets)
 {
     /*if(my_generator->method=="proposed" || (my_generator->method=="baseline" && reserved_VCs[vnet]>0)){
         reserved_VCs[vnet]--;
@@ -585,7 +657,7 @@ NetworkInterface::flitisizeMessage(int vc,int packet_size,int type,int dst,int t
         }
         assert(reserved_VCs[vnet]>=0);
     }*/
-    MsgPtr msg_ptr=create_packet(packet_size,type,dst,tag,is_end,vnet);
+    MsgPtr msg_ptr=create_packet(packet_size,type,dst,tag,is_end,vnet,packets);
     Message *net_msg_ptr = msg_ptr.get();
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
@@ -807,6 +879,79 @@ NetworkInterface::calculateVC(int vnet)
 }
 
 
+void
+NetworkInterface::release_fast_send(int dst, int type, int tag, Tick span)
+{
+    for (auto &vn: send_reqs) {
+        if (vn.second.empty()) {
+            continue;
+        }
+        Send_Req &sr = vn.second.front();
+        if (sr.fast_waiting && sr.fast_release == 0 && sr.dst == dst &&
+            sr.type == type && sr.tag == tag) {
+            sr.fast_release = std::max(sr.fast_issue + span, curTick() + 1);
+            AstraSim::timespec_t delta;
+            delta.time_val = (sr.fast_release - curTick()) * CLK_PERIOD;
+            sim_schedule(delta, &NetworkInterface::marker, NULL);
+            return;
+        }
+    }
+    panic("%s: no fast mode send to %d (type %d, tag %d)\n",
+          name(), dst, type, tag);
+}
+
+// Looking for a free output vc among the VCs of a queue class
+int
+NetworkInterface::calculateVC(int vnet, int vc_class)
+{
+    if (vc_class < 0) {
+        return calculateVC(vnet);
+    }
+
+    const std::vector<int> &class_vcs = m_net_ptr->getQueueClassVCs();
+    int classes = class_vcs.size();
+    int &allocator = class_vc_allocator[vnet * classes + vc_class];
+    for (int i = 0; i < class_vcs[vc_class]; i++) {
+        int delta = class_first_vc[vc_class] + allocator;
+        allocator++;
+        if (allocator == class_vcs[vc_class])
+            allocator = 0;
+
+        if (m_out_vc_state[(vnet*m_vc_per_vnet) + delta]->isInState(
+                    IDLE_, curTick())) {
+            vc_busy_counter[vnet] = 0;
+            return ((vnet*m_vc_per_vnet) + delta);
+        }
+    }
+
+    vc_busy_counter[vnet] += 1;
+    return -1;
+}
+
+// Queue classes: local, horizontal and vertical queues, each split into
+// the clockwise (first half) and anticlockwise queues of the dimension
+void
+NetworkInterface::init_queue_classes(const std::vector<int> &queues_per_dim)
+{
+    const std::vector<int> &class_vcs = m_net_ptr->getQueueClassVCs();
+    queue_classes.clear();
+    if (class_vcs.empty()) {
+        return;
+    }
+    for (int dim = 0; dim < queues_per_dim.size(); dim++) {
+        int queues = queues_per_dim[dim];
+        for (int j = 0; j < queues; j++) {
+            bool anticlockwise = (queues > 1 && j >= queues / 2);
+            queue_classes.push_back(2 * dim + (anticlockwise ? 1 : 0));
+        }
+    }
+    class_first_vc.assign(class_vcs.size(), 0);
+    for (int c = 1; c < class_vcs.size(); c++) {
+        class_first_vc[c] = class_first_vc[c - 1] + class_vcs[c - 1];
+    }
+    class_vc_allocator.assign(m_virtual_networks * class_vcs.size(), 0);
+}
+
 // test free VC
 bool
 NetworkInterface::testFreeVC(int vnet)
@@ -1061,8 +1206,25 @@ int NetworkInterface::sim_send(void *buffer, uint64_t count, int type, int dst,
     //count=nextPowerOf2(count);
     int packets=ceil(((double)count)/m_net_ptr->get_package_packet_size());
     Send_Req sr(count,packets,type,dst,tag,m_net_ptr->get_package_packet_size());
+    int queue = request->vnet;
     request->vnet = 0; 
-    send_reqs[request->vnet].push_back(sr);
+    sr.vnet = request->vnet;
+    // fast mode: only a window of packets is simulated flit by flit, the
+    // receiver accounts the rest at the rate the window reached
+    int window=m_net_ptr->get_fast_mode_window();
+    if(window>0 && packets>window+1){
+        sr.fast_packets=packets-window;
+    }
+    if(queue_classes.empty()){
+        send_reqs[request->vnet].push_back(sr);
+    }
+    else{
+        // each queue keeps its own order, so a stage waiting for a VC of
+        // its class does not hold back the stages of the other queues
+        assert(queue>=0 && queue<queue_classes.size());
+        sr.vc_class = queue_classes[queue];
+        send_reqs[queue].push_back(sr);
+    }
 
     if(events_list.find(curTick()+1)==events_list.end()){
         AstraSim::timespec_t delta;
@@ -1071,11 +1233,19 @@ int NetworkInterface::sim_send(void *buffer, uint64_t count, int type, int dst,
     }
     return 1;
 }
-MsgPtr NetworkInterface::create_packet(int packet_size,int type,int dst,int tag,bool is_end,int vnet){
+MsgPtr NetworkInterface::create_packet(int packet_size,int type,int dst,int tag,bool is_end,int vnet,int packets){
     int flits=ceil(((double)packet_size*8)/flit_width);
     MsgPtr new_msg_ptr;
     Message *new_net_msg_ptr;
-    new_msg_ptr = template_msg->clone();
+    if(!free_packets.empty()){
+        new_msg_ptr = free_packets.back();
+        free_packets.pop_back();
+        packets_reused++;
+    }
+    else{
+        new_msg_ptr = template_msg->clone();
+        packets_cloned++;
+    }
     new_net_msg_ptr = new_msg_ptr.get();
     NodeID destID=dst;
     NetDest personal_dest;
@@ -1097,6 +1267,8 @@ MsgPtr NetworkInterface::create_packet(int packet_size,int type,int dst,int tag,
     new_net_msg_ptr->capi_type=type;
     new_net_msg_ptr->capi_src=m_id;
     new_net_msg_ptr->capi_tag=tag;
+    new_net_msg_ptr->capi_count=packets;
+    new_net_msg_ptr->fast_links.clear();
     new_net_msg_ptr->vnet_to_fetch=vnet;
 
     return new_msg_ptr;
@@ -1106,7 +1278,8 @@ int NetworkInterface::sim_recv(void *buffer, uint64_t count, int type, int src,
     int packets=ceil(((double)count)/m_net_ptr->get_package_packet_size());
     Recv_Req r(count,packets,type,src,tag,msg_handler,fun_arg);
     request->vnet = 0; 
-    recv_reqs[request->vnet].push_back(r);
+    Recv_Req_Key key={type,src,tag};
+    recv_reqs[request->vnet][key].push_back(r);
     return 1;
 }
 void NetworkInterface::call_events(){
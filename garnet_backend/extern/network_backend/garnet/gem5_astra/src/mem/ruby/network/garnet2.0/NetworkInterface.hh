@@ -53,6 +53,7 @@
 #include <chrono> 
 #include <ctime>
 #include <tuple>
+#include <unordered_map>
 
 // Astra-Sim:
 #include "astra-sim/system/AstraNetworkAPI.hh"
@@ -100,26 +101,73 @@ class NetworkInterface : public ClockedObject, public Consumer,
     class Recv_Req{
         public:
             int count,type,src,tag,packets_to_receive;
+            // fast mode: arrivals of the simulated window, and the tick at
+            // which the packets accounted analytically have arrived
+            int packets_received;
+            Tick first_arrival,fast_done;
             void (*msg_handler)(void *);
             void* fun_arg;
             Recv_Req(int count,int packets_to_receive,int type,int src,int tag,void (*msg_handler)(void *),void *fun_arg){
                 this->packets_to_receive=packets_to_receive;this->count=count;this->type=type;this->src=src;this->tag=tag;this->msg_handler=msg_handler;this->fun_arg=fun_arg;
+                this->packets_received=0;this->first_arrival=0;this->fast_done=0;
             }
     };
     class Send_Req{
         public:
             int count,type,dst,tag,packets_to_send,packet_size;
+            int vnet,vc_class;
+            // fast mode: packets left to the receiver's estimate, issue tick
+            // of the packet closing the window, and when the queue is free
+            int fast_packets;
+            bool fast_waiting;
+            Tick fast_issue,fast_release;
             void (*msg_handler)(void *);
             void* fun_arg;
             Send_Req(int count,int packets_to_send,int type,int dst,int tag,int packet_size){
                 this->packets_to_send=packets_to_send;this->count=count;this->type=type;this->dst=dst;this->tag=tag;this->packet_size=packet_size;
+                this->vnet=0;this->vc_class=-1;
+                this->fast_packets=0;this->fast_waiting=false;this->fast_issue=0;this->fast_release=0;
             }
     };
-    MsgPtr create_packet(int packet_size,int type,int dst,int tag,bool is_end,int vnet);
+    // packets: how many packets of the message this one stands for (more
+    // than one for the packet closing a fast mode window)
+    MsgPtr create_packet(int packet_size,int type,int dst,int tag,bool is_end,int vnet,int packets=1);
+    // Fast mode: the receiver of a window estimated that the rest of the
+    // message takes span ticks after the closing packet
+    void release_fast_send(int dst,int type,int tag,Tick span);
+    // messages of the packets this NI sent that have been delivered, reused
+    // by create_packet instead of cloning template_msg again
+    std::vector<MsgPtr> free_packets;
+    uint64_t packets_cloned,packets_reused;
     std::map<unsigned long long,std::list<std::pair<void (*)(void *),void*>>> events_list;
     void call_events();
+    // pending sends by vnet, or by AstraSim queue when the queues have VC
+    // classes (see GarnetNetwork::getQueueClassVCs)
     std::map<int,std::list<Send_Req>> send_reqs;
-    std::map<int,std::list<Recv_Req>> recv_reqs;
+    // send FIFO the next wakeup looks at first
+    int send_queue_next;
+    // VC class of each AstraSim queue, first VC of each class in a vnet
+    std::vector<int> queue_classes;
+    std::vector<int> class_first_vc;
+    std::vector<int> class_vc_allocator;
+    void init_queue_classes(const std::vector<int> &queues_per_dim);
+    // pending receives of a vnet by (type, src, tag), each key in posting
+    // order so that arriving packets match the oldest receive first
+    struct Recv_Req_Key{
+        int type,src,tag;
+        bool operator==(const Recv_Req_Key &other) const{
+            return type==other.type && src==other.src && tag==other.tag;
+        }
+    };
+    struct Recv_Req_Key_Hash{
+        size_t operator()(const Recv_Req_Key &key) const{
+            size_t h=std::hash<int>()(key.type);
+            h=h*31+std::hash<int>()(key.src);
+            return h*31+std::hash<int>()(key.tag);
+        }
+    };
+    typedef std::unordered_map<Recv_Req_Key,std::list<Recv_Req>,Recv_Req_Key_Hash> Recv_Req_Index;
+    std::map<int,Recv_Req_Index> recv_reqs;
     int flit_width;
     MsgPtr template_msg;
     static void marker(void *argument){return;};
@@ -346,8 +394,9 @@ class NetworkInterface : public ClockedObject, public Consumer,
 
     bool checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
-    bool flitisizeMessage(int vc,int packet_size,int type,int dst,int tag,bool is_end,int vnet);
+    bool flitisizeMessage(int vc,int packet_size,int type,int dst,int tag,bool is_end,int vnet,int packets=1);
     int calculateVC(int vnet);
+    int calculateVC(int vnet, int vc_class);
 
     void scheduleOutputLink();
     void scheduleOutputLinkForVnet(int vn);
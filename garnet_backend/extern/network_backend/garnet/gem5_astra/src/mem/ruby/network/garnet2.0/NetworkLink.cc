@@ -78,7 +78,7 @@ NetworkLink::wakeup()
     DPRINTF(RubyNetwork, "Woke up to transfer from %s to %s\n",
     src_object->name(), link_consumer->getName());
     assert(curTick() == clockEdge());
-    if (link_srcQueue->isReady(curTick())) {
+    if (link_srcQueue->isReady(curTick()) && !isReserved(curTick())) {
         flit *t_flit = link_srcQueue->getTopFlit();
         if (m_type != NUM_LINK_TYPES_) {
             // Only for assertions and debug messages
@@ -94,6 +94,12 @@ NetworkLink::wakeup()
                 t_flit->get_vnet()) != mVnets.end()) ||
                 (std::find(mVnets.begin(), mVnets.end(), -1) != mVnets.end()));
         }
+        // fast mode: the receiver reserves the path of the closing packet
+        if (t_flit->get_msg_ptr()->capi_count > 1 &&
+            (t_flit->get_type() == HEAD_ ||
+             t_flit->get_type() == HEAD_TAIL_)) {
+            t_flit->get_msg_ptr()->fast_links.push_back(this);
+        }
         t_flit->set_time(clockEdge(m_latency));
         linkBuffer->insert(t_flit);
         link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
@@ -106,6 +112,40 @@ NetworkLink::wakeup()
     }
 }
 
+void
+NetworkLink::reserve(Tick begin, Tick end, uint64_t flits)
+{
+    if (end > begin && flits > 0) {
+        m_reservations.push_back({begin, end, flits});
+    }
+}
+
+bool
+NetworkLink::isReserved(Tick time)
+{
+    bool reserved = false;
+    for (auto it = m_reservations.begin(); it != m_reservations.end(); ) {
+        if (time >= it->end) {
+            it = m_reservations.erase(it);
+            continue;
+        }
+        if (time >= it->begin) {
+            // the reserved flits take the cycles where their share of the
+            // interval reaches the next whole flit
+            uint64_t cycle = (time - it->begin) / clockPeriod();
+            uint64_t cycles = (it->end - it->begin + clockPeriod() - 1) /
+                              clockPeriod();
+            if (it->flits >= cycles ||
+                (it->flits * (cycle + 1)) / cycles >
+                (it->flits * cycle) / cycles) {
+                reserved = true;
+            }
+        }
+        ++it;
+    }
+    return reserved;
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -62,6 +62,10 @@ class NetworkLink : public ClockedObject, public Consumer
     flitBuffer *getBuffer() { return linkBuffer;}
     virtual void wakeup();
 
+    // Fast mode: keep flits of the packets accounted analytically on the
+    // link from begin to end, spread evenly over that interval
+    void reserve(Tick begin, Tick end, uint64_t flits);
+
     unsigned int getLinkUtilization() const { return m_link_utilized; }
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
 
@@ -85,6 +89,14 @@ class NetworkLink : public ClockedObject, public Consumer
     link_type m_type;
     const Cycles m_latency;
 
+    struct Reservation {
+        Tick begin, end;
+        uint64_t flits;
+    };
+    std::vector<Reservation> m_reservations;
+    // whether a reserved flit uses the link at time
+    bool isReserved(Tick time);
+
   protected:
     flitBuffer *linkBuffer;
     Consumer *link_consumer;
@@ -86,6 +86,7 @@ Router::init()
 
     m_sw_alloc->init();
     m_switch->init();
+    m_routing_unit->init();
 }
 
 void
@@ -122,6 +122,7 @@ class Router : public BasicRouter, public Consumer
     SwitchAllocator *get_switch_allocator(){
         return m_sw_alloc;
     }
+    RoutingUnit *get_routing_unit() { return m_routing_unit; }
     //std::vector<bool> critical;
   private:
     Cycles m_latency;
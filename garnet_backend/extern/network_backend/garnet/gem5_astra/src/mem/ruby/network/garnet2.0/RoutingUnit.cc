@@ -148,6 +148,10 @@ RoutingUnit::addInDirection(PortDirection inport_dirn, int inport_idx)
 {
     m_inports_dirn2idx[inport_dirn] = inport_idx;
     m_inports_idx2dirn[inport_idx]  = inport_dirn;
+    if (inport_idx >= m_inports_direction.size()) {
+        m_inports_direction.resize(inport_idx + 1, -1);
+    }
+    m_inports_direction[inport_idx] = parseDirectionToIndex(inport_dirn);
 }
 
 void
@@ -177,7 +181,6 @@ RoutingUnit::outportCompute(RouteInfo &route, int inport,
     // Can be over-ridden from command line using --routing-algorithm = 1
     RoutingAlgorithm routing_algorithm =
         (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
-    parsed_faulty_links = m_router->get_net_ptr()->getFaultyLinks();
 
     switch (routing_algorithm) {
         case TABLE_:  outport =
@@ -191,12 +194,10 @@ RoutingUnit::outportCompute(RouteInfo &route, int inport,
             outportComputeRINGXY(route, inport, inport_dirn); break;
         case ALLTOALL_: outport =
             outportComputeALLTOALL(route, inport, inport_dirn); break;
-        case DORMIN_: outport =
-            outportComputeDORMIN(route, inport, inport_dirn);break;
-        case SANDWICH_: outport = 
-            outportComputeSANDWICH(route, inport, inport_dirn);break;
-        case SANDWICHES_: outport = 
-            outportComputeSANDWICHES(route, inport, inport_dirn);break;
+        case DORMIN_:
+        case SANDWICH_:
+        case SANDWICHES_: outport =
+            outportComputeNextHop(route, inport); break;
         default: outport =
             lookupRoutingTable(route.vnet, route.net_dest); break;
     }
@@ -367,118 +368,6 @@ RoutingUnit::outportComputeALLTOALL(RouteInfo route,
     
     return m_outports_dirn2idx[outport_dirn];
 }
-int
-RoutingUnit::outportComputeDORMIN(RouteInfo &route,
-                              int inport,
-                              PortDirection inport_dirn)
-{   
-    PortDirection outport_dirn = "Unknown";
-	std::vector<int>::iterator it;
-    int my_vnet=route.vnet;
-    int local_num = m_router->get_net_ptr()->get_local_rings(); 
-    int horizontal_num = m_router->get_net_ptr()->get_horizontal_rings();
-    int vertical_num = m_router->get_net_ptr()->get_vertical_rings();
-
-    int my_id = m_router->get_id();
-    int my_x = my_id % local_num; 
-    int my_y = (my_id % (local_num * horizontal_num)) / local_num;
-    int my_z = my_id / (local_num * horizontal_num);
-
-    int dst_id = route.dest_router;
-    int dst_x = dst_id  % local_num;
-    int dst_y = (dst_id % (local_num * horizontal_num)) / local_num;
-    int dst_z = dst_id / (local_num * horizontal_num);
-
-    int src_id = route.src_router;
-    int src_x = src_id  % local_num;
-    int src_y = (src_id % (local_num * horizontal_num)) / local_num;
-    int src_z = src_id / (local_num * horizontal_num);
-    // Implement the algorithm
-    int x_hops = abs(dst_x - my_x);
-    int y_hops = abs(dst_y - my_y);
-    int z_hops = abs(dst_z - my_z);
-    // Determine the direction (tiebreaking case keeps the same with NSDI 2024 Google Paper)
-    int x_diff1 = 0; 
-    int x_diff2 = 0;
-    int y_diff1 = 0;
-    int y_diff2 = 0;
-    int z_diff1 = 0;
-    int z_diff2 = 0;
-    if (dst_x >= src_x) {
-        x_diff1 = dst_x - src_x;
-        x_diff2 = local_num - (dst_x - src_x);
-    } else{
-        x_diff1 = local_num - (src_x - dst_x);
-        x_diff2 = src_x - dst_x;
-    }
-
-    if (dst_y >= src_y) {
-        y_diff1 = dst_y - src_y;
-        y_diff2 = horizontal_num - (dst_y - src_y);
-    } else{
-        y_diff1 = horizontal_num - (src_y - dst_y);
-        y_diff2 = src_y - dst_y;
-    }
-
-    if (dst_z >= src_z) {
-        z_diff1 = dst_z - src_z;
-        z_diff2 = vertical_num - (dst_z - src_z);
-    } else{
-        z_diff1 = vertical_num - (src_z - dst_z);
-        z_diff2 = src_z - dst_z;
-    }
-    bool x_dirn = (x_diff1 > x_diff2); // if x_dirn = 1, use anti-clockwise direction; else, use clockwise direction
-    bool y_dirn = (y_diff1 > y_diff2);
-    bool z_dirn = (z_diff1 > z_diff2);
-    if (x_diff1 == x_diff2) {
-        if (src_x % 2 == 0) {
-            x_dirn = 0;// if src coordinate of this dimension is even: positive direction    
-        } else {
-            x_dirn = 1;
-        }
-    }
-
-    if (y_diff1 == y_diff2) {
-        if (src_y % 2 == 0) {
-            y_dirn = 0; 
-        } else {
-            y_dirn = 1;
-        }
-    }
-
-    if (z_diff1 == z_diff2) {
-        if (src_z % 2 == 0) {
-            z_dirn = 0;
-        } else {
-            z_dirn = 1;
-        }
-    }
-    // Determine the outport_dirn
-    if (x_hops > 0) {
-        if (x_dirn) {
-            outport_dirn = "LocalWest" + std::to_string(my_vnet);
-        } else {
-            outport_dirn = "LocalEast" + std::to_string(my_vnet);
-        }
-    } else if (y_hops > 0) {
-        if (y_dirn) {
-            outport_dirn = "West" + std::to_string(my_vnet);
-        } else {
-            outport_dirn = "East" + std::to_string(my_vnet);
-        }  
-    } else if (z_hops > 0) {
-        if (z_dirn) {
-            outport_dirn = "South" + std::to_string(my_vnet);
-        } else {
-            outport_dirn = "North" + std::to_string(my_vnet);
-        } 
-    } else {
-        std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
-    }
-    Cross_Dateline_Judge(my_id, route, outport_dirn);
-    return m_outports_dirn2idx[outport_dirn]; 
-}
-
 
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
@@ -712,13 +601,12 @@ RoutingUnit::GetIntermediateNodeId(int src_id, int dst_id, int dimension)
     return inter_id;
 }
 
+// Galois change: return the `outport direction` for SANDWICH routing
+// (same codes as nextHopDORMIN, -1 if unknown)
 int 
-RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
-                         int inport,
-                         PortDirection inport_dirn)
+RoutingUnit::directionSANDWICH(RouteInfo &route)
 {
-    PortDirection outport_dirn = "Unknown";
-    int my_vnet=route.vnet;
+    int outport_direction = -1;
     
     assert(parsed_faulty_links.size() == 1);
     assert(parsed_faulty_links[0].size() == 2);
@@ -868,15 +756,15 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
             // yXYZ routing 
             if (y_hops > 0) { 
                 if (y_dirn) {
-                    outport_dirn = "West" + std::to_string(my_vnet);
+                    outport_direction = 2;
                 } else {
-                    outport_dirn = "East" + std::to_string(my_vnet);
+                    outport_direction = 3;
                 }
             } else { 
                 if (src_y % 2 == 1) { 
-                    outport_dirn = "West" + std::to_string(my_vnet);
+                    outport_direction = 2;
                 } else {
-                    outport_dirn = "East" + std::to_string(my_vnet);
+                    outport_direction = 3;
                 }
             }
         } 
@@ -884,15 +772,15 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
             // XzYZ routing
             if (z_hops > 0) { 
                 if (z_dirn) {
-                    outport_dirn = "South" + std::to_string(my_vnet);
+                    outport_direction = 4;
                 } else {
-                    outport_dirn = "North" + std::to_string(my_vnet);
+                    outport_direction = 5;
                 }
             } else { 
                 if (src_z % 2 == 1) { 
-                    outport_dirn = "South" + std::to_string(my_vnet);
+                    outport_direction = 4;
                 } else {
-                    outport_dirn = "North" + std::to_string(my_vnet);
+                    outport_direction = 5;
                 } 
             }
         }
@@ -901,66 +789,66 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
                 // yXY routing
                 if (y_hops > 0) { 
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 } else { 
                     if (src_y % 2 == 1) { 
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 }
             } else if (fault_link_dir == 2 && my_id == inter1_id) {
                 // XzYZ routing
                 if (z_hops > 0) { 
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (src_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else if (fault_link_dir == 2 && my_x == dst_x && my_y == dst_y && my_z != dst_z) {
                 // XzYZ routing -> the last Z stage
                 if (z_hops > 0) { 
                     if (my_z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (my_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else {
                 // Normal DORMIN
                 if (x_hops > 0) {
                     if (x_dirn) {
-                        outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                        outport_direction = 0;
                     } else {
-                        outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                        outport_direction = 1;
                     }
                 } else if (y_hops > 0) {
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }  
                 } else if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 } else {
                     std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -972,45 +860,45 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
                 // zXZ routing
                 if (z_hops > 0) { 
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (src_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else if (fault_link_dir == 3 && my_x == dst_x && my_y == dst_y) {  
                 // XZ routing -> the last stage
                 if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } else {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } 
                 }
             } else {
                 // Normal DORMIN
                 if (x_hops > 0) {
                     if (x_dirn) {
-                        outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                        outport_direction = 0;
                     } else {
-                        outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                        outport_direction = 1;
                     }
                 } else if (y_hops > 0) {
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }  
                 } else if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 } else {
                     std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -1022,45 +910,45 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
                 // zYZ routing
                 if (z_hops > 0) { 
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (src_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else if (fault_link_dir == 3 && my_x == dst_x && my_y == dst_y) {  
                 // YZ routing -> the last stage
                 if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } else {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } 
                 }
             } else {
                 // Normal DORMIN
                 if (x_hops > 0) {
                     if (x_dirn) {
-                        outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                        outport_direction = 0;
                     } else {
-                        outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                        outport_direction = 1;
                     }
                 } else if (y_hops > 0) {
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }  
                 } else if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 } else {
                     std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -1072,51 +960,51 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
                 // yXY routing
                 if (y_hops > 0) { 
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 } else { 
                     if (src_y % 2 == 1) { 
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 }
             } else if (fault_link_dir == 1 && my_x == dst_x && my_y != dst_y) {
                 // yXY routing -> the last y stage 
                 if (y_hops > 0) { 
                     if (my_y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 } else { 
                     if (my_y % 2 == 1) { 
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }
                 }
             } else {
                 // Normal DORMIN
                 if (x_hops > 0) {
                     if (x_dirn) {
-                        outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                        outport_direction = 0;
                     } else {
-                        outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                        outport_direction = 1;
                     }
                 } else if (y_hops > 0) {
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }  
                 } else if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 } else {
                     std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -1128,51 +1016,51 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
                 // zYZ routing
                 if (z_hops > 0) { 
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (src_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else if (fault_link_dir == 2 && my_y == dst_y && my_z != dst_z) {
                 // zYZ routing -> the last Z stage
                 if (z_hops > 0) { 
                     if (my_z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     }
                 } else { 
                     if (my_z % 2 == 1) { 
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 }
             } else {
                 // Normal DORMIN
                 if (x_hops > 0) {
                     if (x_dirn) {
-                        outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                        outport_direction = 0;
                     } else {
-                        outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                        outport_direction = 1;
                     }
                 } else if (y_hops > 0) {
                     if (y_dirn) {
-                        outport_dirn = "West" + std::to_string(my_vnet);
+                        outport_direction = 2;
                     } else {
-                        outport_dirn = "East" + std::to_string(my_vnet);
+                        outport_direction = 3;
                     }  
                 } else if (z_hops > 0) {
                     if (z_dirn) {
-                        outport_dirn = "South" + std::to_string(my_vnet);
+                        outport_direction = 4;
                     } else {
-                        outport_dirn = "North" + std::to_string(my_vnet);
+                        outport_direction = 5;
                     } 
                 } else {
                     std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -1183,9 +1071,9 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
         else if (fault_link_dir == 3 && my_x == dst_x && my_y == dst_y) {
             if (z_hops > 0) {
                 if (z_dirn) {
-                    outport_dirn = "North" + std::to_string(my_vnet);
+                    outport_direction = 5;
                 } else {
-                    outport_dirn = "South" + std::to_string(my_vnet);
+                    outport_direction = 4;
                 } 
             }
         }
@@ -1193,21 +1081,21 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
             // Normal DORMIN
             if (x_hops > 0) {
                 if (x_dirn) {
-                    outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                    outport_direction = 0;
                 } else {
-                    outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                    outport_direction = 1;
                 }
             } else if (y_hops > 0) {
                 if (y_dirn) {
-                    outport_dirn = "West" + std::to_string(my_vnet);
+                    outport_direction = 2;
                 } else {
-                    outport_dirn = "East" + std::to_string(my_vnet);
+                    outport_direction = 3;
                 }  
             } else if (z_hops > 0) {
                 if (z_dirn) {
-                    outport_dirn = "South" + std::to_string(my_vnet);
+                    outport_direction = 4;
                 } else {
-                    outport_dirn = "North" + std::to_string(my_vnet);
+                    outport_direction = 5;
                 } 
             } else {
                 std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
@@ -1217,272 +1105,227 @@ RoutingUnit::outportComputeSANDWICH(RouteInfo &route,
         // Normal DORMIN
         if (x_hops > 0) {
             if (x_dirn) {
-                outport_dirn = "LocalWest" + std::to_string(my_vnet);
+                outport_direction = 0;
             } else {
-                outport_dirn = "LocalEast" + std::to_string(my_vnet);
+                outport_direction = 1;
             }
         } else if (y_hops > 0) {
             if (y_dirn) {
-                outport_dirn = "West" + std::to_string(my_vnet);
+                outport_direction = 2;
             } else {
-                outport_dirn = "East" + std::to_string(my_vnet);
+                outport_direction = 3;
             }  
         } else if (z_hops > 0) {
             if (z_dirn) {
-                outport_dirn = "South" + std::to_string(my_vnet);
+                outport_direction = 4;
             } else {
-                outport_dirn = "North" + std::to_string(my_vnet);
+                outport_direction = 5;
             } 
         } else {
             std::cout << "DORMIN: Current Node is the destination!!!" << std::endl;
         }
     }
-    
-    Cross_Dateline_Judge(my_id, route, outport_dirn);
-    return m_outports_dirn2idx[outport_dirn]; 
+
+    return outport_direction;
 }
 
 // Current SANDWICHES implementation for arbitrary two faulty links 
-int 
-RoutingUnit::outportComputeSANDWICHES(RouteInfo &route,
-                         int inport,
-                         PortDirection inport_dirn)
+RoutingUnit::NextHop
+RoutingUnit::nextHopSANDWICHES(RouteInfo &route)
 {
-PortDirection outport_dirn = "Unknown";
-int my_vnet=route.vnet;
-int output; 
-assert(parsed_faulty_links.size() == 2);
-assert(parsed_faulty_links[0].size() == 2);
-assert(parsed_faulty_links[1].size() == 2);
-int fault_id1 = parsed_faulty_links[0][0];
-int fault_id2 = parsed_faulty_links[0][1];
-int fault_id3 = parsed_faulty_links[1][0];
-int fault_id4 = parsed_faulty_links[1][1];
-
-// Getting coordinate
-int local_num = m_router->get_net_ptr()->get_local_rings(); 
-int horizontal_num = m_router->get_net_ptr()->get_horizontal_rings();
-int vertical_num = m_router->get_net_ptr()->get_vertical_rings();
-
-int my_id = m_router->get_id();
-int my_x = my_id % local_num; 
-int my_y = (my_id % (local_num * horizontal_num)) / local_num;
-int my_z = my_id / (local_num * horizontal_num);
-
-int dst_id = route.dest_router;
-int dst_x = dst_id  % local_num;
-int dst_y = (dst_id % (local_num * horizontal_num)) / local_num;
-int dst_z = dst_id / (local_num * horizontal_num);
-
-int src_id = route.src_router;
-int src_x = src_id  % local_num;
-int src_y = (src_id % (local_num * horizontal_num)) / local_num;
-int src_z = src_id / (local_num * horizontal_num);
+    NextHop next_hop;
+    assert(parsed_faulty_links.size() == 2);
+    assert(parsed_faulty_links[0].size() == 2);
+    assert(parsed_faulty_links[1].size() == 2);
+    int fault_id1 = parsed_faulty_links[0][0];
+    int fault_id2 = parsed_faulty_links[0][1];
+    int fault_id3 = parsed_faulty_links[1][0];
+    int fault_id4 = parsed_faulty_links[1][1];
 
-// Implement the algorithm
-int x_hops = abs(dst_x - my_x);
-int y_hops = abs(dst_y - my_y);
-int z_hops = abs(dst_z - my_z);
-// Determine the direction (tiebreaking case keeps the same with NSDI 2024 Google Paper)
-int x_diff1 = 0; 
-int x_diff2 = 0;
-int y_diff1 = 0;
-int y_diff2 = 0;
-int z_diff1 = 0;
-int z_diff2 = 0;
-
-if (dst_x >= src_x) {
-    x_diff1 = dst_x - src_x;
-    x_diff2 = local_num - (dst_x - src_x);
-} else{
-    x_diff1 = local_num - (src_x - dst_x);
-    x_diff2 = src_x - dst_x;
-}
-if (dst_y >= src_y) {
-    y_diff1 = dst_y - src_y;
-    y_diff2 = horizontal_num - (dst_y - src_y);
-} else{
-    y_diff1 = horizontal_num - (src_y - dst_y);
-    y_diff2 = src_y - dst_y;
-}
-if (dst_z >= src_z) {
-    z_diff1 = dst_z - src_z;
-    z_diff2 = vertical_num - (dst_z - src_z);
-} else{
-    z_diff1 = vertical_num - (src_z - dst_z);
-    z_diff2 = src_z - dst_z;
-}
+    int my_id = m_router->get_id();
+    int dst_id = route.dest_router;
 
-bool x_dirn = (x_diff1 > x_diff2); // if x_dirn = 1, use anti-clockwise direction; else, use clockwise direction
-bool y_dirn = (y_diff1 > y_diff2);
-bool z_dirn = (z_diff1 > z_diff2);
+    std::pair<int, int> DOR_next = nextHopDORMIN(route, -1, "Unknown");
+    int next_node_id = DOR_next.first;
+    int output_direction = DOR_next.second;
+    std::pair<int, int> First_fault_pair;
+    std::pair<int, int> SANDWICH_next;
+    bool in_path_failure = In_Path_Judge(route, my_id, dst_id, fault_id1, fault_id2) || In_Path_Judge(route, my_id, dst_id, fault_id3, fault_id4);
+    if (in_path_failure) {
+        First_fault_pair = Get_First_FaultLink_Direction(my_id, dst_id, fault_id1, fault_id2, fault_id3, fault_id4);
+        int former_or_latter = First_fault_pair.second; // 0: former, 1: latter
+        if (former_or_latter == 0) {
+            SANDWICH_next = nextHopSANDWICH(route, -1, "Unknown", fault_id1, fault_id2);
+        } else if (former_or_latter == 1) {
+            SANDWICH_next = nextHopSANDWICH(route, -1, "Unknown", fault_id3, fault_id4);
+        } else {
+            std::cout << "Error: former_or_latter is neither 0 nor 1!" << std::endl;
+        }
+        next_node_id = SANDWICH_next.first;
+        output_direction = SANDWICH_next.second;
+
+        bool next_hop_failure = In_Path_Judge(route, my_id, next_node_id, fault_id1, fault_id2) || In_Path_Judge(route, my_id, next_node_id, fault_id3, fault_id4);
+        if (next_hop_failure) {
+            std::pair<int, int> reverse_pair = ReverseNode(route, my_id, output_direction);
+            next_node_id = reverse_pair.first;
+            output_direction = reverse_pair.second;
+        }
 
-if (x_diff1 == x_diff2) {
-    if (src_x % 2 == 0) {
-        x_dirn = 0; 
-    } else {
-        x_dirn = 1;
-    }
-}
-if (y_diff1 == y_diff2) {
-    if (src_y % 2 == 0) {
-        y_dirn = 0;   
-    } else {
-        y_dirn = 1;
-    }
-}
-if (z_diff1 == z_diff2) {
-    if (src_z % 2 == 0) {
-        z_dirn = 0;
+        if (output_direction < 0 || output_direction > 5) {
+            std::cout << "New_SANDWICHES: output direction is not valid!" << std::endl;
+            output_direction = -1;
+        }
+        next_hop.outport = output_direction;
+        next_hop.dateline = output_direction;
     } else {
-        z_dirn = 1;
+        // the outport follows DORMIN from this router, reversed if the ring
+        // of the DORMIN next hop has a fault and the packet came in from that
+        // direction; the dateline follows the DORMIN next hop
+        bool fault_flag = Ring_Has_Fault(my_id, next_node_id, fault_id1, fault_id2, fault_id3, fault_id4);
+        int dirn_index = outportComputeDORMIN_Myid(route, -1, "Unknown").second;
+        if (output_direction < 0 || output_direction > 5) {
+            std::cout << "New_SANDWICHES: output direction is not valid!" << std::endl;
+            output_direction = -1;
+        }
+        next_hop.outport = dirn_index;
+        next_hop.dateline = output_direction;
+        if (fault_flag) {
+            next_hop.reverse_inport = dirn_index;
+        }
     }
+    return next_hop;
 }
 
-std::pair<int, int> DOR_next = nextHopDORMIN(route, inport, inport_dirn); 
-int next_node_id = DOR_next.first;
-int output_direction = DOR_next.second;
-std::pair<int, int> First_fault_pair;
-std::pair<int, int> SANDWICH_next;
-bool in_path_failure = In_Path_Judge(route, my_id, dst_id, fault_id1, fault_id2) || In_Path_Judge(route, my_id, dst_id, fault_id3, fault_id4);
-if (in_path_failure) {
-    First_fault_pair = Get_First_FaultLink_Direction(my_id, dst_id, fault_id1, fault_id2, fault_id3, fault_id4);
-    int fault_link_dir = First_fault_pair.first; // 1: LocalEast/LocalWest; 2: East/West; 3: North/South
-    int former_or_latter = First_fault_pair.second; // 0: former, 1: latter
-    if (former_or_latter == 0) {
-        SANDWICH_next = nextHopSANDWICH(route, inport, inport_dirn, fault_id1, fault_id2);
-    } else if (former_or_latter == 1) {
-        SANDWICH_next = nextHopSANDWICH(route, inport, inport_dirn, fault_id3, fault_id4);
-    } else {
-        std::cout << "Error: former_or_latter is neither 0 nor 1!" << std::endl;
-    }
-    next_node_id = SANDWICH_next.first;
-    output_direction = SANDWICH_next.second;
-
-    bool next_hop_failure = In_Path_Judge(route, my_id, next_node_id, fault_id1, fault_id2) || In_Path_Judge(route, my_id, next_node_id, fault_id3, fault_id4);
-    if (next_hop_failure) {
-        std::pair<int, int> reverse_pair = ReverseNode(route, my_id, output_direction);
-        next_node_id = reverse_pair.first;
-        output_direction = reverse_pair.second;
-    }
-
-    if (output_direction == 0) {
-        outport_dirn = "LocalWest" + std::to_string(my_vnet);
-    } else if (output_direction == 1) {
-        outport_dirn = "LocalEast" + std::to_string(my_vnet);
-    } else if (output_direction == 2) {
-        outport_dirn = "West" + std::to_string(my_vnet);
-    } else if (output_direction == 3) {
-        outport_dirn = "East" + std::to_string(my_vnet);
-    } else if (output_direction == 4) {
-        outport_dirn = "South" + std::to_string(my_vnet);
-    } else if (output_direction == 5) {
-        outport_dirn = "North" + std::to_string(my_vnet);
-    } else {
-        std::cout << "New_SANDWICHES: output direction is not valid!" << std::endl;
+// Galois change: update the dateline state of the route for a hop in the
+// given direction (see nextHopDORMIN; -1 if unknown)
+void
+RoutingUnit::Cross_Dateline_Judge(RouteInfo &route, int direction)
+{
+    // 1: X (LocalWest/LocalEast); 2: Y (West/East); 3: Z (South/North)
+    int routing_dim = (direction < 0) ? 0 : direction / 2 + 1;
+
+    // we set dataeline for wraparound links
+    if (route.last_routing_dim >= 1 && route.last_routing_dim <= 3 &&
+        route.last_routing_dim != routing_dim) {
+        route.crossDateline = 0;
     }
-    Cross_Dateline_Judge(my_id, route, outport_dirn);
-    return m_outports_dirn2idx[outport_dirn]; 
-} else {
-    bool fault_flag = Ring_Has_Fault(my_id, next_node_id, fault_id1, fault_id2, fault_id3, fault_id4);
-    std::pair<int, int> output_pair = outportComputeDORMIN_Myid (route, inport, inport_dirn);
-    output = output_pair.first;
-    int dirn_index = output_pair.second;
-    int input_index = parseDirectionToIndex(inport_dirn);
-    if (fault_flag && (dirn_index == input_index)){
-        if (dirn_index == 1) {
-            outport_dirn = "LocalWest" + std::to_string(my_vnet);
-        } else if (dirn_index == 0) {
-            outport_dirn = "LocalEast" + std::to_string(my_vnet);
-        } else if (dirn_index == 3) {
-            outport_dirn = "West" + std::to_string(my_vnet);
-        } else if (dirn_index == 2) {
-            outport_dirn = "East" + std::to_string(my_vnet);
-        } else if (dirn_index == 5) {
-            outport_dirn = "South" + std::to_string(my_vnet);
-        } else if (dirn_index == 4) {
-            outport_dirn = "North" + std::to_string(my_vnet);
-        } else {
-            std::cout << "Ring_Has_Fault branch: output direction is not valid!" << std::endl;
-        }  
-        output = m_outports_dirn2idx[outport_dirn];
-    } else {
-        if (output_direction == 0) {
-            outport_dirn = "LocalWest" + std::to_string(my_vnet);
-        } else if (output_direction == 1) {
-            outport_dirn = "LocalEast" + std::to_string(my_vnet);
-        } else if (output_direction == 2) {
-            outport_dirn = "West" + std::to_string(my_vnet);
-        } else if (output_direction == 3) {
-            outport_dirn = "East" + std::to_string(my_vnet);
-        } else if (output_direction == 4) {
-            outport_dirn = "South" + std::to_string(my_vnet);
-        } else if (output_direction == 5) {
-            outport_dirn = "North" + std::to_string(my_vnet);
-        } else {
-            std::cout << "New_SANDWICHES: output direction is not valid!" << std::endl;
-        }
+    if (direction >= 0 && m_dateline_wraps[direction]) {
+        route.crossDateline = 1;
     }
-    Cross_Dateline_Judge(my_id, route, outport_dirn);
-    return output; 
-}
 
+    // set last_routing_dim at last
+    if (routing_dim != 0) {
+        route.last_routing_dim = routing_dim;
+    }
 }
 
 void
-RoutingUnit::Cross_Dateline_Judge(int my_id, RouteInfo &route, PortDirection Dirn) 
+RoutingUnit::init()
 {
-// we set dataeline for wraparound links
-int local_num = m_router->get_net_ptr()->get_local_rings(); 
-int horizontal_num = m_router->get_net_ptr()->get_horizontal_rings();
-int vertical_num = m_router->get_net_ptr()->get_vertical_rings();
+    RoutingAlgorithm routing_algorithm =
+        (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
+    if (routing_algorithm != DORMIN_ && routing_algorithm != SANDWICH_ &&
+        routing_algorithm != SANDWICHES_) {
+        return;
+    }
 
-int my_x = my_id % local_num; 
-int my_y = (my_id % (local_num * horizontal_num)) / local_num;
-int my_z = my_id / (local_num * horizontal_num);
-int last_routing_dim = route.last_routing_dim;
-
-if (last_routing_dim == 1 &&
-    !(Dirn.find("LocalEast") != std::string::npos ||
-    Dirn.find("LocalWest") != std::string::npos)) {
-    route.crossDateline = 0;
-} else if (last_routing_dim == 2 &&
-           !((Dirn.find("East") != std::string::npos &&
-           Dirn.find("LocalEast") == std::string::npos) ||
-           (Dirn.find("West") != std::string::npos &&
-           Dirn.find("LocalWest") == std::string::npos))) {
-    route.crossDateline = 0;
-} else if (last_routing_dim == 3 &&
-           !(Dirn.find("North") != std::string::npos ||
-           Dirn.find("South") != std::string::npos)) {
-    route.crossDateline = 0;
-}
+    int local_num = m_router->get_net_ptr()->get_local_rings();
+    int horizontal_num = m_router->get_net_ptr()->get_horizontal_rings();
+    int vertical_num = m_router->get_net_ptr()->get_vertical_rings();
+
+    int my_id = m_router->get_id();
+    int my_x = my_id % local_num;
+    int my_y = (my_id % (local_num * horizontal_num)) / local_num;
+    int my_z = my_id / (local_num * horizontal_num);
 
+    // hops that take the wraparound link of their ring
+    m_dateline_wraps[0] = (my_x == 0);
+    m_dateline_wraps[1] = (my_x == local_num - 1);
+    m_dateline_wraps[2] = (my_y == 0);
+    m_dateline_wraps[3] = (my_y == horizontal_num - 1);
+    m_dateline_wraps[4] = (my_z == 0);
+    m_dateline_wraps[5] = (my_z == vertical_num - 1);
 
-if (my_x == local_num-1 && Dirn.find("LocalEast") != std::string::npos) {
-    route.crossDateline = 1;
-} else if (my_y == horizontal_num-1 && Dirn.find("East") != std::string::npos && Dirn.find("LocalEast") == std::string::npos) {
-    route.crossDateline = 1;
-} else if (my_z == vertical_num-1 && Dirn.find("North") != std::string::npos) {
-    route.crossDateline = 1;
+    parsed_faulty_links = m_router->get_net_ptr()->getFaultyLinks();
+    m_next_hops.clear();
+    m_next_hops.resize(local_num * horizontal_num * vertical_num);
 }
 
-if (my_x == 0 && Dirn.find("LocalWest") != std::string::npos) {
-    route.crossDateline = 1;
-} else if (my_y == 0 && Dirn.find("West") != std::string::npos && Dirn.find("LocalWest") == std::string::npos) {
-    route.crossDateline = 1;
-} else if (my_z == 0 && Dirn.find("South") != std::string::npos) {
-    route.crossDateline = 1;
+// Galois change: DORMIN/SANDWICH/SANDWICHES decisions only depend on the
+// (source, destination) pair at a given router, so they are computed once
+// per pair (see GarnetNetwork::buildNextHopTables) and read by head flits
+RoutingUnit::NextHop&
+RoutingUnit::getNextHop(RouteInfo &route)
+{
+    std::vector<NextHop>& src_next_hops = m_next_hops[route.src_router];
+    if (src_next_hops.empty()) {
+        src_next_hops.resize(m_next_hops.size());
+    }
+    NextHop& next_hop = src_next_hops[route.dest_router];
+    if (next_hop.outport == NextHop::NOT_COMPUTED) {
+        RoutingAlgorithm routing_algorithm =
+            (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
+        if (routing_algorithm == DORMIN_) {
+            next_hop.outport = nextHopDORMIN(route, -1, "Unknown").second;
+            next_hop.dateline = next_hop.outport;
+        } else if (routing_algorithm == SANDWICH_) {
+            next_hop.outport = directionSANDWICH(route);
+            next_hop.dateline = next_hop.outport;
+        } else {
+            next_hop = nextHopSANDWICHES(route);
+        }
+    }
+    return next_hop;
 }
 
-// set last_routing_dim at last
-if (Dirn.find("LocalEast") != std::string::npos || Dirn.find("LocalWest") != std::string::npos) {
-    route.last_routing_dim = 1;
-} else if ((Dirn.find("East") != std::string::npos && Dirn.find("LocalEast") == std::string::npos) || (Dirn.find("West") != std::string::npos && Dirn.find("LocalWest") == std::string::npos)) {
-    route.last_routing_dim = 2;
-} else if (Dirn.find("North") != std::string::npos || Dirn.find("South") != std::string::npos) {
-    route.last_routing_dim = 3;
+int
+RoutingUnit::nextHopDirection(RouteInfo &route, int inport_direction)
+{
+    const NextHop& next_hop = getNextHop(route);
+    if (next_hop.reverse_inport >= 0 &&
+        inport_direction == next_hop.reverse_inport) {
+        // back to where the packet came from (1 <-> 0, 3 <-> 2, 5 <-> 4)
+        return next_hop.outport ^ 1;
+    }
+    return next_hop.outport;
 }
+
+int
+RoutingUnit::outportComputeNextHop(RouteInfo &route,
+                                   int inport)
+{
+    const NextHop& next_hop = getNextHop(route);
+    int outport_direction = next_hop.outport;
+    int dateline_direction = next_hop.dateline;
+    if (next_hop.reverse_inport >= 0 &&
+        m_inports_direction[inport] == next_hop.reverse_inport) {
+        // back to where the packet came from (1 <-> 0, 3 <-> 2, 5 <-> 4)
+        outport_direction ^= 1;
+        dateline_direction = outport_direction;
+    }
+    Cross_Dateline_Judge(route, dateline_direction);
+    return lookupDirection(route.vnet, outport_direction);
+}
+
+// Galois change: outport of a direction (see nextHopDORMIN) in a vnet
+int
+RoutingUnit::lookupDirection(int vnet, int direction)
+{
+    static const char *direction_names[] = {
+        "LocalWest", "LocalEast", "West", "East", "South", "North"};
+    if (vnet >= m_outports_per_direction.size()) {
+        m_outports_per_direction.resize(vnet + 1);
+    }
+    std::vector<int>& outports = m_outports_per_direction[vnet];
+    if (outports.empty()) {
+        // index 0 holds unknown directions
+        outports.push_back(m_outports_dirn2idx["Unknown"]);
+        for (int i = 0; i < 6; i++) {
+            outports.push_back(m_outports_dirn2idx[
+                direction_names[i] + std::to_string(vnet)]);
+        }
+    }
+    return outports[direction + 1];
 }
 
 
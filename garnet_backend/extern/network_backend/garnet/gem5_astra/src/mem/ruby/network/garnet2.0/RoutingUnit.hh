@@ -39,6 +39,7 @@
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet2.0/flit.hh"
+#include <cstdint>
 #include <vector>
 
 class InputUnit;
@@ -71,10 +72,6 @@ class RoutingUnit
     int outportComputeRINGXY(RouteInfo route,
                          int inport,
                          PortDirection inport_dirn);
-    // Routing for DORMIN (ensure an dimension-ordering minimal routing)
-    int outportComputeDORMIN(RouteInfo &route,
-                         int inport,
-                         PortDirection inport_dirn);
     // Routing for all-to-all
     int outportComputeALLTOALL(RouteInfo route,
                          int inport,
@@ -85,15 +82,42 @@ class RoutingUnit
                              int inport,
                              PortDirection inport_dirn);
 
+    // Galois change: decision of DORMIN/SANDWICH/SANDWICHES routing for one
+    // (source, destination) pair at this router, as direction codes (see
+    // nextHopDORMIN)
+    struct NextHop
+    {
+        static const int8_t NOT_COMPUTED = -2;
+
+        int8_t outport = NOT_COMPUTED;
+        // direction used to update the dateline state of the route
+        int8_t dateline = -1;
+        // SANDWICHES: reverse the outport for packets that came in from
+        // this direction (-1: never)
+        int8_t reverse_inport = -1;
+    };
+
+    // Build the dateline flags and the (empty) next-hop table of the router
+    void init();
+
+    // Routing for DORMIN (ensure an dimension-ordering minimal routing),
+    // SANDWICH and SANDWICHES through the next-hop table
+    int outportComputeNextHop(RouteInfo &route,
+                         int inport);
+
+    // Direction code of the next hop of a packet of the route that came in
+    // from inport_direction (-1: Local), filling the next-hop table entry if
+    // needed (see GarnetNetwork::buildNextHopTables)
+    int nextHopDirection(RouteInfo &route, int inport_direction);
+
     // Routing for fault-tolerant DORMIN (ensure an dimension-ordering minimal routing with sandwich rule)
-    int outportComputeSANDWICH(RouteInfo &route,
-                         int inport,
-                         PortDirection inport_dirn);
+    int directionSANDWICH(RouteInfo &route);
 
     // Routing for fault-tolerant DORMIN (ensure an dimension-ordering minimal routing with sandwich rule) for multiple failures
-    int outportComputeSANDWICHES(RouteInfo &route,
-                         int inport,
-                         PortDirection inport_dirn);
+    NextHop nextHopSANDWICHES(RouteInfo &route);
+
+    // Outport of a direction code in a vnet
+    int lookupDirection(int vnet, int direction);
     
     // Routing for DORMIN (based on my_id instead of src_id)
     std::pair<int, int> outportComputeDORMIN_Myid(RouteInfo &route,
@@ -124,7 +148,7 @@ class RoutingUnit
     bool supportsVnet(int vnet, std::vector<int> sVnets);
 
     // Judge whether we should cross the dataline 
-    void Cross_Dateline_Judge(int my_id, RouteInfo &route, PortDirection Dirn); 
+    void Cross_Dateline_Judge(RouteInfo &route, int direction);
 
     // Galois change: return the `next node ID` and `outport direction` for DORMIN routing
     std::pair<int, int> nextHopDORMIN(RouteInfo &route,
@@ -158,6 +182,21 @@ class RoutingUnit
     std::map<int, PortDirection> m_inports_idx2dirn;
     std::map<int, PortDirection> m_outports_idx2dirn;
     std::map<PortDirection, int> m_outports_dirn2idx;
+
+    // Galois change: direction code of each inport (see nextHopDORMIN)
+    std::vector<int> m_inports_direction;
+    // outport of each direction code + 1, per vnet
+    std::vector<std::vector<int>> m_outports_per_direction;
+    // whether a hop in each direction crosses the dateline of its ring
+    bool m_dateline_wraps[6];
+    // next hops by source and destination router, filled before the
+    // simulation for every route through this router (rows of sources
+    // without such a route stay empty; pairs routed elsewhere are never
+    // looked up here)
+    std::vector<std::vector<NextHop>> m_next_hops;
+
+    // Entry of the next-hop table, computed if missing
+    NextHop& getNextHop(RouteInfo &route);
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET2_0_ROUTINGUNIT_HH__
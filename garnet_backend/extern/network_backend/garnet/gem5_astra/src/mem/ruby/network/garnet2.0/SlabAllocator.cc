@@ -0,0 +1,52 @@
+#include "mem/ruby/network/garnet2.0/SlabAllocator.hh"
+
+#include <algorithm>
+#include <new>
+
+SlabAllocator::SlabAllocator(size_t block_size)
+    : m_requested_size(block_size), m_free_blocks(nullptr),
+      m_allocations(0), m_blocks(0), m_in_use(0), m_peak_in_use(0)
+{
+    // keep every block of a slab aligned for any object
+    size_t alignment = alignof(std::max_align_t);
+    block_size = std::max(block_size, sizeof(FreeBlock));
+    m_block_size = (block_size + alignment - 1) / alignment * alignment;
+}
+
+void *
+SlabAllocator::allocate(size_t size)
+{
+    if (size != m_requested_size) {
+        return ::operator new(size);
+    }
+    if (m_free_blocks == nullptr) {
+        m_slabs.emplace_back(new char[m_block_size * m_slab_blocks]);
+        char *slab = m_slabs.back().get();
+        for (int i = m_slab_blocks - 1; i >= 0; i--) {
+            FreeBlock *block = (FreeBlock *)(slab + i * m_block_size);
+            block->next = m_free_blocks;
+            m_free_blocks = block;
+        }
+        m_blocks += m_slab_blocks;
+    }
+    FreeBlock *block = m_free_blocks;
+    m_free_blocks = block->next;
+    m_allocations++;
+    if (++m_in_use > m_peak_in_use) {
+        m_peak_in_use = m_in_use;
+    }
+    return block;
+}
+
+void
+SlabAllocator::deallocate(void *block, size_t size)
+{
+    if (size != m_requested_size) {
+        ::operator delete(block);
+        return;
+    }
+    FreeBlock *free_block = (FreeBlock *)block;
+    free_block->next = m_free_blocks;
+    m_free_blocks = free_block;
+    m_in_use--;
+}
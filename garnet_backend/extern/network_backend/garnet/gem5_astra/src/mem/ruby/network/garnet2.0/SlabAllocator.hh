@@ -0,0 +1,49 @@
+/*
+ * Free list of fixed-size blocks for the objects Garnet allocates per flit
+ * (flits and credits). Blocks are carved from slabs that are only returned
+ * to the heap at exit, so a network in steady state does not call malloc.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET2_0_SLABALLOCATOR_HH__
+#define __MEM_RUBY_NETWORK_GARNET2_0_SLABALLOCATOR_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SlabAllocator
+{
+  public:
+    SlabAllocator(size_t block_size);
+
+    // Requests of another size (e.g., a derived class that has no
+    // allocator of its own) go to the heap
+    void *allocate(size_t size);
+    void deallocate(void *block, size_t size);
+
+    uint64_t get_allocations() const { return m_allocations; }
+    uint64_t get_blocks() const { return m_blocks; }
+    uint64_t get_peak_in_use() const { return m_peak_in_use; }
+
+  private:
+    static const int m_slab_blocks = 256;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    size_t m_block_size;
+    size_t m_requested_size;
+    FreeBlock *m_free_blocks;
+    std::vector<std::unique_ptr<char[]>> m_slabs;
+
+    uint64_t m_allocations;
+    uint64_t m_blocks;
+    uint64_t m_in_use;
+    uint64_t m_peak_in_use;
+};
+
+#endif // __MEM_RUBY_NETWORK_GARNET2_0_SLABALLOCATOR_HH__
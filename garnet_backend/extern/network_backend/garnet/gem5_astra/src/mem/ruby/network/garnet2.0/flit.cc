@@ -33,6 +33,13 @@
 
 #include "mem/ruby/network/garnet2.0/flit.hh"
 
+SlabAllocator &
+flit::allocator()
+{
+    static SlabAllocator flit_allocator(sizeof(flit));
+    return flit_allocator;
+}
+
 // Constructor for the flit
 flit::flit(int id, int  vc, int vnet, RouteInfo route, int size,
     MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
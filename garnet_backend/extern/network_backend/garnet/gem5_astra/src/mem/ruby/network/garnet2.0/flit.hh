@@ -42,6 +42,7 @@
 #include "base/types.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
+#include "mem/ruby/network/garnet2.0/SlabAllocator.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
 class flit
@@ -53,6 +54,14 @@ class flit
 
     virtual ~flit(){};
 
+    // Flits are allocated per packet and freed at the NI, so they come
+    // from a slab allocator (see GarnetNetwork::collateStats)
+    static void *operator new(size_t size)
+    { return allocator().allocate(size); }
+    static void operator delete(void *block, size_t size)
+    { allocator().deallocate(block, size); }
+    static SlabAllocator &allocator();
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
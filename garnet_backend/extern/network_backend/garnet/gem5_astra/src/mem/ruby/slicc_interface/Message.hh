@@ -32,6 +32,7 @@
 #include <iostream>
 #include <memory>
 #include <stack>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/protocol/MessageSizeType.hh"
@@ -39,6 +40,7 @@
 #include "cpu/testers/garnet_synthetic_traffic/GarnetSyntheticTraffic.hh"
 
 class Message;
+class NetworkLink;
 typedef std::shared_ptr<Message> MsgPtr;
 
 class Message
@@ -130,6 +132,8 @@ class Message
     bool memorized;
     int capi_count,capi_type,capi_src,capi_tag;
     int flits;
+    // links crossed by the packet closing a fast mode window (Garnet)
+    std::vector<NetworkLink *> fast_links;
 
   private:
     const Tick m_time;